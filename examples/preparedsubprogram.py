@@ -0,0 +1,25 @@
+import dlvhex
+
+# the rules of the transitive closure are prepared once; each evaluation only
+# adds the edges as facts, and repeated edge sets are answered from the memo
+closure = None
+
+def reach(edge, start):
+	global closure
+	if closure is None:
+		r1 = dlvhex.storeRule((dlvhex.storeAtom(("path", "X", "Y")), ), (dlvhex.storeAtom(("edge", "X", "Y")), ), ())
+		r2 = dlvhex.storeRule((dlvhex.storeAtom(("path", "X", "Z")), ), (dlvhex.storeAtom(("path", "X", "Y")), dlvhex.storeAtom(("edge", "Y", "Z"))), ())
+		closure = dlvhex.prepareSubprogram((r1, r2))
+
+	facts = ()
+	for x in dlvhex.getTrueInputAtoms():
+		facts = facts + (dlvhex.storeAtom(("edge", x.tuple()[1], x.tuple()[2])), )
+
+	path = dlvhex.storeString("path")
+	for answerset in closure.evaluate(facts):
+		for x in answerset:
+			if x.tuple()[0] == path and x.tuple()[1] == start:
+				dlvhex.output((x.tuple()[2], ))
+
+def register():
+	dlvhex.addAtom("reach", (dlvhex.PREDICATE, dlvhex.CONSTANT), 1)
@@ -45,12 +45,88 @@
 #include "dlvhex2/Nogood.h"
 #include "dlvhex2/GenuineSolver.h"
 #include "dlvhex2/ComponentGraph.h"
+#include "dlvhex2/PredicateMask.h"
 
 #include <list>
 #include "dlvhex2/CDNLSolver.h"
 
+#include <boost/thread/mutex.hpp>
+
 DLVHEX_NAMESPACE_BEGIN
 
+/**
+ * \brief Stores results of domain exploration (cf. liberal safety) for one evaluation unit.
+ *
+ * The extension of the domain predicates depends only on those input atoms whose predicates
+ * occur in the domain-exploration program. Results are therefore stored per projected input:
+ * for an input which was seen before, the stored extension is reused;
+ * for an input which is a superset of a stored one, the fixpoint iteration
+ * starts from the stored extension instead of starting from scratch.
+ *
+ * The cache is owned by the model generator factory of the unit
+ * and shared by all its model generators.
+ */
+class DLVHEX_EXPORT DomainExplorationCache
+{
+    public:
+        /** \brief Result of a single domain exploration. */
+        struct Entry
+        {
+            /** \brief Projected input of the domain exploration. */
+            InterpretationConstPtr input;
+            /** \brief Hash of DomainExplorationCache::Entry::input. */
+            std::size_t inputHash;
+            /** \brief Extension of the domain predicates (without DomainExplorationCache::Entry::input). */
+            InterpretationConstPtr domain;
+            /** \brief Herbrand base computed in the last fixpoint iteration. */
+            InterpretationConstPtr herbrandBase;
+            /** \brief Constructor. */
+            Entry(): inputHash(0) {}
+        };
+
+        /** \brief Constructor. */
+        DomainExplorationCache(): initialized(false), projectable(true) {}
+        /** \brief Destructor. */
+        ~DomainExplorationCache() {}
+
+        /**
+         * \brief Restricts an input interpretation to the atoms relevant for domain exploration.
+         * @param reg RegistryPtr.
+         * @param edb Input interpretation.
+         * @param deidb The domain-exploration program.
+         * @param deidbInnerEatoms The inner external atoms which are relevant for liberal domain-expansion safety.
+         * @return Projection of \p edb, or \p edb itself if the program does not allow for projection.
+         */
+        InterpretationConstPtr project(RegistryPtr reg, InterpretationConstPtr edb, const std::vector<ID>& deidb, const std::vector<ID>& deidbInnerEatoms);
+
+        /**
+         * \brief Looks up the result for a projected input.
+         * @param input Projected input as returned by DomainExplorationCache::project.
+         * @param base Is set to the largest stored entry whose input is a subset of \p input if there is no exact match.
+         * @return Extension of the domain predicates if \p input was seen before, and an empty pointer otherwise.
+         */
+        InterpretationConstPtr lookup(InterpretationConstPtr input, Entry& base);
+
+        /**
+         * \brief Stores the result for a projected input.
+         * @param entry The new entry.
+         * @param capacity Maximum number of entries; the least recently used entries are dropped.
+         */
+        void store(const Entry& entry, unsigned capacity);
+
+    protected:
+        /** \brief True if DomainExplorationCache::mask has been set up. */
+        bool initialized;
+        /** \brief False if the domain-exploration program contains atoms whose predicates cannot be determined; then the input is used as it is. */
+        bool projectable;
+        /** \brief Mask of all predicates relevant for domain exploration. */
+        PredicateMask mask;
+        /** \brief Stored results, most recently used first. */
+        std::list<Entry> entries;
+        /** \brief Mutex for multithreading access. */
+        boost::mutex mutex;
+};
+
 /**
  * \brief A model generator factory provides model generators
  * for a certain types of interpretations
@@ -429,8 +505,9 @@ public ModelGeneratorBase<Interpretation>
          * @param deidb The IDB used for computing the domain expansion; this is a simplified version of the actual IDB and is computed by addDomainPredicatesAndCreateDomainExplorationProgram.
          * @param deidbInnerEatoms The inner atoms which are relevant for liberal domain-expansion safety; this is a subset of all inner external atoms in the unit and is computed by addDomainPredicatesAndCreateDomainExplorationProgram.
          * @param pseudoInnerExternalAtoms Contains inner external atoms which should be evaluated just under \p edb for the sake of determining the domain (i.e., no enumeration of all possible inputs is performed).
+         * @param cache If not NULL, results of previous calls for the same unit are reused (only if \p pseudoInnerExternalAtoms is empty).
          */
-        InterpretationConstPtr computeExtensionOfDomainPredicates(ProgramCtx& ctx, InterpretationConstPtr edb, std::vector<ID>& deidb, std::vector<ID>& deidbInnerEatoms, std::vector<ID> pseudoInnerExternalAtoms = std::vector<ID>());
+        InterpretationConstPtr computeExtensionOfDomainPredicates(ProgramCtx& ctx, InterpretationConstPtr edb, std::vector<ID>& deidb, std::vector<ID>& deidbInnerEatoms, std::vector<ID> pseudoInnerExternalAtoms = std::vector<ID>(), DomainExplorationCache* cache = 0);
 };
 
 DLVHEX_NAMESPACE_END
@@ -82,6 +82,57 @@ class DLVHEX_EXPORT Configuration
             DUMP_OUTPUT
         } verboseAction_t;
 
+        /**
+         * @brief Options which are read in hot paths (e.g. for every external atom query).
+         *
+         * Besides the option map, these options are stored in an array whenever they are set
+         * (see Configuration::setOption), hence Configuration::getOption(cachedOption_t)
+         * retrieves them without a string lookup.
+         * Plugins can keep using the option names.
+         */
+        typedef enum {
+            /** \brief Option "Verbose". */
+            OPTION_VERBOSE,
+            /** \brief Option "GenuineSolver". */
+            OPTION_GENUINE_SOLVER,
+            /** \brief Option "ExternalLearning". */
+            OPTION_EXTERNAL_LEARNING,
+            /** \brief Option "ExternalLearningUser". */
+            OPTION_EXTERNAL_LEARNING_USER,
+            /** \brief Option "ExternalLearningIOBehavior". */
+            OPTION_EXTERNAL_LEARNING_IO_BEHAVIOR,
+            /** \brief Option "ExternalLearningFunctionality". */
+            OPTION_EXTERNAL_LEARNING_FUNCTIONALITY,
+            /** \brief Option "ExternalLearningNeg". */
+            OPTION_EXTERNAL_LEARNING_NEG,
+            /** \brief Option "ExternalLearningLinearity". */
+            OPTION_EXTERNAL_LEARNING_LINEARITY,
+            /** \brief Option "ExternalLearningMonotonicity". */
+            OPTION_EXTERNAL_LEARNING_MONOTONICITY,
+            /** \brief Option "UseExtAtomCache". */
+            OPTION_USE_EXTATOM_CACHE,
+            /** \brief Option "IncludeAuxInputInAuxiliaries". */
+            OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES,
+            /** \brief Option "MinimizeNogoods". */
+            OPTION_MINIMIZE_NOGOODS,
+            /** \brief Option "MinimizeNogoodsOpt". */
+            OPTION_MINIMIZE_NOGOODS_OPT,
+            /** \brief Option "MinimizeNogoodsOnConflict". */
+            OPTION_MINIMIZE_NOGOODS_ON_CONFLICT,
+            /** \brief Option "MinimizationSize". */
+            OPTION_MINIMIZATION_SIZE,
+            /** \brief Option "TransUnitLearning". */
+            OPTION_TRANS_UNIT_LEARNING,
+            /** \brief Option "NoPropagator". */
+            OPTION_NO_PROPAGATOR,
+            /** \brief Option "SupportSets". */
+            OPTION_SUPPORT_SETS,
+            /** \brief Option "ExternalAtomVerificationFromLearnedNogoods". */
+            OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS,
+            /** \brief Number of cached options (not an option). */
+            CACHED_OPTION_COUNT
+        } cachedOption_t;
+
         /**
          * \brief Return the value of the specified option identifier.
          * @param o Name of the option to retrieve.
@@ -90,6 +141,19 @@ class DLVHEX_EXPORT Configuration
         unsigned
             getOption(const std::string& o) const;
 
+        /**
+         * \brief Return the value of an option which is read in hot paths.
+         * @param o Option to retrieve.
+         * @return Value of option \p o.
+         */
+        inline unsigned
+            getOption(cachedOption_t o) const
+        {
+            if( !cachedOptionSet[o] )
+                throwUnsetOption(o);
+            return cachedOptionValue[o];
+        }
+
         /**
          * @brief Check if the specified verbose action \p a can be carried out.
          *
@@ -148,6 +212,12 @@ class DLVHEX_EXPORT Configuration
 
     private:
 
+        /**
+         * @brief Throws an exception for a cached option which was not set.
+         * @param o Cached option.
+         */
+        void throwUnsetOption(cachedOption_t o) const;
+
         /**
          * @brief Associates a verbose action with a verbose level.
          */
@@ -161,6 +231,14 @@ class DLVHEX_EXPORT Configuration
          * @brief Associates option names with string values.
          */
         std::map<std::string, std::string> stringOptionMap;
+        /**
+         * @brief Values of the options in cachedOption_t (copies of the values in the option map).
+         */
+        unsigned cachedOptionValue[CACHED_OPTION_COUNT];
+        /**
+         * @brief Stores for each option in cachedOption_t if it was set.
+         */
+        bool cachedOptionSet[CACHED_OPTION_COUNT];
 
         /**
          * @brief List of filter-predicates.
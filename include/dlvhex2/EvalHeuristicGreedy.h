@@ -60,6 +60,18 @@ public EvalHeuristicBase<EvalGraphBuilder>
          * @param True if the components shall be merged and false otherwise.
          */
         bool mergeComponents(ProgramCtx& ctx, const ComponentGraph::ComponentInfo& ci1, const ComponentGraph::ComponentInfo& ci2, bool negativeExternalDependency) const;
+    protected:
+        /**
+         * \brief Decides whether merging two components which may be merged is expected to pay off.
+         *
+         * Called only for pairs of components which passed mergeComponents; this implementation always returns true.
+         * @param ctx ProgramCtx.
+         * @param compgraph Component graph containing \p comp1 and \p comp2.
+         * @param comp1 First component.
+         * @param comp2 Second component.
+         * @return True if the components shall be merged and false otherwise.
+         */
+        virtual bool mergeProfitable(ProgramCtx& ctx, const ComponentGraph& compgraph, ComponentGraph::Component comp1, ComponentGraph::Component comp2) const;
     public:
         /** \brief Constructor. */
         EvalHeuristicGreedy();
@@ -0,0 +1,86 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   EvalHeuristicProfile.h
+ *
+ * @brief  Evaluation heuristic that merges components based on metrics of a previous run.
+ */
+
+#ifndef EVAL_HEURISTIC_PROFILE_HPP_INCLUDED__18102026
+#define EVAL_HEURISTIC_PROFILE_HPP_INCLUDED__18102026
+
+#include "dlvhex2/EvalHeuristicGreedy.h"
+#include "dlvhex2/EvalProfile.h"
+
+#include <string>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/**
+ * \brief Greedy heuristics which merges two components only if this is predicted to be cheaper
+ * according to an EvalProfile recorded with --dumpevalprofile in a previous run.
+ *
+ * For components a, b where b depends on a, evaluating them in separate units costs
+ * t(a) + m(a) * t(b), as b is instantiated for each of the m(a) models of a.
+ * In one unit, the rules are grounded once, but the part of b is solved for each of the c(a) >= m(a)
+ * compatible set candidates of a: g(a) + g(b) + s(a) + c(a) * s(b),
+ * where t = g + s are time per instantiation and its grounding part.
+ * Independent components are merged if g(a) + g(b) + s(a) + c(a) * s(b) does not exceed t(a) + t(b).
+ * Components without data in the profile are merged as by EvalHeuristicGreedy.
+ */
+class EvalHeuristicProfile:
+public EvalHeuristicGreedy
+{
+    // types
+    public:
+        typedef EvalHeuristicGreedy Base;
+
+        // storage
+    protected:
+        /** \brief Name of the profile file. */
+        std::string fname;
+        /** \brief Profile loaded in build(). */
+        EvalProfilePtr profile;
+
+        // methods
+    protected:
+        virtual bool mergeProfitable(ProgramCtx& ctx, const ComponentGraph& compgraph, ComponentGraph::Component comp1, ComponentGraph::Component comp2) const;
+    public:
+        /** \brief Constructor.
+         * @param fname Name of a file written by --dumpevalprofile. */
+        EvalHeuristicProfile(const std::string& fname);
+        /** \brief Destructor. */
+        virtual ~EvalHeuristicProfile();
+        virtual void build(EvalGraphBuilder& builder);
+};
+
+DLVHEX_NAMESPACE_END
+#endif                           // EVAL_HEURISTIC_PROFILE_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -0,0 +1,180 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   EvalProfile.h
+ *
+ * @brief  Per-unit evaluation metrics recorded in one run and used to plan later runs.
+ */
+
+#ifndef EVALPROFILE_HPP_INCLUDED__18102026
+#define EVALPROFILE_HPP_INCLUDED__18102026
+
+#include "dlvhex2/PlatformDefinitions.h"
+#include "dlvhex2/fwd.h"
+#include "dlvhex2/ComponentGraph.h"
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/ModelGenerator.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/**
+ * \brief Metrics of the evaluation units of one run, identified by the rules they contain.
+ *
+ * When recording (option --dumpevalprofile=F), the model generator factory of each unit
+ * is wrapped such that all model generators of the unit measure
+ * * how often the unit was instantiated (= number of input models),
+ * * how many models and how many compatible set candidates it produced,
+ * * how many ground atoms were added to the registry,
+ * * time spent in the unit, thereof in grounding, external atom evaluation and UFS checks,
+ * * number of external atom calls.
+ *
+ * Grounding, external atom and UFS figures are taken from the global benchmark counters
+ * ("Grounder time", "HEX grounder time", "PluginAtom retrieve", "UnfoundedSetChkMgr::getUFS",
+ * "Candidate compatible sets") while a model generator of the unit runs.
+ * Therefore recording requires DLVHEX_BENCHMARK and a model builder which runs
+ * one model generator at a time; the command line rejects other configurations.
+ *
+ * As IDs are only meaningful within one run, units are identified by the textual form of their rules.
+ * A profile can be read again (heuristic "profile:F") to predict the cost of evaluating a set of rules in one unit.
+ */
+class DLVHEX_EXPORT EvalProfile
+{
+    public:
+        /** \brief Metrics of one evaluation unit. */
+        struct UnitMetrics
+        {
+            /** \brief Number of model generators created for the unit. */
+            unsigned instantiations;
+            /** \brief Number of models returned by the unit. */
+            unsigned models;
+            /** \brief Number of compatible set candidates checked in the unit. */
+            unsigned candidates;
+            /** \brief Number of ground atoms registered while evaluating the unit. */
+            unsigned groundAtoms;
+            /** \brief Number of calls to external sources. */
+            unsigned eatomCalls;
+            /** \brief Total time spent in the unit in seconds. */
+            double time;
+            /** \brief Time spent in grounding in seconds. */
+            double groundingTime;
+            /** \brief Time spent in external sources in seconds. */
+            double eatomTime;
+            /** \brief Time spent in unfounded set checks in seconds. */
+            double ufsTime;
+
+            /** \brief Constructor. */
+            UnitMetrics();
+        };
+
+        /** \brief Recorded or loaded unit. */
+        struct Unit
+        {
+            /** \brief Textual form of the rules and constraints of the unit. */
+            std::vector<std::string> rules;
+            /** \brief Metrics of the unit. */
+            UnitMetrics metrics;
+            /** \brief Protects UnitMetrics while recording. */
+            boost::mutex mutex;
+        };
+        typedef boost::shared_ptr<Unit> UnitPtr;
+
+        /** \brief Prediction for a set of rules derived from the profile. */
+        struct Estimate
+        {
+            /** \brief True if at least one rule was found in the profile. */
+            bool known;
+            /** \brief Expected time per instantiation in seconds. */
+            double time;
+            /** \brief Expected grounding time per instantiation in seconds. */
+            double groundingTime;
+            /** \brief Expected number of models per instantiation. */
+            double models;
+            /** \brief Expected number of compatible set candidates per instantiation. */
+            double candidates;
+
+            /** \brief Constructor. */
+            Estimate();
+        };
+
+        typedef ModelGeneratorFactoryBase<Interpretation>::Ptr ModelGeneratorFactoryPtr;
+
+    protected:
+        /** \brief Registry used for printing rules. */
+        RegistryPtr reg;
+        /** \brief All units of the profile in order of creation. */
+        std::vector<UnitPtr> units;
+        /** \brief Maps rule texts to the unit containing the rule. */
+        std::map<std::string, UnitPtr> unitOfRule;
+
+    public:
+        /** \brief Constructor.
+         * @param reg Registry used for printing rules. */
+        EvalProfile(RegistryPtr reg);
+
+        /** \brief Computes the rule texts which identify a component.
+         * @param ci Component.
+         * @return Sorted textual forms of inner rules and constraints of \p ci. */
+        std::vector<std::string> getRuleTexts(const ComponentGraph::ComponentInfo& ci) const;
+
+        /** \brief Registers a unit for recording.
+         * @param ci Component of the unit.
+         * @param mgf Model generator factory of the unit.
+         * @return Model generator factory which must be used for the unit instead of \p mgf. */
+        ModelGeneratorFactoryPtr record(const ComponentGraph::ComponentInfo& ci, ModelGeneratorFactoryPtr mgf);
+
+        /** \brief Writes the profile.
+         * @param o Stream to write to. */
+        void write(std::ostream& o) const;
+
+        /** \brief Reads a profile written by write().
+         * @param fname File to read. */
+        void load(const std::string& fname);
+
+        /** \brief Predicts the metrics of a unit consisting of a given component.
+         *
+         * The component need not correspond to a unit of the profile:
+         * times are distributed over the rules of a profiled unit,
+         * models and candidates are taken from the profiled units containing rules of the component.
+         * @param ci Component.
+         * @return Estimate; Estimate::known is false if no rule of \p ci occurs in the profile. */
+        Estimate estimate(const ComponentGraph::ComponentInfo& ci) const;
+};
+
+DLVHEX_NAMESPACE_END
+#endif                           // EVALPROFILE_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
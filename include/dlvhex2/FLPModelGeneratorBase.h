@@ -83,6 +83,8 @@ public BaseModelGeneratorFactory
         std::vector<ID> deidb;
         /** \brief Inner external Atoms in deidb. */
         std::vector<ID> deidbInnerEatoms;
+        /** \brief Results of previous domain explorations over deidb. */
+        DomainExplorationCache domainExplorationCache;
 
         // xidb rewritten for FLP calculation
         /** \brief Rewriting to find out which body is satisfied -> creates heads. */
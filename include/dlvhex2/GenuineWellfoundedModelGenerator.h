@@ -119,6 +119,8 @@ public ostream_printable<GenuineWellfoundedModelGeneratorFactory>
          *
          * Equivalent to xidb, except that it does not contain domain predicates). */
         std::vector<ID> deidb;
+        /** \brief Results of previous domain explorations over deidb. */
+        DomainExplorationCache domainExplorationCache;
 
         // methods
     public:
@@ -189,7 +189,7 @@ class GringoGrounder: public GenuineGrounder
 
                 /** \brief Stores for each gringo index the HEX ID if already assigned. */
                 std::map<int, ID> indexToGroundAtomID;
-                /** \brief Set of rules in lparse format to be converted to HEX. */
+                /** \brief Set of rules in lparse format to be converted to HEX; rules are removed as soon as they are converted. */
                 std::list<LParseRule> rules;
 
                 /** \brief Dummy empty stream. */
@@ -449,7 +449,7 @@ class GringoGrounder: public GenuineGrounder
 
                 /** \brief Stores for each known Gringo atom the HEX ID. */
                 std::map<int, ID> indexToGroundAtomID;
-                /** \brief List of rules in the ground program in Lparse format. */
+                /** \brief List of rules in the ground program in Lparse format; rules are removed as soon as they are converted. */
                 std::list<LParseRule> rules;
             public:
                 /** \brief Constructor.
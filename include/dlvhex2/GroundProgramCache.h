@@ -0,0 +1,111 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   GroundProgramCache.h
+ *
+ * @brief  On-disk cache of ground programs of evaluation units.
+ */
+
+#ifndef GROUNDPROGRAMCACHE_HPP_INCLUDED__18102026
+#define GROUNDPROGRAMCACHE_HPP_INCLUDED__18102026
+
+#include "dlvhex2/PlatformDefinitions.h"
+#include "dlvhex2/fwd.h"
+#include "dlvhex2/ID.h"
+#include "dlvhex2/OrdinaryASPProgram.h"
+
+#include <string>
+#include <vector>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/**
+ * \brief Stores ground programs on disk and retrieves them in later runs.
+ *
+ * A ground program is identified by the complete input of the grounder,
+ * i.e., the nonground rules of the unit together with its (projected) input facts.
+ * Cache files are named after a hash of this key and contain the key itself,
+ * such that hash collisions are detected on lookup.
+ *
+ * Atoms are stored in textual form together with their address, because IDs are only
+ * meaningful within one Registry. When a ground program is loaded, atoms whose address
+ * still refers to the same atom (e.g. after restoring a registry snapshot) are used directly,
+ * all others are registered again. Rules are stored as references into the atom list of the file.
+ *
+ * The cache is enabled by option --groundcache=DIR (configuration option "GroundingCacheDir").
+ */
+class DLVHEX_EXPORT GroundProgramCache
+{
+    public:
+        /** \brief Constructor.
+         * @param ctx ProgramCtx which provides the cache directory and the registry. */
+        GroundProgramCache(ProgramCtx& ctx);
+
+        /** \brief Checks if a cache directory was configured.
+         * @return True if ground programs shall be loaded from and stored to disk. */
+        bool enabled() const
+            { return !directory.empty(); }
+
+        /** \brief Loads the ground program for \p key.
+         * @param key Complete grounder input.
+         * @param groundProgram Program whose edb, idb and mask are set if the key is found;
+         * its mask must contain the mask of the nonground program.
+         * @return True if the key was found, false otherwise (then \p groundProgram is not modified). */
+        bool load(const std::string& key, OrdinaryASPProgram& groundProgram);
+
+        /** \brief Stores the ground program for \p key.
+         *
+         * Failures to write the cache file are reported as warnings and otherwise ignored.
+         * @param key Complete grounder input.
+         * @param groundProgram Ground program computed from \p key.
+         * @param inputMask Mask of the nonground program; only atoms masked in addition by the grounder are stored. */
+        void store(const std::string& key, const OrdinaryASPProgram& groundProgram, InterpretationConstPtr inputMask);
+
+    protected:
+        /** \brief ProgramCtx. */
+        ProgramCtx& ctx;
+        /** \brief Directory of the cache files; empty if the cache is disabled. */
+        std::string directory;
+
+        /** \brief Computes the file name for a key.
+         * @param key Complete grounder input.
+         * @return Path of the cache file. */
+        std::string getFileName(const std::string& key) const;
+
+        /** \brief Registers a ground atom given in textual form.
+         * @param kind Kind of the atom as it was stored.
+         * @param text Textual representation of the atom.
+         * @return ID of the atom in the current registry. */
+        ID registerAtom(IDKind kind, const std::string& text);
+};
+
+DLVHEX_NAMESPACE_END
+#endif                           // GROUNDPROGRAMCACHE_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -112,9 +112,7 @@ struct sem<HexGrammarSemantics::termFromFunctionTerm>
             BOOST_FOREACH (ID id, boost::fusion::at_c<1>(source).get().get()) args.push_back(id);
         }
 
-        Term term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED, args, mgr.ctx.registry());
-        target = mgr.ctx.registry()->terms.getIDByString(term.symbol);
-        if (target == ID_FAIL) target = mgr.ctx.registry()->terms.storeAndGetID(term);
+        target = mgr.ctx.registry()->storeNestedTerm(args);
     }
 };
 
@@ -129,9 +127,7 @@ struct sem<HexGrammarSemantics::termFromRange>
         args.push_back(fid);
         args.push_back(boost::fusion::at_c<0>(source));
         args.push_back(boost::fusion::at_c<1>(source));
-        Term rangeTerm(ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED | ID::PROPERTY_TERM_RANGE, args, mgr.ctx.registry());
-        target = mgr.ctx.registry()->terms.getIDByString(rangeTerm.symbol);
-        if (target == ID_FAIL) target = mgr.ctx.registry()->terms.storeAndGetID(rangeTerm);
+        target = mgr.ctx.registry()->storeNestedTerm(args, ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED | ID::PROPERTY_TERM_RANGE);
     }
 };
 
@@ -901,7 +897,7 @@ struct sem<HexGrammarSemantics::add>
             // fact -> put into EDB
             if( !source.isOrdinaryGroundAtom() )
                 throw SyntaxError(
-                    "fact '"+reg->onatoms.getByID(source).text+"' not safe!");
+                    "fact '"+printToString<RawPrinter>(source, reg)+"' not safe!");
 
             if ( mgr.mlpMode == 0 ) {
                                  // ordinary encoding
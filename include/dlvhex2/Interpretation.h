@@ -75,7 +75,7 @@ public ostream_printable<Interpretation>
         // members
     public:
         /** \brief Constructor. */
-        inline Interpretation(){};
+        inline Interpretation(): hashUpdated(false) {}
         /** \brief Constructor.
          * @param registry Registry to use for interpreting IDs.
          */
@@ -197,6 +197,15 @@ public ostream_printable<Interpretation>
         const Storage& getStorage() const { return bits; }
         Storage& getStorage() { return bits; }
 
+        /** \brief Selects the representation of blocks of the bitset which are allocated in the future.
+         *
+         * bm::BM_BIT (default) stores plain bits, which is fastest for dense interpretations such as masks;
+         * bm::BM_GAP stores blocks run-length encoded and converts them to plain bits only if they become dense,
+         * which saves memory for sparse interpretations such as models of large ground programs.
+         * Existing blocks are converted by compactInterpretation.
+         * @param strategy bm::BM_BIT or bm::BM_GAP. */
+        void setBlockStrategy(bm::strategy strategy) { bits.set_new_blocks_strat(strategy); }
+
         /**
          * \brief Returns a pair of a begin and an end operator to iterate through true atoms in the interpretation.
          * @return Pair of a begin and an end operator; dereferencing iterator gives IDAddress.
@@ -269,6 +278,23 @@ typedef Interpretation::ConstPtr InterpretationConstPtr;
 
 DLVHEX_EXPORT std::size_t hash_value(const Interpretation& intr);
 
+/** \brief Checks if all atoms of \p sub are also true in \p super.
+ *
+ * Used by model builders to join interpretations without copying.
+ * @param super Interpretation which might contain \p sub.
+ * @param sub Interpretation which might be contained in \p super.
+ * @return True if \p sub is a subset of \p super. */
+DLVHEX_EXPORT bool interpretationSubsumes(const Interpretation& super, const Interpretation& sub);
+
+/** \brief Compresses the storage of an interpretation.
+ *
+ * Each block of the bitset is stored in the representation best suited
+ * for its density (plain bits or run-length encoded), empty and full blocks are freed.
+ * The set of atoms does not change, all operations work on the compressed storage.
+ * Blocks allocated afterwards are run-length encoded as well (see Interpretation::setBlockStrategy).
+ * @param intr Interpretation to compact. */
+DLVHEX_EXPORT void compactInterpretation(Interpretation& intr);
+
 // TODO perhaps we want to have something like this for (manual) joins
 // (see https://dlvhex.svn.sourceforge.net/svnroot/dlvhex/dlvhex/branches/dlvhex-depgraph-refactoring@1555)
 //void multiplyInterpretations(
@@ -47,13 +47,22 @@ struct ModelBuilderConfig
     /** \brief Constructor.
      * @param eg See ModelBuilderConfig::eg. */
     ModelBuilderConfig(EvalGraphT& eg):
-    eg(eg), redundancyElimination(true), constantSpace(false) {}
+    eg(eg), redundancyElimination(true), constantSpace(false),
+        parallelThreads(0), modelBufferSize(4), modelQueueSize(5), compactModels(false) {}
     /** \brief Evaluation graph to use for model building. */
     EvalGraphT& eg;
     /** \brief True to optimize redundant parts in the model building process. */
     bool redundancyElimination;
     /** \brief True to work with constant space. */
     bool constantSpace;
+    /** \brief Number of worker threads of parallel model builders (0 = one per hardware thread). */
+    unsigned parallelThreads;
+    /** \brief Maximum number of models computed ahead per unit by parallel model builders. */
+    unsigned modelBufferSize;
+    /** \brief Capacity of the model queue of each unit in pipelined model building. */
+    unsigned modelQueueSize;
+    /** \brief True to store interpretations of models in compressed form (see compactInterpretation). */
+    bool compactModels;
 };
 
 /** \brief Base class for all model builders. */
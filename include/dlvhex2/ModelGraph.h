@@ -37,8 +37,10 @@
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
+#include <vector>
 
 DLVHEX_NAMESPACE_BEGIN
 
@@ -141,11 +143,13 @@ class ModelGraph
             // successor models per successor eval unit, suitable for fast set intersection
             // (we also need the chronological ordering of adjacency_list,
             //  so we cannot replace that one by an ordered container)
+            // (sorted vectors instead of std::set: one pointer per successor instead of one tree node)
 
             // (we must not use "Model" here because "Model" is defined using
             // "ModelPropertyBundle" (i.e., this class))
-            //typedef std::map<EvalUnit, std::set<Model> > SuccessorModelMap;
-            typedef std::map<EvalUnit, std::set<void*> > SuccessorModelMap;
+            //typedef std::map<EvalUnit, std::vector<Model> > SuccessorModelMap;
+            typedef std::vector<void*> SuccessorModelSet;
+            typedef std::map<EvalUnit, SuccessorModelSet> SuccessorModelMap;
             SuccessorModelMap successors;
 
         public:
@@ -307,6 +311,13 @@ class ModelGraph
             ModelType type,
             const std::vector<Model>& deps=std::vector<Model>());
 
+        /** \brief Removes a model which has no successors.
+         *
+         * Removes the model, its dependencies, and its entries in the successor sets
+         * of its predecessors and in modelsAt; descriptors of other models stay valid.
+         * @param m Model to remove. */
+        void removeModel(Model m);
+
         /** \brief Intersect sets of successors of models \p mm.
          * @param location See ModelGraph::location.
          * @return First intersected element, boost::none if none. */
@@ -571,9 +582,10 @@ const std::vector<Model>& deps)
 
         // if index does not exist, empty set will be created
         // TODO see getSuccessorIntersection
-        std::set<void*>& successorsForThisEvalUnit =
+        typename ModelPropertyBundle::SuccessorModelSet& successorsForThisEvalUnit =
             propsOf(deps[i]).successors[location];
-        successorsForThisEvalUnit.insert(m);
+        successorsForThisEvalUnit.insert(
+            std::lower_bound(successorsForThisEvalUnit.begin(), successorsForThisEvalUnit.end(), m), m);
     }
 
     // update modelsAt property map (models at each eval unit are registered there)
@@ -584,6 +596,44 @@ const std::vector<Model>& deps)
 }                                // ModelGraph<...>::addModel(...) implementation
 
 
+// ModelGraph<...>::removeModel(...) implementation
+template<typename EvalGraphT, typename ModelPropertiesT, typename ModelDepPropertiesT>
+void
+ModelGraph<EvalGraphT, ModelPropertiesT, ModelDepPropertiesT>::removeModel(
+Model m)
+{
+    LOG_VSCOPE(MODELB,"MG::removeModel",this,true);
+    assert(boost::in_degree(m, mg) == 0 && "can only remove models without successors");
+    const ModelPropertyBundle& prop = propsOf(m);
+
+    // remove from successor sets of predecessors
+    PredecessorIterator it, end;
+    for(boost::tie(it, end) = getPredecessors(m); it != end; ++it) {
+        typename ModelPropertyBundle::SuccessorModelMap& successors =
+            propsOf(targetOf(*it)).successors;
+        typename ModelPropertyBundle::SuccessorModelMap::iterator itsucc =
+            successors.find(prop.location);
+        assert(itsucc != successors.end());
+        typename ModelPropertyBundle::SuccessorModelSet& succs = itsucc->second;
+        typename ModelPropertyBundle::SuccessorModelSet::iterator pos =
+            std::lower_bound(succs.begin(), succs.end(), m);
+        assert(pos != succs.end() && *pos == m);
+        succs.erase(pos);
+        if( succs.empty() )
+            successors.erase(itsucc);
+    }
+
+    // update modelsAt property map
+    ModelList& models = mau[prop.location].getModels(prop.type);
+    typename ModelList::iterator itm = std::find(models.begin(), models.end(), m);
+    assert(itm != models.end());
+    models.erase(itm);
+
+    boost::clear_vertex(m, mg);
+    boost::remove_vertex(m, mg);
+}                                // ModelGraph<...>::removeModel(...) implementation
+
+
 // ModelGraph<...>::getSuccessorIntersection(...) implementation
 //
 // given an eval unit and for each predecessor of this unit a model,
@@ -622,7 +672,7 @@ const std::vector<typename ModelGraph<EvalGraphT, ModelPropertiesT, ModelDepProp
             propsOf(mm.front()).successors.find(location);
         if( itsucc != propsOf(mm.front()).successors.end() ) {
             // found successor set -> good (take first, which should be the only one)
-            const std::set<void*>& succs = itsucc->second;
+            const typename ModelPropertyBundle::SuccessorModelSet& succs = itsucc->second;
             DBGLOG(DBG, "found successor (" << succs.size() << ")");
             assert(succs.size() == 1);
             return *succs.begin();
@@ -635,7 +685,7 @@ const std::vector<typename ModelGraph<EvalGraphT, ModelPropertiesT, ModelDepProp
     }
 
     // regular processing
-    typedef typename std::set<void*>::const_iterator SuccIter;
+    typedef typename ModelPropertyBundle::SuccessorModelSet::const_iterator SuccIter;
     // for each predecessor model we have a begin and an end iterator of all of their successors
     typename std::vector<SuccIter> iters;
     typename std::vector<SuccIter> ends;
@@ -645,7 +695,7 @@ const std::vector<typename ModelGraph<EvalGraphT, ModelPropertiesT, ModelDepProp
         typename ModelPropertyBundle::SuccessorModelMap::const_iterator itsucc =
             propsOf(m).successors.find(location);
         if( itsucc != propsOf(m).successors.end() ) {
-            const std::set<void*>& succs = itsucc->second;
+            const typename ModelPropertyBundle::SuccessorModelSet& succs = itsucc->second;
             iters.push_back(succs.begin());
             ends.push_back(succs.end());
             #ifndef NDEBUG
@@ -35,6 +35,7 @@
 #define NOGOOD_HPP_INCLUDED__09122011
 
 #include <vector>
+#include <deque>
 #include <set>
 #include <map>
 #include <boost/foreach.hpp>
@@ -101,7 +102,7 @@ class DLVHEX_EXPORT Nogood : public Set<ID>, public ostream_printable<Nogood>
          * \brief Returns the hash of the nogood.
          * @return Hash of the nogood.
          */
-        size_t getHash();
+        size_t getHash() const;
 
         /**
          * \brief Overwrites the contents of the nogood with a new one.
@@ -209,17 +210,27 @@ class DLVHEX_EXPORT Nogood : public Set<ID>, public ostream_printable<Nogood>
 class DLVHEX_EXPORT NogoodSet : private ostream_printable<NogoodSet>
 {
     private:
-        /** \brief Internal nogood vector. */
-        std::vector<Nogood> nogoods;
+        /** \brief Internal nogood storage.
+         *
+         * A deque is used because it never relocates stored nogoods when it grows:
+         * adding nogoods neither copies the existing ones nor invalidates references obtained by NogoodSet::getNogood. */
+        std::deque<Nogood> nogoods;
         /** \brief Stores for each nogood how often it was added although it is actually stored only once since this is a set (used for deletion strategies). */
         std::vector<int> addCount;
         /** \brief Indices between 0 and nogoods.size() which are currently unused. */
         Set<int> freeIndices;
-        /** Stores for each hash the indices of nogoods with this hash (used in the unlikely case that there is a clash of hashes). */
-        boost::unordered_map<size_t, Set<int> > nogoodsWithHash;
+        /** Stores for each hash the indices of nogoods with this hash (a hash may occur multiple times in the unlikely case of clashes). */
+        boost::unordered_multimap<std::size_t, int> nogoodsWithHash;
+
+        /** \brief Finds a nogood in the set.
+         * @param ng Nogood with up-to-date hash (see Nogood::recomputeHash).
+         * @return Index of \p ng or -1 if it is not contained. */
+        int findNogood(const Nogood& ng) const;
 
     public:
-        /** \brief Reorders the nogoods such that there are no free indices in the range 0-(getNogoodCount()-1). */
+        /** \brief Reorders the nogoods such that there are no free indices in the range 0-(getNogoodCount()-1).
+         *
+         * Storage of the removed nogoods is released; references obtained by NogoodSet::getNogood become invalid. */
         void defragment();
 
         /**
@@ -39,10 +39,34 @@
 #include "dlvhex2/ModelGenerator.h"
 #include "dlvhex2/ModelBuilder.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <set>
 
 DLVHEX_NAMESPACE_BEGIN
 
+/** \brief Checks if all atoms of \p sub are also true in \p super.
+ *
+ * Fallback for interpretation types without a cheap subset test; interpretation
+ * types can provide an overload (see Interpretation.h) to let model builders
+ * join interpretations without copying.
+ * @return False (subsumption is unknown). */
+template<typename InterpretationT>
+inline bool interpretationSubsumes(const InterpretationT& super, const InterpretationT& sub)
+{
+    return false;
+}
+
+/** \brief Reduces the memory used by an interpretation which is not modified anymore.
+ *
+ * Fallback for interpretation types without compressed storage; interpretation
+ * types can provide an overload (see Interpretation.h).
+ * @param intr Interpretation to compact. */
+template<typename InterpretationT>
+inline void compactInterpretation(InterpretationT& intr)
+{
+}
+
 /** \brief Template for online model building of a ModelGraph based on an EvalGraph. */
 template<typename EvalGraphT>
 class OnlineModelBuilder:
@@ -197,17 +221,14 @@ public ModelBuilder<EvalGraphT>
 
     protected:
         /** \brief Clears the interpretation of an input model.
+         *
+         * The interpretation is joined again from the predecessor omodels if the imodel is reused.
+         * (Interpretations of output models are never cleared as they cannot be restored.)
          * @param m Input model. */
         void clearIModel(Model m) {
             mg.propsOf(m).interpretation.reset();
         }
 
-        /** \brief Clears the interpretation of an output model.
-         * @param msi ModelSuccessorIterator. */
-        void clearOModel(ModelSuccessorIterator msi) {
-            mg.propsOf(mg.sourceOf(*msi)).interpretation.reset();
-        }
-
     private:
         /** \brief Observer. */
         typedef typename EvalGraphT::Observer EvalGraphObserverBase;
@@ -252,6 +273,13 @@ public ModelBuilder<EvalGraphT>
         bool redundancyElimination;
         /** \brief See ModelBuilderConfig. */
         bool constantSpace;
+        /** \brief If true, getNextIModel starts the model generators of all predecessors
+         * whose input is available before it waits for the first of them.
+         *
+         * This is only useful for model builders whose model generators compute models concurrently. */
+        bool startGeneratorsEarly;
+        /** \brief See ModelBuilderConfig. */
+        bool compactModels;
 
         // methods
     public:
@@ -264,7 +292,9 @@ public ModelBuilder<EvalGraphT>
         // after the creation of this OnlineModelBuilder
             ego(new EvalGraphObserver(*this)),
             redundancyElimination(cfg.redundancyElimination),
-        constantSpace(cfg.constantSpace) {
+            constantSpace(cfg.constantSpace),
+            startGeneratorsEarly(false),
+        compactModels(cfg.compactModels) {
             EvalGraphT& eg = cfg.eg;
             // allocate full mbp (plus one unit, as we will likely get an additional vertex)
             EvalUnitModelBuildingProperties& mbproptemp = mbp[eg.countEvalUnits()];
@@ -296,6 +326,10 @@ public ModelBuilder<EvalGraphT>
          * @param u Evaluation Unit.
          * @return Model. */
         Model createIModelFromPredecessorOModels(EvalUnit u);
+        /** \brief Helper for createIModelFromPredecessorOModels.
+         * @param deps Predecessor omodels in join order.
+         * @return Joined interpretation (possibly shared with a predecessor). */
+        InterpretationPtr joinPredecessorInterpretations(const std::vector<Model>& deps);
 
         /**
          * nonrecursive "get next" wrt. a mandatory imodel
@@ -307,6 +341,15 @@ public ModelBuilder<EvalGraphT>
          * @param u Evaluation unit.
          * @return OptionalModel. */
         OptionalModel createNextModel(EvalUnit u);
+        /** \brief Helper for createNextModel.
+         *
+         * Creates the model generator of a unit for the given input;
+         * derived model builders may wrap the generator.
+         * @param u Evaluation unit.
+         * @param input Input interpretation (may be NULL).
+         * @return Model generator. */
+        virtual typename ModelGeneratorBase<Interpretation>::Ptr
+            createModelGenerator(EvalUnit u, typename Interpretation::ConstPtr input);
         /** \brief Helper for advanceOModelForIModel.
          * @param u Evaluation unit.
          * @param cursor Cursor.
@@ -314,10 +357,23 @@ public ModelBuilder<EvalGraphT>
         boost::optional<EvalUnitPredecessorIterator>
             ensureModelIncrement(EvalUnit u, EvalUnitPredecessorIterator cursor);
 
-        /** \brief Removes a model from the model graph to keep the evaluation in constant space.
+        /** \brief Removes a replaced imodel from the model graph to keep the evaluation in constant space.
+         *
+         * Only imodels of units without successor units (in particular the final unit) are removed,
+         * since these are never reused; for other imodels only the interpretation is freed.
          * @param m Model to remove. */
         void removeIModelFromGraphs(Model m);
 
+        /** \brief Starts the model generator of a unit (or of the units below it) without waiting for a model.
+         *
+         * Units without input get their dummy imodel; a unit with an imodel for which no models have
+         * been generated yet gets its model generator; for units which still wait for their input
+         * this is done recursively for their predecessors. No models are consumed, hence
+         * the order of model enumeration is not affected.
+         * @param u Evaluation unit.
+         * @param visited Units visited so far. */
+        void startModelGenerators(EvalUnit u, std::set<EvalUnit>& visited);
+
     public:
         // get next input model (projected if projection is configured) at unit u
         virtual OptionalModel getNextIModel(EvalUnit u);
@@ -450,11 +506,32 @@ EvalUnit u)
         OptionalModel oexisting = mg.getSuccessorIntersection(u, deps);
         if( !!oexisting ) {
             LOG(MODELB,"found and will return existing successor imodel " << oexisting.get());
+            ModelPropertyBundle& existingprops = mg.propsOf(oexisting.get());
+            if( !existingprops.interpretation ) {
+                // interpretation was freed in constant space mode -> join again
+                LOG(MODELB,"restoring interpretation of existing imodel");
+                existingprops.interpretation = joinPredecessorInterpretations(deps);
+            }
             return oexisting.get();
         }
     }
 
     // create interpretation
+    InterpretationPtr pjoin = joinPredecessorInterpretations(deps);
+
+    // create model
+    Model m = mg.addModel(u, MT_IN, deps);
+    LOG(MODELB,"returning new MT_IN model " << m);
+    mg.propsOf(m).interpretation = pjoin;
+    return m;
+}
+
+
+template<typename EvalGraphT>
+typename OnlineModelBuilder<EvalGraphT>::InterpretationPtr
+OnlineModelBuilder<EvalGraphT>::joinPredecessorInterpretations(
+const std::vector<Model>& deps)
+{
     InterpretationPtr pjoin;
     if( deps.size() == 1 ) {
         // only link
@@ -465,6 +542,9 @@ EvalUnit u)
     else {
         // create joined interpretation
         LOG(MODELB,"more than one predecessor -> joining omodels");
+        // collect distinct predecessor interpretations
+        // (predecessors may share an interpretation, e.g., if they link to the same input)
+        std::vector<InterpretationPtr> parts;
         typename std::vector<Model>::const_iterator it;
         for(it = deps.begin(); it != deps.end(); ++it) {
             InterpretationPtr predinterpretation = mg.propsOf(*it).interpretation;
@@ -472,23 +552,43 @@ EvalUnit u)
                 " has interpretation " << printptr(predinterpretation) <<
                 " with contents " << *predinterpretation);
             assert(predinterpretation != 0);
-            if( pjoin == 0 ) {
-                // copy interpretation
-                pjoin.reset(new Interpretation(*predinterpretation));
+            if( std::find(parts.begin(), parts.end(), predinterpretation) == parts.end() )
+                parts.push_back(predinterpretation);
+        }
+
+        // output models usually contain their input, so often one predecessor
+        // interpretation contains all others and we can link to it like above
+        // (interpretations of models are never modified after creation)
+        typename std::vector<InterpretationPtr>::const_iterator pit, qit;
+        for(pit = parts.begin(); pit != parts.end() && pjoin == 0; ++pit) {
+            for(qit = parts.begin(); qit != parts.end(); ++qit) {
+                if( qit != pit && !interpretationSubsumes(**pit, **qit) )
+                    break;
             }
-            else {
-                // merge interpretation
-                pjoin->add(*predinterpretation);
+            if( qit == parts.end() ) {
+                LOG(MODELB,"predecessor interpretation " << printptr(*pit) << " subsumes all others -> linking to it");
+                pjoin = *pit;
             }
-            DBGLOG(DBG,"pjoin now has contents " << *pjoin);
         }
-    }
 
-    // create model
-    Model m = mg.addModel(u, MT_IN, deps);
-    LOG(MODELB,"returning new MT_IN model " << m);
-    mg.propsOf(m).interpretation = pjoin;
-    return m;
+        if( pjoin == 0 ) {
+            LOG(MODELB,"no predecessor interpretation subsumes all others -> copying");
+            for(pit = parts.begin(); pit != parts.end(); ++pit) {
+                if( pjoin == 0 ) {
+                    // copy interpretation
+                    pjoin.reset(new Interpretation(**pit));
+                }
+                else {
+                    // merge interpretation
+                    pjoin->add(**pit);
+                }
+            }
+            if( compactModels )
+                compactInterpretation(*pjoin);
+        }
+        DBGLOG(DBG,"pjoin now has contents " << *pjoin);
+    }
+    return pjoin;
 }
 
 
@@ -645,6 +745,15 @@ EvalUnit u)
     // now, cursor is index of first unit where we do not hold a refcount
     LOG(MODELB,"phase 2");
 
+    if( startGeneratorsEarly ) {
+        // let independent predecessors compute their models concurrently
+        // instead of waiting for each one in join order
+        std::set<EvalUnit> visited;
+        for(typename EvalGraphT::PredecessorIterator it = cursor; it != pend; ++it) {
+            startModelGenerators(eg.targetOf(*it), visited);
+        }
+    }
+
     while(cursor != pend) {
         typename EvalGraphT::EvalUnit ucursor =
             eg.targetOf(*cursor);
@@ -696,9 +805,10 @@ EvalUnit u)
     LOG(MODELB,"found full input model, creating imodel!");
     Model im = createIModelFromPredecessorOModels(u);
     LOG(MODELB,"returning newly created imodel " << im);
-    if( hadIModel && constantSpace )
-        clearIModel(mbprops.getIModel().get());
+    OptionalModel oldimodel = mbprops.getIModel();
     mbprops.setIModel(im);
+    if( hadIModel && constantSpace && oldimodel.get() != im )
+        removeIModelFromGraphs(oldimodel.get());
     #ifndef NDEBUG
     if( Logger::Instance().shallPrint(Logger::MODELB) && Logger::Instance().shallPrint(Logger::DBG) )
         printModelBuildingPropertyMap(std::cerr);
@@ -707,6 +817,70 @@ EvalUnit u)
 }
 
 
+template<typename EvalGraphT>
+void
+OnlineModelBuilder<EvalGraphT>::removeIModelFromGraphs(
+Model m)
+{
+    LOG_VSCOPE(MODELB,"rIMfG",m,true);
+    const ModelPropertyBundle& mprops = mg.propsOf(m);
+    typename EvalGraphT::SuccessorIterator usbegin, usend;
+    boost::tie(usbegin, usend) = eg.getSuccessors(mprops.location);
+    ModelSuccessorIterator msbegin, msend;
+    boost::tie(msbegin, msend) = mg.getSuccessors(m);
+    if( mprops.dummy || usbegin != usend || msbegin != msend ) {
+        // this imodel might be used again -> only free its interpretation
+        clearIModel(m);
+        return;
+    }
+
+    // no successor unit will ever ask for this imodel, and each combination
+    // of predecessor omodels is joined at most once here
+    // (if not, redundancy elimination simply joins again)
+    LOG(MODELB,"removing imodel " << m << " from model graph");
+    mg.removeModel(m);
+}
+
+
+template<typename EvalGraphT>
+void
+OnlineModelBuilder<EvalGraphT>::startModelGenerators(
+EvalUnit u, std::set<EvalUnit>& visited)
+{
+    if( !visited.insert(u).second )
+        return;
+
+    EvalUnitModelBuildingProperties& mbprops = mbp[u];
+    if( mbprops.hasOModel() || !!mbprops.currentmg )
+        return;
+
+    if( !mbprops.getIModel() ) {
+        if( mbprops.needInput ) {
+            // getting the imodel would wait for predecessor models -> go deeper
+            typename EvalGraphT::PredecessorIterator pit, pend;
+            for(boost::tie(pit, pend) = eg.getPredecessors(u); pit != pend; ++pit) {
+                startModelGenerators(eg.targetOf(*pit), visited);
+            }
+            return;
+        }
+        // this is exactly what getNextOModel would do first
+        getNextIModel(u);
+        assert(!!mbprops.getIModel());
+    }
+
+    // only start if createNextModel will be the next thing done for this imodel
+    Model imodel = mbprops.getIModel().get();
+    const ModelPropertyBundle& imodelprops = mg.propsOf(imodel);
+    ModelSuccessorIterator sbegin, send;
+    boost::tie(sbegin, send) = mg.getSuccessors(imodel);
+    if( imodelprops.childModelsGenerated || sbegin != send )
+        return;
+
+    LOG(MODELB,"starting model generator of unit " << u << " early");
+    mbprops.currentmg = createModelGenerator(u, imodelprops.interpretation);
+}
+
+
 // [checks if model generation is still possible given current input model]
 // [checks if no model is currently stored as current omodel]
 // if no model generator is running
@@ -746,11 +920,8 @@ EvalUnit u)
         // (this may be a dummy, so interpretation may be NULL which is ok)
         input = mg.propsOf(mbprops.getIModel().get()).interpretation;
 
-        // mgf is of type ModelGeneratorFactory::Ptr
         LOG(MODELB,"creating model generator");
-        mbprops.currentmg =
-            eg.propsOf(u).mgf->createModelGenerator(input)
-            ;
+        mbprops.currentmg = createModelGenerator(u, input);
     }
 
     // use model generator to create new model
@@ -768,6 +939,9 @@ EvalUnit u)
         LOG(MODELB,"stored new model " << m);
 
         // configure model
+        // (models are kept in the model graph for successor units, so store them compactly)
+        if( compactModels )
+            compactInterpretation(*intp);
         mg.propsOf(m).interpretation = intp;
 
         // TODO: handle projection here?
@@ -823,6 +997,16 @@ EvalUnit u)
 }
 
 
+template<typename EvalGraphT>
+typename ModelGeneratorBase<typename OnlineModelBuilder<EvalGraphT>::Interpretation>::Ptr
+OnlineModelBuilder<EvalGraphT>::createModelGenerator(
+EvalUnit u, typename Interpretation::ConstPtr input)
+{
+    // mgf is of type ModelGeneratorFactory::Ptr
+    return eg.propsOf(u).mgf->createModelGenerator(input);
+}
+
+
 /**
  * nonrecursive "get next" wrt. a mandatory imodel
  *
@@ -874,8 +1058,6 @@ EvalUnit u)
 
         ModelSuccessorIterator& currentisuccessor = mbprops.currentisuccessor.get();
         assert(currentisuccessor != send);
-        if( constantSpace )
-            clearOModel(currentisuccessor);
         currentisuccessor++;
         if( currentisuccessor != send ) {
             Model m = mg.sourceOf(*currentisuccessor);
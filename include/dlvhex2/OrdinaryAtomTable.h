@@ -42,6 +42,10 @@
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/utility/string_ref.hpp>
+
+#include <vector>
 
 DLVHEX_NAMESPACE_BEGIN
 
@@ -56,11 +60,6 @@ boost::multi_index::indexed_by<
 boost::multi_index::random_access<
 boost::multi_index::tag<impl::AddressTag>
 >,
-// (unique) textual representation (parsing index, see TODO above)
-boost::multi_index::hashed_unique<
-boost::multi_index::tag<impl::TextTag>,
-BOOST_MULTI_INDEX_MEMBER(OrdinaryAtom,std::string,text)
->,
 // unique IDs for unique tuples
 boost::multi_index::hashed_unique<
 boost::multi_index::tag<impl::TupleTag>,
@@ -80,14 +79,82 @@ ID (Atom::*)() const,&Atom::front>
     public:
         typedef Container::index<impl::AddressTag>::type AddressIndex;
         //typedef Container::index<impl::KindTag>::type KindIndex;
-        typedef Container::index<impl::TextTag>::type TextIndex;
         typedef Container::index<impl::TupleTag>::type TupleIndex;
         typedef Container::index<impl::PredicateTag>::type PredicateIndex;
         typedef AddressIndex::iterator AddressIterator;
         typedef PredicateIndex::iterator PredicateIterator;
 
+    protected:
+        /** \brief True if the textual representation of atoms is stored (see OrdinaryAtomTable::setStoreText). */
+        bool storeText;
+        /** \brief Addresses of atoms indexed by their textual representation (only atoms stored with text).
+         *
+         * Keys refer to OrdinaryAtom::text of the atoms in the table (which never move), thus the text is not stored twice. */
+        boost::unordered_map<boost::string_ref, IDAddress, impl::SymbolHash> addressByText;
+        /** \brief True if atoms are indexed by predicate in OrdinaryAtomTable::addressesByPredicate. */
+        bool indexPredicates;
+        /** \brief Addresses of all atoms which are not hidden, indexed by the address of their predicate
+         * (only if OrdinaryAtomTable::indexPredicates).
+         *
+         * The lists are append-only and sorted, thus users can remember how much of a list they have
+         * already seen and later retrieve only the new atoms over a predicate
+         * (see OrdinaryAtomTable::getAddressesByPredicate). */
+        boost::unordered_map<IDAddress, std::vector<IDAddress> > addressesByPredicate;
+        /** \brief Atoms by address for retrieval without locking (see impl::AddressDirectory). */
+        impl::AddressDirectory<OrdinaryAtom> byAddress;
+
+        /** \brief Recreates OrdinaryAtomTable::addressByText for the atoms of this table (after copying). */
+        inline void rebuildTextIndex();
+
         // methods
     public:
+        /** \brief Constructor.
+         * @param indexPredicates True to index atoms by predicate for OrdinaryAtomTable::getAddressesByPredicate;
+         * this is only needed for the table of ground atoms (which is used by PredicateMask). */
+        explicit OrdinaryAtomTable(bool indexPredicates = false): storeText(true), indexPredicates(indexPredicates) {}
+
+        /** \brief Copy-constructor.
+         * @param other Other table. */
+        OrdinaryAtomTable(const OrdinaryAtomTable& other):
+        Table(other),
+            storeText(other.storeText),
+            indexPredicates(other.indexPredicates),
+        addressesByPredicate(other.addressesByPredicate) {
+            const AddressIndex& idx = container.get<impl::AddressTag>();
+            byAddress.rebuild(idx.begin(), idx.end());
+            rebuildTextIndex();
+        }
+
+        /** \brief Assignment operator.
+         * @param other Other table.
+         * @return This table. */
+        OrdinaryAtomTable& operator=(const OrdinaryAtomTable& other) {
+            Table::operator=(other);
+            storeText = other.storeText;
+            indexPredicates = other.indexPredicates;
+            addressesByPredicate = other.addressesByPredicate;
+            const AddressIndex& idx = container.get<impl::AddressTag>();
+            byAddress.rebuild(idx.begin(), idx.end());
+            rebuildTextIndex();
+            return *this;
+        }
+
+        /** \brief Configures whether the textual representation of atoms is stored.
+         *
+         * The text of an atom can always be printed from its tuple (see RawPrinter);
+         * storing it only saves this work when printing and allows for OrdinaryAtomTable::getIDByString,
+         * but for large ground programs the text is often the largest part of an atom.
+         * If text is not stored, stored atoms have an empty OrdinaryAtom::text
+         * and atoms must be looked up by tuple.
+         * Only atoms stored afterwards are affected.
+         * @param store True to store text (default), false otherwise. */
+        inline void setStoreText(bool store) throw();
+
+        /** \brief Returns whether the textual representation of atoms is stored.
+         * @return See OrdinaryAtomTable::setStoreText. */
+        inline bool storesText() const throw()
+            { return storeText; }
+
         /** \brief Retrieve by ID.
          *
          * Assert that id.kind is correct for OrdinaryGroundAtom.
@@ -114,6 +181,9 @@ ID (Atom::*)() const,&Atom::front>
         inline ID getIDByAddress(IDAddress addr) const throw ();
 
         /** \brief Given string, look if already stored.
+         *
+         * Always fails if the table does not store text (see OrdinaryAtomTable::setStoreText),
+         * use OrdinaryAtomTable::getIDByTuple in code which must work in both cases.
          * @param text String representation of the ordinary atom to retrieve.
          * @return ID_FAIL if not stored, otherwise return ID. */
         inline ID getIDByString(const std::string& text) const throw();
@@ -161,6 +231,15 @@ ID (Atom::*)() const,&Atom::front>
          * @return Pair of begin and end iterator representing all atoms in the table. */
         inline std::pair<AddressIterator, AddressIterator>
             getAllByAddress() const throw();
+
+        /** \brief Get addresses of all atoms over a certain predicate which were stored after a given point.
+         *
+         * Hidden atoms are not reported.
+         * Requires that the table was constructed with indexPredicates set (as Registry::ogatoms).
+         * @param pred Address of the predicate term (the kind of the term is ignored).
+         * @param known Number of atoms over \p pred seen so far (0 initially); is increased by the number of reported atoms.
+         * @param addresses Addresses of the new atoms are appended to this vector in increasing order. */
+        inline void getAddressesByPredicate(IDAddress pred, std::size_t& known, std::vector<IDAddress>& addresses) const throw();
 };
 
 // retrieve by ID
@@ -172,11 +251,7 @@ ID id) const throw ()
 {
     assert(id.isAtom() || id.isLiteral());
     assert(id.isOrdinaryAtom());
-    ReadLock lock(mutex);
-    const AddressIndex& idx = container.get<impl::AddressTag>();
-    // the following check only works for random access indices, but here it is ok
-    assert( id.address < idx.size() );
-    return idx.at(id.address);
+    return getByAddress(id.address);
 }
 
 
@@ -186,6 +261,10 @@ const OrdinaryAtom&
 OrdinaryAtomTable::getByAddress(
 IDAddress addr) const throw ()
 {
+    // atoms are never modified after they were stored, hence no lock is required
+    if( addr < byAddress.size() )
+        return byAddress.get(addr);
+    // the atom was stored by another thread and is not yet visible in byAddress (synchronize via mutex)
     ReadLock lock(mutex);
     const AddressIndex& idx(container.get<impl::AddressTag>());
     // the following check only works for random access indices, but here it is ok
@@ -210,18 +289,16 @@ IDAddress addr) const throw ()
 ID OrdinaryAtomTable::getIDByString(
 const std::string& str) const throw()
 {
-    typedef Container::index<impl::TextTag>::type OrdinaryAtomIndex;
     ReadLock lock(mutex);
-    const TextIndex& sidx(container.get<impl::TextTag>());
-    TextIndex::const_iterator it(sidx.find(str));
-    if( it == sidx.end() )
+    boost::unordered_map<boost::string_ref, IDAddress, impl::SymbolHash>::const_iterator
+        it(addressByText.find(boost::string_ref(str)));
+    if( it == addressByText.end() )
         return ID_FAIL;
     else {
         const AddressIndex& aidx(container.get<impl::AddressTag>());
         return ID(
-            it->kind,            // kind
-                                 // address
-            container.project<impl::AddressTag>(it) - aidx.begin()
+            aidx[it->second].kind,   // kind
+            it->second           // address
             );
     }
 }
@@ -249,6 +326,27 @@ const Tuple& tuple) const throw()
 }
 
 
+// recreate the text index such that its keys refer to the atoms of this table
+void OrdinaryAtomTable::rebuildTextIndex()
+{
+    addressByText.clear();
+    const AddressIndex& idx = container.get<impl::AddressTag>();
+    IDAddress address = 0;
+    for(AddressIndex::const_iterator it = idx.begin(); it != idx.end(); ++it, ++address) {
+        if( !it->text.empty() )
+            addressByText[boost::string_ref(it->text)] = address;
+    }
+}
+
+
+// configure whether text is stored
+void OrdinaryAtomTable::setStoreText(bool store) throw()
+{
+    WriteLock lock(mutex);
+    storeText = store;
+}
+
+
 // get ID given storage retrieved by other means
 // (storage must have originated from iterator from here)
 ID OrdinaryAtomTable::getIDByStorage(
@@ -290,7 +388,7 @@ const OrdinaryAtom& atm) throw()
 {
     assert(ID(atm.kind,0).isAtom());
     assert(ID(atm.kind,0).isOrdinaryAtom());
-    assert(!atm.text.empty());
+    assert(!storeText || !atm.text.empty());
     assert(!(
         (atm.tuple.front().kind & ID::PROPERTY_AUX) != 0 &&
         (atm.kind & ID::PROPERTY_AUX) == 0 ) &&
@@ -301,14 +399,28 @@ const OrdinaryAtom& atm) throw()
 
     WriteLock lock(mutex);
     AddressIndex& idx(container.get<impl::AddressTag>());
-    boost::tie(it, success) = idx.push_back(atm);
+    if( storeText ) {
+        boost::tie(it, success) = idx.push_back(atm);
+    }
+    else {
+        // store the atom without its text
+        OrdinaryAtom stored(atm.kind);
+        stored.tuple = atm.tuple;
+        boost::tie(it, success) = idx.push_back(stored);
+    }
     (void)success;
     assert(success);
+    byAddress.push_back(*it);
+
+    const IDAddress address = container.project<impl::AddressTag>(it) - idx.begin();
+    if( storeText )
+        addressByText[boost::string_ref(it->text)] = address;
+    if( indexPredicates && (atm.kind & ID::PROPERTY_ATOM_HIDDEN) == 0 )
+        addressesByPredicate[atm.tuple.front().address].push_back(address);
 
     return ID(
         atm.kind,                // kind
-                                 // address
-        container.project<impl::AddressTag>(it) - idx.begin()
+        address                  // address
         );
 }
 
@@ -337,6 +449,23 @@ OrdinaryAtomTable::getAllByAddress() const throw()
 }
 
 
+// get addresses of new atoms over a predicate
+void OrdinaryAtomTable::getAddressesByPredicate(
+IDAddress pred, std::size_t& known, std::vector<IDAddress>& addresses) const throw()
+{
+    assert(indexPredicates);
+    ReadLock lock(mutex);
+    boost::unordered_map<IDAddress, std::vector<IDAddress> >::const_iterator it =
+        addressesByPredicate.find(pred);
+    if( it == addressesByPredicate.end() )
+        return;
+    const std::vector<IDAddress>& all = it->second;
+    assert(known <= all.size());
+    addresses.insert(addresses.end(), all.begin() + known, all.end());
+    known = all.size();
+}
+
+
 DLVHEX_NAMESPACE_END
 #endif                           // ORDINARYATOMTABLE_HPP_INCLUDED__12102010
 
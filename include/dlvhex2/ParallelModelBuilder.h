@@ -0,0 +1,629 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   ParallelModelBuilder.h
+ *
+ * @brief  Online model building where model generators compute models ahead in other threads.
+ */
+
+#ifndef PARALLEL_MODEL_BUILDER_HPP_INCLUDED__18102026
+#define PARALLEL_MODEL_BUILDER_HPP_INCLUDED__18102026
+
+#include "dlvhex2/PlatformDefinitions.h"
+#include "dlvhex2/Logger.h"
+#include "dlvhex2/Error.h"
+#include "dlvhex2/ModelGenerator.h"
+#include "dlvhex2/OnlineModelBuilder.h"
+#include "dlvhex2/ConcurrentMessageQueueOwning.h"
+
+#include <boost/bind.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <deque>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/** \brief Captures the exception which is currently handled such that another thread can rethrow it.
+ *
+ * Must be called in a catch block. Exceptions of the dlvhex error hierarchy are rethrown
+ * with their most derived type among GeneralError, SyntaxError, FatalError, PluginError and UsageError;
+ * other exceptions are captured with boost::current_exception.
+ * @return Pointer to a copy of the current exception. */
+DLVHEX_EXPORT boost::exception_ptr captureModelGeneratorException();
+
+/** \brief Fixed set of worker threads executing submitted tasks in FIFO order. */
+class DLVHEX_EXPORT ModelBuildingThreadPool
+{
+    public:
+        typedef boost::function<void ()> Task;
+
+        /** \brief Constructor.
+         * @param threads Number of worker threads, 0 for one thread per hardware thread. */
+        ModelBuildingThreadPool(unsigned threads);
+        /** \brief Destructor; drops pending tasks and joins all workers after their current task. */
+        ~ModelBuildingThreadPool();
+
+        /** \brief Enqueues a task for one of the workers.
+         * @param task Task to execute; it must not throw. */
+        void submit(const Task& task);
+
+        /** \brief Returns the number of worker threads.
+         * @return Number of worker threads. */
+        unsigned size() const { return threads; }
+
+    protected:
+        /** \brief Main loop of a worker thread. */
+        void worker();
+
+        /** \brief Number of worker threads. */
+        unsigned threads;
+        /** \brief Pending tasks. */
+        std::deque<Task> tasks;
+        /** \brief True if workers shall terminate. */
+        bool shutdown;
+        /** \brief Protects tasks and shutdown. */
+        boost::mutex mutex;
+        /** \brief Signals new tasks and shutdown to the workers. */
+        boost::condition_variable taskAvailable;
+        /** \brief The worker threads. */
+        boost::thread_group workers;
+
+    private:
+        ModelBuildingThreadPool(const ModelBuildingThreadPool&);
+        ModelBuildingThreadPool& operator=(const ModelBuildingThreadPool&);
+};
+
+/** \brief Wraps the model generator of a unit such that models are computed ahead in a bounded buffer.
+ *
+ * The wrapped model generator is created lazily, so grounding also happens on the thread pool.
+ * Whenever the consumer takes a model out of the buffer, computation of further models
+ * is scheduled on the thread pool until the buffer is full or all models have been computed.
+ * If the consumer needs a model which is not yet available and no worker is busy with this
+ * generator, it computes the model itself; hence the pool cannot stall the consumer.
+ * Models are always returned in the order in which the wrapped generator produces them. */
+template<typename InterpretationT>
+class BufferedModelGenerator:
+public ModelGeneratorBase<InterpretationT>
+{
+    // types
+    public:
+        typedef ModelGeneratorBase<InterpretationT> Base;
+        typedef typename Base::InterpretationConstPtr InterpretationConstPtr;
+        typedef typename Base::InterpretationPtr InterpretationPtr;
+        typedef typename Base::Ptr ModelGeneratorPtr;
+        typedef typename ModelGeneratorFactoryBase<InterpretationT>::Ptr ModelGeneratorFactoryPtr;
+
+    protected:
+        /** \brief State shared between the consumer and the worker computing models ahead. */
+        struct Job
+        {
+            enum State
+            {
+                /** \brief Nobody computes models. */
+                IDLE,
+                /** \brief Computation of models is waiting in the thread pool. */
+                QUEUED,
+                /** \brief Some thread currently computes models. */
+                RUNNING
+            };
+
+            /** \brief Factory for the wrapped model generator. */
+            ModelGeneratorFactoryPtr factory;
+            /** \brief Input of the wrapped model generator. */
+            InterpretationConstPtr input;
+            /** \brief Wrapped model generator (created on first use). */
+            ModelGeneratorPtr generator;
+            /** \brief Maximum number of models computed ahead. */
+            unsigned capacity;
+            /** \brief Models computed but not yet consumed. */
+            std::deque<InterpretationPtr> buffer;
+            /** \brief See State. */
+            State state;
+            /** \brief True if the wrapped model generator has no further models. */
+            bool finished;
+            /** \brief True if the consumer is no longer interested in models. */
+            bool cancelled;
+            /** \brief Exception thrown by the wrapped model generator (empty if none). */
+            boost::exception_ptr error;
+            /** \brief Protects all of the above except factory, input and generator which are only accessed while RUNNING. */
+            boost::mutex mutex;
+            /** \brief Signalled whenever buffer, finished or state change. */
+            boost::condition_variable changed;
+
+            /** \brief Constructor.
+             * @param factory See Job::factory.
+             * @param input See Job::input.
+             * @param capacity See Job::capacity. */
+            Job(ModelGeneratorFactoryPtr factory, InterpretationConstPtr input, unsigned capacity):
+            factory(factory), input(input), generator(), capacity(capacity),
+                buffer(), state(IDLE), finished(false), cancelled(false), error() {}
+
+            /** \brief Computes models until the buffer holds \p limit models or the job is cancelled; must be called in state RUNNING.
+             * @param limit Number of buffered models after which to stop. */
+            void produce(unsigned limit);
+
+            /** \brief Entry point of the thread pool, computes models if the job is still QUEUED.
+             * @param job The job. */
+            static void runQueued(boost::shared_ptr<Job> job);
+        };
+        typedef boost::shared_ptr<Job> JobPtr;
+
+        // members
+    protected:
+        /** \brief Shared state (also referenced by pending pool tasks). */
+        JobPtr job;
+        /** \brief Thread pool where models are computed ahead. */
+        ModelBuildingThreadPool& pool;
+
+        /** \brief Schedules computation of further models on the pool if nobody works on the job.
+         * @param lock Lock of Job::mutex held by the caller. */
+        void scheduleAhead(boost::mutex::scoped_lock& lock);
+
+        // methods
+    public:
+        /** \brief Constructor.
+         * @param factory Factory of the wrapped model generator.
+         * @param input Input interpretation.
+         * @param pool Thread pool to use.
+         * @param capacity Maximum number of models computed ahead (at least 1). */
+        BufferedModelGenerator(
+            ModelGeneratorFactoryPtr factory, InterpretationConstPtr input,
+            ModelBuildingThreadPool& pool, unsigned capacity):
+        Base(input),
+            job(new Job(factory, input, capacity)),
+        pool(pool) {
+            boost::mutex::scoped_lock lock(job->mutex);
+            scheduleAhead(lock);
+        }
+        /** \brief Destructor; cancels the job.
+         *
+         * Waits until a worker which is currently computing a model has finished this model,
+         * such that no other model generator of the same factory runs concurrently with it. */
+        virtual ~BufferedModelGenerator();
+
+        virtual InterpretationPtr generateNextModel();
+
+        /** \brief Returns the inconsistency cause of the wrapped model generator once it is finished.
+         * @return See ModelGeneratorBase::getInconsistencyCause. */
+        virtual const Nogood* getInconsistencyCause();
+
+        virtual std::ostream& print(std::ostream& o) const
+            { return o << "BufferedModelGenerator(capacity=" << job->capacity << ")"; }
+};
+
+/** \brief Online model builder whose model generators compute models ahead on a thread pool.
+ *
+ * Model building itself (traversing the eval and model graph) happens in the calling thread
+ * exactly as in OnlineModelBuilder, hence models are enumerated in the same (deterministic) order.
+ * While the caller processes models of some unit, the model generators of other units
+ * (predecessors as well as sibling units) keep computing their next models in the background.
+ * Before a join waits for its first predecessor, the model generators of all predecessors
+ * whose input is available are started, so independent branches compute their first models concurrently.
+ *
+ * Destroying a model generator waits until a worker which computes a model for it has finished
+ * this model; hence at most one model generator created by some factory is active at any time,
+ * as model generator factories and their model generators share unsynchronized state.
+ *
+ * Cannot be combined with TransUnitLearning, which adds nogoods to model generators of
+ * predecessor units which might be running concurrently. */
+template<typename EvalGraphT>
+class ParallelModelBuilder:
+public OnlineModelBuilder<EvalGraphT>
+{
+    // types
+    public:
+        typedef OnlineModelBuilder<EvalGraphT>
+            Base;
+        typedef ParallelModelBuilder<EvalGraphT>
+            Self;
+
+        typedef typename Base::EvalUnit
+            EvalUnit;
+        typedef typename Base::Interpretation
+            Interpretation;
+
+        using Base::eg;
+        using Base::mbp;
+
+        // members
+    protected:
+        /** \brief Workers for all units. */
+        ModelBuildingThreadPool pool;
+        /** \brief Maximum number of models computed ahead per unit. */
+        unsigned bufferSize;
+
+        // methods
+    public:
+        /** \brief Constructor.
+         * @param cfg Configuration. */
+        ParallelModelBuilder(ModelBuilderConfig<EvalGraphT>& cfg):
+        Base(cfg),
+            pool(cfg.parallelThreads),
+        bufferSize(cfg.modelBufferSize > 0 ? cfg.modelBufferSize : 1) {
+            Base::startGeneratorsEarly = true;
+            LOG(INFO,"parallel model building with " << pool.size() << " threads and model buffers of size " << bufferSize);
+        }
+
+        /** \brief Destructor. */
+        virtual ~ParallelModelBuilder() {
+            // stop all model generators before the pool is gone
+            typename EvalGraphT::EvalUnitIterator it, end;
+            for(boost::tie(it, end) = eg.getEvalUnits(); it != end; ++it) {
+                mbp[*it].currentmg.reset();
+            }
+        }
+
+    protected:
+        virtual typename ModelGeneratorBase<Interpretation>::Ptr
+        createModelGenerator(EvalUnit u, typename Interpretation::ConstPtr input) {
+            return typename ModelGeneratorBase<Interpretation>::Ptr(
+                new BufferedModelGenerator<Interpretation>(eg.propsOf(u).mgf, input, pool, bufferSize));
+        }
+};
+
+/** \brief Runs a model generator in a dedicated thread which streams its models into a bounded queue.
+ *
+ * The producer thread blocks as soon as the queue is full, so the queue capacity
+ * limits how far the producer runs ahead of the consumer.
+ *
+ * Model generators cannot be interrupted while they compute a model, hence destroying
+ * a PipelinedModelGenerator waits until the producer has finished the model it is
+ * currently computing (but it does not compute further models). This happens whenever
+ * the model builder moves to the next input of a unit before all models were consumed,
+ * e.g., if the number of requested models is limited. */
+template<typename InterpretationT>
+class PipelinedModelGenerator:
+public ModelGeneratorBase<InterpretationT>
+{
+    // types
+    public:
+        typedef ModelGeneratorBase<InterpretationT> Base;
+        typedef typename Base::InterpretationConstPtr InterpretationConstPtr;
+        typedef typename Base::InterpretationPtr InterpretationPtr;
+        typedef typename Base::Ptr ModelGeneratorPtr;
+        typedef typename ModelGeneratorFactoryBase<InterpretationT>::Ptr ModelGeneratorFactoryPtr;
+
+    protected:
+        /** \brief Element of the model queue; a NULL model without error marks the end of the models. */
+        struct ModelMessage
+        {
+            /** \brief Model or NULL. */
+            InterpretationPtr model;
+            /** \brief Exception thrown by the model generator (empty if none). */
+            boost::exception_ptr error;
+            /** \brief Constructor.
+             * @param model See ModelMessage::model.
+             * @param error See ModelMessage::error. */
+            ModelMessage(InterpretationPtr model, boost::exception_ptr error = boost::exception_ptr()):
+            model(model), error(error) {}
+        };
+        typedef boost::shared_ptr<ModelMessage> ModelMessagePtr;
+
+        // members
+    protected:
+        /** \brief Factory for the model generator (used by the producer thread). */
+        ModelGeneratorFactoryPtr factory;
+        /** \brief Models produced but not yet consumed. */
+        ConcurrentMessageQueueOwning<ModelMessage> queue;
+        /** \brief True if the consumer is no longer interested in models. */
+        bool cancelled;
+        /** \brief True if the end of the models has been received. */
+        bool finished;
+        /** \brief Protects cancelled. */
+        boost::mutex mutex;
+        /** \brief Producer thread. */
+        boost::thread producer;
+
+        /** \brief Main loop of the producer thread. */
+        void produce();
+
+        // methods
+    public:
+        /** \brief Constructor.
+         * @param factory Factory of the model generator.
+         * @param input Input interpretation.
+         * @param capacity Capacity of the model queue. */
+        PipelinedModelGenerator(
+            ModelGeneratorFactoryPtr factory, InterpretationConstPtr input,
+            unsigned capacity):
+        Base(input),
+            factory(factory),
+            queue(capacity),
+            cancelled(false),
+            finished(false),
+        producer(boost::bind(&PipelinedModelGenerator<InterpretationT>::produce, this)) {}
+        /** \brief Destructor; stops and joins the producer thread.
+         *
+         * Waits until the producer has finished the model it is currently computing. */
+        virtual ~PipelinedModelGenerator();
+
+        virtual InterpretationPtr generateNextModel();
+
+        virtual std::ostream& print(std::ostream& o) const
+            { return o << "PipelinedModelGenerator"; }
+};
+
+/** \brief Online model builder whose model generators stream their models through bounded queues.
+ *
+ * Each running model generator of a unit has its own thread which enumerates the models
+ * of the unit for the current input model and pushes them into a queue of size
+ * ModelBuilderConfig::modelQueueSize; successor units start working on the first
+ * models while their predecessors are still enumerating. As with ParallelModelBuilder,
+ * model graph traversal happens in the calling thread and models are enumerated in the
+ * same order as with OnlineModelBuilder. Abandoning a model generator waits for the model
+ * it is computing (see PipelinedModelGenerator). Cannot be combined with TransUnitLearning. */
+template<typename EvalGraphT>
+class PipelinedModelBuilder:
+public OnlineModelBuilder<EvalGraphT>
+{
+    // types
+    public:
+        typedef OnlineModelBuilder<EvalGraphT>
+            Base;
+        typedef PipelinedModelBuilder<EvalGraphT>
+            Self;
+
+        typedef typename Base::EvalUnit
+            EvalUnit;
+        typedef typename Base::Interpretation
+            Interpretation;
+
+        using Base::eg;
+        using Base::mbp;
+
+        // members
+    protected:
+        /** \brief Capacity of the model queue of each unit. */
+        unsigned queueSize;
+
+        // methods
+    public:
+        /** \brief Constructor.
+         * @param cfg Configuration. */
+        PipelinedModelBuilder(ModelBuilderConfig<EvalGraphT>& cfg):
+        Base(cfg),
+        queueSize(cfg.modelQueueSize > 0 ? cfg.modelQueueSize : 1) {
+            Base::startGeneratorsEarly = true;
+            LOG(INFO,"pipelined model building with model queues of size " << queueSize);
+        }
+
+        /** \brief Destructor. */
+        virtual ~PipelinedModelBuilder() {
+            // stop all producer threads while the eval graph is still there
+            typename EvalGraphT::EvalUnitIterator it, end;
+            for(boost::tie(it, end) = eg.getEvalUnits(); it != end; ++it) {
+                mbp[*it].currentmg.reset();
+            }
+        }
+
+    protected:
+        virtual typename ModelGeneratorBase<Interpretation>::Ptr
+        createModelGenerator(EvalUnit u, typename Interpretation::ConstPtr input) {
+            return typename ModelGeneratorBase<Interpretation>::Ptr(
+                new PipelinedModelGenerator<Interpretation>(eg.propsOf(u).mgf, input, queueSize));
+        }
+};
+
+// impl
+
+template<typename InterpretationT>
+void BufferedModelGenerator<InterpretationT>::Job::produce(unsigned limit)
+{
+    boost::exception_ptr failure;
+    try
+    {
+        for(;;) {
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                assert(state == RUNNING);
+                if( cancelled || finished || buffer.size() >= limit ) {
+                    state = IDLE;
+                    changed.notify_all();
+                    return;
+                }
+            }
+
+            if( !generator ) {
+                DBGLOG(DBG,"creating wrapped model generator");
+                generator = factory->createModelGenerator(input);
+            }
+            InterpretationPtr intp = generator->generateNextModel();
+
+            boost::mutex::scoped_lock lock(mutex);
+            if( intp )
+                buffer.push_back(intp);
+            else
+                finished = true;
+            changed.notify_all();
+        }
+    }
+    catch(...) {
+        failure = captureModelGeneratorException();
+    }
+
+    boost::mutex::scoped_lock lock(mutex);
+    error = failure;
+    finished = true;
+    state = IDLE;
+    changed.notify_all();
+}
+
+
+template<typename InterpretationT>
+void BufferedModelGenerator<InterpretationT>::Job::runQueued(boost::shared_ptr<Job> job)
+{
+    {
+        boost::mutex::scoped_lock lock(job->mutex);
+        // the consumer may have taken over or cancelled the job in the meantime
+        if( job->state != QUEUED )
+            return;
+        job->state = RUNNING;
+    }
+    job->produce(job->capacity);
+}
+
+
+template<typename InterpretationT>
+void BufferedModelGenerator<InterpretationT>::scheduleAhead(boost::mutex::scoped_lock& lock)
+{
+    if( job->state == Job::IDLE && !job->finished && !job->cancelled &&
+    job->buffer.size() < job->capacity ) {
+        job->state = Job::QUEUED;
+        pool.submit(boost::bind(&Job::runQueued, job));
+    }
+}
+
+
+template<typename InterpretationT>
+BufferedModelGenerator<InterpretationT>::~BufferedModelGenerator()
+{
+    boost::mutex::scoped_lock lock(job->mutex);
+    job->cancelled = true;
+    job->buffer.clear();
+    // a running worker stops after its current model, a pending pool task will see
+    // that the job is cancelled; the builder may create a new model generator from
+    // the same factory as soon as we return, hence the old one must be idle by then
+    while( job->state == Job::RUNNING )
+        job->changed.wait(lock);
+    job->state = Job::IDLE;
+    job->generator.reset();
+}
+
+
+template<typename InterpretationT>
+typename BufferedModelGenerator<InterpretationT>::InterpretationPtr
+BufferedModelGenerator<InterpretationT>::generateNextModel()
+{
+    boost::mutex::scoped_lock lock(job->mutex);
+    for(;;) {
+        if( !job->buffer.empty() ) {
+            InterpretationPtr intp = job->buffer.front();
+            job->buffer.pop_front();
+            scheduleAhead(lock);
+            return intp;
+        }
+        if( job->error )
+            boost::rethrow_exception(job->error);
+        if( job->finished )
+            return InterpretationPtr();
+
+        if( job->state == Job::RUNNING ) {
+            job->changed.wait(lock);
+        }
+        else {
+            // nobody works on this job yet: compute the next model ourselves
+            job->state = Job::RUNNING;
+            lock.unlock();
+            job->produce(1);
+            lock.lock();
+        }
+    }
+}
+
+
+template<typename InterpretationT>
+const Nogood* BufferedModelGenerator<InterpretationT>::getInconsistencyCause()
+{
+    boost::mutex::scoped_lock lock(job->mutex);
+    if( job->finished && job->state != Job::RUNNING && !!job->generator )
+        return job->generator->getInconsistencyCause();
+    return 0;
+}
+
+
+template<typename InterpretationT>
+void PipelinedModelGenerator<InterpretationT>::produce()
+{
+    boost::exception_ptr failure;
+    try
+    {
+        ModelGeneratorPtr generator = factory->createModelGenerator(this->input);
+        for(;;) {
+            {
+                boost::mutex::scoped_lock lock(mutex);
+                if( cancelled )
+                    return;
+            }
+            InterpretationPtr intp = generator->generateNextModel();
+            // blocks while the queue is full (backpressure)
+            queue.send(ModelMessagePtr(new ModelMessage(intp)), 0);
+            if( !intp )
+                return;
+        }
+    }
+    catch(...) {
+        failure = captureModelGeneratorException();
+    }
+    queue.send(ModelMessagePtr(new ModelMessage(InterpretationPtr(), failure)), 0);
+}
+
+
+template<typename InterpretationT>
+PipelinedModelGenerator<InterpretationT>::~PipelinedModelGenerator()
+{
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        cancelled = true;
+    }
+    // only the producer adds to the queue, so after emptying it the producer
+    // can send at most one more message without blocking and then sees cancelled
+    queue.flush();
+    producer.join();
+}
+
+
+template<typename InterpretationT>
+typename PipelinedModelGenerator<InterpretationT>::InterpretationPtr
+PipelinedModelGenerator<InterpretationT>::generateNextModel()
+{
+    if( finished )
+        return InterpretationPtr();
+
+    ModelMessagePtr msg;
+    unsigned int prio;
+    queue.receive(msg, prio);
+    assert(!!msg);
+    if( !msg->model ) {
+        finished = true;
+        if( msg->error )
+            boost::rethrow_exception(msg->error);
+    }
+    return msg->model;
+}
+
+
+DLVHEX_NAMESPACE_END
+#endif                           // PARALLEL_MODEL_BUILDER_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
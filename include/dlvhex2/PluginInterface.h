@@ -958,7 +958,8 @@ class DLVHEX_EXPORT PluginAtom
          */
         PluginAtom(const std::string& predicate, bool monotonic):
         predicate(predicate),
-        allmonotonic(monotonic) {
+        allmonotonic(monotonic),
+        threadSafe(false) {
             prop.pa = this;
         }
 
@@ -999,7 +1000,50 @@ class DLVHEX_EXPORT PluginAtom
          */
         void setOutputArity(unsigned arity);
 
+        /**
+         * \brief Declares whether the external atom may be evaluated concurrently.
+         *
+         * Only use in constructor!
+         *
+         * Parallel and pipelined model builders evaluate external atoms in several threads.
+         * Unless an atom is declared thread-safe, its evaluation is serialized with the
+         * evaluation of all other atoms which are not thread-safe (see EvaluationLock).
+         * Declare an atom thread-safe only if retrieve, learnSupportSets and checkCompliance
+         * may run concurrently with each other and with these methods of other atoms of the plugin.
+         *
+         * @param threadSafe True if the atom is thread-safe, false (default) otherwise.
+         */
+        void setThreadSafe(bool threadSafe);
+
     public:
+        /**
+         * \brief Serializes the evaluation of external atoms which are not thread-safe.
+         *
+         * While an EvaluationLock exists, no other thread evaluates an atom which is not
+         * thread-safe. The lock is recursive, i.e., evaluating external atoms from within
+         * an external atom (e.g. in a subprogram) in the same thread does not block.
+         */
+        class DLVHEX_EXPORT EvaluationLock
+        {
+            public:
+                /**
+                 * \brief Acquires the lock unless the atom is thread-safe.
+                 * @param atom External atom which is going to be evaluated.
+                 */
+                EvaluationLock(const PluginAtom& atom);
+                /**
+                 * \brief Releases the lock.
+                 */
+                ~EvaluationLock();
+
+            private:
+                /** \brief True if the lock was acquired. */
+                bool locked;
+
+                EvaluationLock(const EvaluationLock&);
+                EvaluationLock& operator=(const EvaluationLock&);
+        };
+
         /**
          * \brief Destructor.
          */
@@ -1303,6 +1347,13 @@ class DLVHEX_EXPORT PluginAtom
         /** \brief Returns a mask of all positive replacement atoms which are currently in the registry and match with this PluginAtom. */
         PredicateMaskPtr getReplacements(){ replacements->updateMask(); return replacements; }
 
+        /**
+         * \brief Checks if the atom may be evaluated concurrently (see setThreadSafe).
+         * @return True if the atom is thread-safe.
+         */
+        bool isThreadSafe() const
+            { return threadSafe; }
+
         /**
          * \brief Erase all elements from queryAnswerNogoodCache.
          */
@@ -1325,6 +1376,9 @@ class DLVHEX_EXPORT PluginAtom
         /** \brief Whether the function is monotonic in all parameters (this will automatically declare all predicate input parameters as monotonic, see PluginAtom::prop). */
         bool allmonotonic;
 
+        /** \brief Whether the atom may be evaluated concurrently (see setThreadSafe). */
+        bool threadSafe;
+
         /** \brief General properties of the external source (may be overridden on atom-level). */
         ExtSourceProperties prop;
 
@@ -41,6 +41,7 @@
 
 #include <boost/thread/mutex.hpp>
 
+#include <map>
 #include <set>
 
 DLVHEX_NAMESPACE_BEGIN
@@ -77,7 +78,7 @@ class DLVHEX_EXPORT PredicateMask
 
         /** \brief Add apredicate.
          *
-         * Incrementally updates mask for new pred up to known address of other preds (does not update mask for other preds!).
+         * The atoms over \p pred are added to the mask by the next call of PredicateMask::updateMask.
          * @param pred Predicate to add.
          */
         void addPredicate(ID pred);
@@ -91,13 +92,14 @@ class DLVHEX_EXPORT PredicateMask
             { return maski; }
 
     protected:
-        /** \brief Addresses of IDs of all relevant input predicates for this eatom.
+        /** \brief Addresses of IDs of all relevant input predicates for this eatom,
+         * each with the number of its atoms already in the mask (see OrdinaryAtomTable::getAddressesByPredicate).
          *
          * The corresponding IDKinds are ID::MAINKIND_TERM | ID::SUBKIND_CONSTANT_TERM with maybe auxiliary bit set. */
-        std::set<IDAddress> predicates;
+        std::map<IDAddress, std::size_t> predicates;
         /** \brief Bitset interpretation for masking inputs. */
         mutable InterpretationPtr maski;
-        /** \brief Address of the last ogatom already inspected for updating mask. */
+        /** \brief Size of ogatoms at the last update of the mask (0 forces the next update). */
         mutable IDAddress knownAddresses;
 
         /** \brief Mutex for multithreading access. */
@@ -60,7 +60,8 @@ boost::multi_index::tag<impl::AddressTag>
 // unique IDs for unique symbol strings
 boost::multi_index::hashed_unique<
 boost::multi_index::tag<impl::PredicateNameTag>,
-BOOST_MULTI_INDEX_MEMBER(Predicate,std::string,symbol)
+BOOST_MULTI_INDEX_MEMBER(Predicate,std::string,symbol),
+impl::SymbolHash
 >
 >
 // WARNING: do not put an index on arity, it might be changed (see below)
@@ -92,6 +93,12 @@ BOOST_MULTI_INDEX_MEMBER(Predicate,std::string,symbol)
          * @return Return ID_FAIL if \p str is not stored as a predicate, otherwise return ID. */
         inline ID getIDByString(const std::string& str) const throw();
 
+        /** Given a symbol and its hash, look if already stored.
+         * @param symbol String representation of a predicate.
+         * @param hash Hash of \p symbol (see TermTable::hashSymbol).
+         * @return Return ID_FAIL if \p symbol is not stored as a predicate, otherwise return ID. */
+        inline ID getIDBySymbol(boost::string_ref symbol, std::size_t hash) const throw();
+
         /** \brief Get the Predicate by predicate name.
          * @param str String representation of a predicate.
          * @return Predicate corresponding to \p str. */
@@ -153,9 +160,17 @@ void PredicateTable::setArity(ID id, int arity)
 // if no, return ID_FAIL, otherwise return ID
 ID PredicateTable::getIDByString(const std::string& str) const throw()
 {
+    return getIDBySymbol(str, impl::SymbolHash()(str));
+}
+
+
+ID PredicateTable::getIDBySymbol(boost::string_ref symbol, std::size_t hash) const throw()
+{
+    assert(hash == impl::SymbolHash()(symbol));
     ReadLock lock(mutex);
     const PredicateNameIndex& sidx = container.get<impl::PredicateNameTag>();
-    PredicateNameIndex::const_iterator it = sidx.find(str);
+    // the index uses impl::SymbolHash, hence we can use the given hash
+    PredicateNameIndex::const_iterator it = sidx.find(symbol, impl::ConstantHash(hash), impl::SymbolEqual());
     if( it == sidx.end() )
         return ID_FAIL;
     else {
@@ -0,0 +1,125 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   PreparedSubprogram.h
+ *
+ * @brief  Subprogram which is analysed once and evaluated under many sets of facts.
+ */
+
+#ifndef PREPAREDSUBPROGRAM_HPP_INCLUDED__18102026
+#define PREPAREDSUBPROGRAM_HPP_INCLUDED__18102026
+
+#include "dlvhex2/PlatformDefinitions.h"
+#include "dlvhex2/fwd.h"
+#include "dlvhex2/ID.h"
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/Configuration.h"
+
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <deque>
+#include <vector>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/**
+ * \brief A set of rules whose evaluation graph is built once and reused for many sets of facts.
+ *
+ * ProgramCtx::evaluateSubprogram analyses the rules (rewriting, safety checks,
+ * dependency, component and evaluation graph) for each call.
+ * If the same rules are evaluated many times with different facts
+ * (e.g. by external atoms which call nested HEX programs),
+ * a PreparedSubprogram does the analysis only once and keeps the evaluation graph together with
+ * the model generator factories, including what they have cached or learned in earlier evaluations.
+ *
+ * For this to be possible the analysis must not depend on the facts:
+ * plugin optimizers of the dependency graph (which use the EDB) are not applied,
+ * and the facts must be ground atoms which are already in the registry
+ * (plugin rewriters see only the rules).
+ *
+ * Results are memoized by the set of facts, thus evaluating the same facts again
+ * does not invoke the model builder at all. If the memo is full, the oldest result is dropped.
+ */
+class DLVHEX_EXPORT PreparedSubprogram
+{
+    public:
+        /**
+         * \brief Analyses the rules of a subprogram.
+         * @param ctx Program context whose registry, plugins and configuration are used.
+         * @param idb Rules of the subprogram.
+         * @param memoSize Maximum number of memoized results; 0 disables memoization.
+         */
+        PreparedSubprogram(const ProgramCtx& ctx, const std::vector<ID>& idb, unsigned memoSize = 1000);
+        /** \brief Destructor. */
+        ~PreparedSubprogram();
+
+        /**
+         * \brief Evaluates the subprogram under a set of facts.
+         *
+         * Concurrent calls are serialized.
+         * @param edb Facts of the subprogram.
+         * @return Answer sets of the subprogram; the caller may modify them.
+         */
+        std::vector<InterpretationPtr> evaluate(InterpretationConstPtr edb);
+
+    protected:
+        /** \brief Memoized result for one set of facts. */
+        struct MemoEntry
+        {
+            /** \brief Facts. */
+            InterpretationConstPtr edb;
+            /** \brief Answer sets under PreparedSubprogram::MemoEntry::edb. */
+            std::vector<InterpretationPtr> answersets;
+        };
+        /** \brief Memoized results indexed by hash of the facts. */
+        typedef boost::unordered_multimap<std::size_t, MemoEntry> Memo;
+
+        /** \brief Program context holding the evaluation graph; model generator factories refer to it. */
+        boost::scoped_ptr<ProgramCtx> pc;
+        /** \brief Facts added by plugin rewriters during preparation. */
+        InterpretationConstPtr baseEdb;
+        /** \brief Configuration after preparation (evaluation may change it, e.g. for optimization). */
+        Configuration preparedConfig;
+        /** \brief See PreparedSubprogram::PreparedSubprogram. */
+        unsigned memoSize;
+        /** \brief Memoized results. */
+        Memo memo;
+        /** \brief Hashes and facts of the memoized results in the order of their insertion. */
+        std::deque<std::pair<std::size_t, InterpretationConstPtr> > memoOrder;
+        /** \brief Serializes evaluations. */
+        boost::mutex mutex;
+};
+
+DLVHEX_NAMESPACE_END
+#endif                           // PREPAREDSUBPROGRAM_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
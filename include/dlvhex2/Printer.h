@@ -82,6 +82,9 @@ public Printer
 {
     private:
         std::string removeModulePrefix(const std::string& text);
+        /** \brief Prints an ordinary atom, using its text if it was stored (see OrdinaryAtomTable::setStoreText).
+         * @param atom Atom to print. */
+        void printOrdinaryAtom(const OrdinaryAtom& atom);
     public:
         /** \brief Constructor.
          * @param out See Printer::out.
@@ -0,0 +1,76 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   ProfilingEvalGraphBuilder.h
+ *
+ * @brief  Evaluation Graph builder that records per-unit metrics during evaluation.
+ */
+
+#ifndef PROFILING_EVAL_GRAPH_BUILDER_HPP_INCLUDED__18102026
+#define PROFILING_EVAL_GRAPH_BUILDER_HPP_INCLUDED__18102026
+
+#include "dlvhex2/EvalGraphBuilder.h"
+#include "dlvhex2/EvalProfile.h"
+
+DLVHEX_NAMESPACE_BEGIN
+
+/** \brief Evaluation Graph builder that instruments all created units with an EvalProfile. */
+class ProfilingEvalGraphBuilder:
+public EvalGraphBuilder
+{
+    protected:
+        /** \brief Profile where the metrics of the units are recorded. */
+        EvalProfilePtr profile;
+
+        //////////////////////////////////////////////////////////////////////////////
+        // methods
+        //////////////////////////////////////////////////////////////////////////////
+    public:
+        /** \brief Constructor.
+         * @param ctx See EvalGraphBuilder::ctx.
+         * @param cg See EvalGraphBuilder::cg.
+         * @param eg Evaluation graph to write the result to.
+         * @param externalEvalConfig See ASPSolverManager::SoftwareConfiguration.
+         * @param profile Profile where the units are recorded. */
+        ProfilingEvalGraphBuilder(
+            ProgramCtx& ctx, ComponentGraph& cg, EvalGraphT& eg,
+            ASPSolverManager::SoftwareConfigurationPtr externalEvalConfig,
+            EvalProfilePtr profile);
+        /** \brief Destructor. */
+        virtual ~ProfilingEvalGraphBuilder();
+
+        // wrap the model generator factory of the unit for recording
+        virtual EvalUnit createEvalUnit(
+            const std::list<Component>& comps, const std::list<Component>& ccomps);
+};
+
+DLVHEX_NAMESPACE_END
+#endif
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -198,6 +198,8 @@ class DLVHEX_EXPORT ProgramCtx
         FinalEvalGraphPtr evalgraph;
         /** \brief Final unit in ProgramCtx::evalgraph. */
         FinalEvalGraph::EvalUnit ufinal;
+        /** \brief Metrics of the units of ProgramCtx::evalgraph if recorded (option --dumpevalprofile). */
+        EvalProfilePtr evalProfile;
         /** \brief Callbacks for models. */
         std::list<ModelCallbackPtr> modelCallbacks;
         /** \brief FinalCallback. */
@@ -354,6 +356,13 @@ class DLVHEX_EXPORT ProgramCtx
          * @param parse True to read the program from ProgramCtx::inputProvider (\p pc), false to read it from ProgramCtx::edb and ProgramCtx::idb (\p pc).
          * @return Set of answer sets of the subprorgram. */
         std::vector<InterpretationPtr> evaluateSubprogram(ProgramCtx& pc, bool parse);
+        /** \brief Runs the state pipeline of a subprogram up to and including ProgramCtx::setupProgramCtx.
+         *
+         * Afterwards \p pc is in EvaluateState and ProgramCtx::evaluate can be called.
+         * @param pc Program context of the subprogram (see ProgramCtx::evaluateSubprogram).
+         * @param parse True to read the program from ProgramCtx::inputProvider (\p pc), false to read it from ProgramCtx::edb and ProgramCtx::idb (\p pc).
+         * @param optimizeEDB False to skip plugin optimizers of the dependency graph; then the evaluation graph does not depend on ProgramCtx::edb (\p pc). */
+        void prepareSubprogram(ProgramCtx& pc, bool parse, bool optimizeEDB);
 
     protected:
         /** \brief Symbol storage of this program context.
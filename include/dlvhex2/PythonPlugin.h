@@ -220,6 +220,7 @@
  * <ul>
  *   <li>\code{.txt}tuple evaluateSubprogram(tup)\endcode Evaluates the subprogram specified by a tuple \code{.txt}facts, rules\endcode consisting of facts \em facts (tuple of IDs of ground atoms) and rules \em rules (tuple of rule IDs) and returns the number of answer sets; the result is a tuple of answer sets, where each answer set is again a tuple of the ground atom IDs which are true in the respective answer set.</li>
  *   <li>\code{.txt}tuple loadSubprogram(filename)\endcode Loads the program stored in file \em filename and returns a pair \code{.txt}(edb, idb)\endcode consisting of a tuple \em edb of facts (ground atom IDs) and a tuple \em idb of rule IDs.</li>
+ *   <li>\code{.txt}PreparedSubprogram prepareSubprogram(rules)\endcode Analyses the rules \em rules (tuple of rule IDs) once and returns an object whose method \code{.txt}tuple evaluate(facts)\endcode evaluates them under the facts \em facts (tuple of IDs of ground atoms) and returns the answer sets like \em evaluateSubprogram; results are memoized by the facts. Use this if the same rules are evaluated many times with different facts (cf. PreparedSubprogram).</li>
  * </ul>
  *
  * <b>External Source Properties Declaration</b><br/>
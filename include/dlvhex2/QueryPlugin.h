@@ -88,6 +88,11 @@ public PluginInterface
              * Positive witnesses for brave and negative for cautious reasoning. */
             bool allWitnesses;
 
+            /** \brief Whether to apply magic set rewriting to the program before evaluation.
+             *
+             * Restricts grounding and solving to the part of the program which is relevant for the query. */
+            bool magicSets;
+
             CtxData();
             virtual ~CtxData() {};
     };
@@ -101,7 +106,7 @@ public PluginInterface
         // output help message for this plugin
         virtual void printUsage(std::ostream& o) const;
 
-        // accepted options: --query-enable --query-brave --query-cautious
+        // accepted options: --query-enable --query-brave --query-cautious --query-all --query-magic
         //
         // processes options for this plugin, and removes recognized options from pluginOptions
         // (do not free the pointers, the const char* directly come from argv)
@@ -112,6 +117,7 @@ public PluginInterface
         virtual std::vector<HexParserModulePtr> createParserModules(ProgramCtx&);
 
         // rewrite program by adding auxiliary query rules
+        // (and optionally restrict it to the relevant part using magic sets)
         virtual PluginRewriterPtr createRewriter(ProgramCtx&);
 
         // change model callback and register final callback
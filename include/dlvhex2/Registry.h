@@ -98,7 +98,7 @@ public boost::enable_shared_from_this<Registry>
         TermTable terms;
         /** \brief Table of predicate terms. */
         PredicateTable preds;
-        /** \brief Table of ordinary ground atoms. */
+        /** \brief Table of ordinary ground atoms (indexed by predicate, see OrdinaryAtomTable::getAddressesByPredicate). */
         OrdinaryAtomTable ogatoms;
         /** \brief Table of ordinary nonground atoms. */
         OrdinaryAtomTable onatoms;
@@ -135,7 +135,7 @@ public boost::enable_shared_from_this<Registry>
          * Lookup by tuple, if does not exist create text and store as new atom
          * assume, that oatom.kind and oatom.tuple is initialized!
          * assume, that oatom.text is not initialized!
-         * oatom.text will be modified.
+         * oatom.text will be modified (it is only created if the table stores text, see OrdinaryAtomTable::setStoreText).
          *
          * The method can be used both for ground and nonground atoms.
          * @param ogatom Atom pattern.
@@ -148,7 +148,7 @@ public boost::enable_shared_from_this<Registry>
          * Lookup by tuple, if does not exist create text and store as new ground atom
          * assume, that oatom.kind and oatom.tuple is initialized!
          * assume, that oatom.text is not initialized!
-         * oatom.text will be modified.
+         * oatom.text will be modified (it is only created if the table stores text, see OrdinaryAtomTable::setStoreText).
          * @param ogatom Atom pattern.
          * @return ID of \p ogatom.
          */
@@ -159,7 +159,7 @@ public boost::enable_shared_from_this<Registry>
          * Lookup by tuple, if does not exist create text and store as new nonground atom
          * assume, that oatom.kind and oatom.tuple is initialized!
          * assume, that oatom.text is not initialized!
-         * oatom.text will be modified.
+         * oatom.text will be modified (it is only created if the table stores text, see OrdinaryAtomTable::setStoreText).
          * @param onatom Atom pattern.
          * @return ID of \p onatom.
          */
@@ -182,11 +182,17 @@ public boost::enable_shared_from_this<Registry>
          * Assert symbol is constant
          * lookup symbol and return ID if exists
          * otherwise register as constant and return ID.
+         * The symbol is hashed only once for all lookups and is only copied if it is stored.
          * @param symbol String to store in a term.
          * @param aux Defines whether to mark the new term as auxiliary or not.
          * @return ID of the stored term.
          */
+        ID storeConstantTerm(boost::string_ref symbol, bool aux=false);
+        /** \brief See storeConstantTerm(boost::string_ref, bool) (kept for plugins built against std::string). */
         ID storeConstantTerm(const std::string& symbol, bool aux=false);
+        /** \brief See storeConstantTerm(boost::string_ref, bool) (disambiguates string literals). */
+        ID storeConstantTerm(const char* symbol, bool aux=false)
+            { return storeConstantTerm(boost::string_ref(symbol), aux); }
 
         /**
          * \brief Allows for storing variable terms.
@@ -197,7 +203,24 @@ public boost::enable_shared_from_this<Registry>
          * @param symbol Variable to store.
          * @param aux Defines whether to mark the new term as auxiliary or not.
          */
+        ID storeVariableTerm(boost::string_ref symbol, bool aux=false);
+        /** \brief See storeVariableTerm(boost::string_ref, bool) (kept for plugins built against std::string). */
         ID storeVariableTerm(const std::string& symbol, bool aux=false);
+        /** \brief See storeVariableTerm(boost::string_ref, bool) (disambiguates string literals). */
+        ID storeVariableTerm(const char* symbol, bool aux=false)
+            { return storeVariableTerm(boost::string_ref(symbol), aux); }
+
+        /**
+         * \brief Allows for storing nested terms given by function symbol and arguments.
+         *
+         * Lookup the term by its arguments and return ID if exists (hash-consing)
+         * otherwise register it and return ID.
+         * The textual representation (Term::symbol) is only created if the term is new.
+         * @param arguments Element [0] is the function symbol, the remaining elements are the arguments (see Term::arguments).
+         * @param kind Kind of the nested term.
+         * @return ID of the stored term.
+         */
+        ID storeNestedTerm(const std::vector<ID>& arguments, IDKind kind = ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED);
 
         /**
          * \brief Allows for storing terms of arbitrary sub kind.
@@ -0,0 +1,88 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   RegistrySnapshot.h
+ *
+ * @brief  Binary snapshot of the Registry and the EDB.
+ */
+
+#ifndef REGISTRYSNAPSHOT_HPP_INCLUDED__18102026
+#define REGISTRYSNAPSHOT_HPP_INCLUDED__18102026
+
+#include "dlvhex2/PlatformDefinitions.h"
+#include "dlvhex2/fwd.h"
+#include "dlvhex2/ID.h"
+
+#include <string>
+
+DLVHEX_NAMESPACE_BEGIN
+
+/**
+ * \brief Writes the Registry tables and the EDB to a binary file and reads them in later runs.
+ *
+ * Parsing large fact bases dominates the startup time; a snapshot stores
+ * the terms, predicates and ground atoms of the Registry and the EDB of a parsed program,
+ * such that later runs over the same facts only need to register the stored symbols.
+ *
+ * IDs are only meaningful within one Registry (plugins may have registered symbols before),
+ * hence loading maps the addresses of the snapshot to the addresses in the current Registry;
+ * if all atoms keep their address, the EDB is deserialized directly (it is stored with bitmagic's bmserial).
+ * The file is memory-mapped on load and symbols are looked up without copying them.
+ *
+ * Snapshots are written by option --save-snapshot=FILE and read by --load-snapshot=FILE
+ * (configuration options "SaveSnapshot" and "LoadSnapshot").
+ */
+class DLVHEX_EXPORT RegistrySnapshot
+{
+    public:
+        /** \brief Constructor.
+         * @param ctx ProgramCtx which provides the registry and the EDB. */
+        RegistrySnapshot(ProgramCtx& ctx);
+
+        /** \brief Writes the Registry tables and the EDB of the ProgramCtx to a file.
+         *
+         * Throws FatalError if the file cannot be written.
+         * @param fileName Name of the snapshot file. */
+        void save(const std::string& fileName);
+
+        /** \brief Registers the symbols stored in a snapshot and adds its facts to the EDB of the ProgramCtx.
+         *
+         * Throws FatalError if the file cannot be read or is no valid snapshot.
+         * @param fileName Name of the snapshot file. */
+        void load(const std::string& fileName);
+
+    protected:
+        /** \brief ProgramCtx. */
+        ProgramCtx& ctx;
+};
+
+DLVHEX_NAMESPACE_END
+#endif                           // REGISTRYSNAPSHOT_HPP_INCLUDED__18102026
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -42,7 +42,6 @@
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/random_access_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/composite_key.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
@@ -58,11 +57,8 @@ boost::multi_index::indexed_by<
 boost::multi_index::random_access<
 boost::multi_index::tag<impl::AddressTag>
 >,
-// kind
-boost::multi_index::ordered_non_unique<
-boost::multi_index::tag<impl::KindTag>,
-BOOST_MULTI_INDEX_MEMBER(Rule,IDKind,kind)
->,
+// (no index on kind: it is never used for lookup, and for large ground programs
+// the ordered index costs one tree node per rule and logarithmic insertion time)
 // element
 boost::multi_index::hashed_unique<
 boost::multi_index::tag<impl::ElementTag>,
@@ -85,7 +81,6 @@ BOOST_MULTI_INDEX_MEMBER(Rule,Tuple,weakconstraintVector)
     // types
     public:
         typedef Container::index<impl::AddressTag>::type AddressIndex;
-        typedef Container::index<impl::KindTag>::type KindIndex;
         typedef Container::index<impl::ElementTag>::type ElementIndex;
         typedef AddressIndex::iterator AddressIterator;
         typedef ElementIndex::iterator ElementIterator;
@@ -35,7 +35,12 @@
 #define SET_HPP_INCLUDED__09122011
 
 #include <iterator>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <boost/foreach.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
 #include <boost/unordered_map.hpp>
 #include "dlvhex2/DynamicVector.h"
 
@@ -232,67 +237,95 @@ class set_iterator : public std::iterator<std::input_iterator_tag, T, ptrdiff_t,
         }
 };
 
-/** \brief Data structure for storing sets based on a sorted array. */
+/** \brief Data structure for storing sets based on a sorted array.
+ *
+ * Elements are copied with memcpy/memmove, hence T must be trivially copyable.
+ * Small sets are stored inside the object (see Set::InlineCapacity)
+ * and only larger ones allocate the array on the heap. */
 template<typename T>
 class Set
 {
     private:
+        enum
+        {
+            /** \brief Number of elements stored without heap allocation (64 bytes, e.g. 8 IDs). */
+            InlineCapacity = sizeof(T) < 64 ? 64 / sizeof(T) : 1,
+            /** \brief Sets up to this size are searched linearly. */
+            LinearSearchSize = 16
+        };
+
         T* data;
 
         int allocSize;
         int rsize;
         int increase;
 
-        /** \brief Grows Set::data such that it covers Set::allocSize. */
+        /** \brief Inline storage for small sets; not constructed as elements are only copied bytewise. */
+        typename boost::aligned_storage<sizeof(T) * InlineCapacity, boost::alignment_of<T>::value>::type inlineData;
+
+        /** \brief Retrieves the inline storage.
+         * @return Pointer to the begin of the inline storage. */
+        inline T* inlineBuffer() {
+            return reinterpret_cast<T*>(&inlineData);
+        }
+
+        /** \brief Checks if the elements are stored inline.
+         * @return True if Set::data points to the inline storage. */
+        inline bool isInline() const
+        {
+            return data == reinterpret_cast<const T*>(&inlineData);
+        }
+
+        /** \brief Grows Set::data by at least one element. */
         void grow() {
-            allocSize += increase;
-            data = (T*)realloc(data, sizeof(T) * allocSize);
+            grow(allocSize + 1);
         }
 
         /** \brief Grows Set::data such that it covers a given minimum size.
          *
+         * The capacity at least doubles (but grows by at least Set::increase elements)
+         * such that a sequence of insertions takes amortized constant time for allocation.
          * @param minSize Minimum size of the Set after this method retuns. */
         void grow(int minSize) {
-            allocSize = minSize % increase == 0
-                ? minSize
-                : (minSize / increase + 1) * increase;
-            data = (T*)realloc(data, sizeof(T) * allocSize);
+            if (minSize <= allocSize) return;
+            int newSize = std::max(allocSize * 2, allocSize + increase);
+            if (newSize < minSize) newSize = minSize;
+            if (isInline()) {
+                T* heap = (T*)malloc(sizeof(T) * newSize);
+                memcpy(heap, data, sizeof(T) * rsize);
+                data = heap;
+            }
+            else {
+                data = (T*)realloc(data, sizeof(T) * newSize);
+            }
+            allocSize = newSize;
         }
 
         /** \brief Implements binary search for the set.
+         *
+         * Small sets are searched by counting the smaller elements, larger ones by a binary search
+         * which halves the range without data-dependent branches; both avoid branch mispredictions
+         * and the linear count is vectorized by the compiler for integral elements (such as packed IDs).
          * @param e Element to search for.
-         * @return Index of \p e in the Set or 0 if it is not contained. */
+         * @return Index of \p e in the Set or the index where it would have to be inserted if it is not contained. */
         int binarySearch(T e) const
         {
-            if (rsize == 0) return 0;
-
-            int lower = 0;
-            int upper = rsize - 1;
-            int pos = (lower + upper) / 2;
-
-            while (data[pos] != e) {
-                if (e < data[pos]) {
-                    if (pos > lower) {
-                        upper = pos - 1;
-                    }
-                    else {
-                        // element is not contained: return insert location
-                        return pos;
-                    }
+            if (rsize <= LinearSearchSize) {
+                int pos = 0;
+                for (int i = 0; i < rsize; ++i) {
+                    pos += (data[i] < e) ? 1 : 0;
                 }
-                else {
-                    if (pos < upper) {
-                        lower = pos + 1;
-                    }
-                    else {
-                        // element is not contained: return insert location
-                        return pos + 1;
-                    }
-                }
-                pos = (lower + upper) / 2;
+                return pos;
             }
-            // element is contained
-            return pos;
+
+            const T* base = data;
+            int n = rsize;
+            while (n > 1) {
+                const int half = n / 2;
+                base = (base[half] < e) ? base + half : base;
+                n -= half;
+            }
+            return static_cast<int>(base - data) + ((*base < e) ? 1 : 0);
         }
 
     public:
@@ -302,31 +335,27 @@ class Set
         typedef const T& const_reference;
 
         /** \brief Constructor.
-         * @param initialSize Internal size of the internal array.
-         * @param inc Number of elements to add when the internal array needs to be resized. */
+         * @param initialSize Internal size of the internal array; sets up to Set::InlineCapacity elements do not allocate memory.
+         * @param inc Minimum number of elements to add when the internal array needs to be resized. */
         Set(int initialSize = 0, int inc = 10) : rsize(0), increase(inc) {
-            if (initialSize == 0) {
-                data = 0;
-            }
-            else {
-                data = (T*)realloc(0, sizeof(T) * initialSize);
-            }
-            allocSize = initialSize;
+            data = inlineBuffer();
+            allocSize = InlineCapacity;
+            grow(initialSize);
         }
 
         /** \brief Copy-constructor.
          * @param s2 Second set. */
-        Set(const Set<T>& s2) {
-            data = (T*)realloc(0, sizeof(T) * s2.allocSize);
-            allocSize = s2.allocSize;
-            increase = s2.increase;
+        Set(const Set<T>& s2) : rsize(0), increase(s2.increase) {
+            data = inlineBuffer();
+            allocSize = InlineCapacity;
+            grow(s2.rsize);
             rsize = s2.rsize;
             memcpy(data, s2.data, sizeof(T) * rsize);
         }
 
         /** \brief Destructor. */
         virtual ~Set() {
-            if (data) free(data);
+            if (!isInline()) free(data);
             data = 0;
         }
 
@@ -501,6 +530,7 @@ class Set
          * @param s2 Second Set.
          * @return Reference to this Set. */
         Set<T>& operator=(const Set<T>& s2) {
+            if (this == &s2) return *this;
             clear();
             grow(s2.size());
             rsize = s2.rsize;
@@ -40,6 +40,10 @@
 
 #include <boost/multi_index_container.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/atomic.hpp>
+#include <boost/integer/integer_log2.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/utility/string_ref.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
 
@@ -74,6 +78,150 @@ namespace impl
     struct InstTag               // instantiation Tag, for ordinary ground atom (for MLP case)
     {
     };
+
+    /** \brief Hash function for symbols of terms and predicates.
+     *
+     * Hashes std::string and boost::string_ref equally, hence symbols can be looked up
+     * without constructing a std::string, and a hash computed once can be used
+     * for lookups in several tables (see TermTable::getIDBySymbol and PredicateTable::getIDBySymbol). */
+    struct SymbolHash
+    {
+        typedef std::size_t result_type;
+        inline std::size_t operator()(const std::string& symbol) const
+            { return boost::hash_range(symbol.begin(), symbol.end()); }
+        inline std::size_t operator()(boost::string_ref symbol) const
+            { return boost::hash_range(symbol.begin(), symbol.end()); }
+    };
+
+    /** \brief Hash function which returns a previously computed hash (for lookups with SymbolHash). */
+    struct ConstantHash
+    {
+        explicit ConstantHash(std::size_t hash): hash(hash) {}
+        template<typename T>
+        inline std::size_t operator()(const T&) const
+            { return hash; }
+        std::size_t hash;
+    };
+
+    /** \brief Equality of symbols stored as std::string and symbols given as boost::string_ref. */
+    struct SymbolEqual
+    {
+        inline bool operator()(boost::string_ref a, const std::string& b) const
+            { return a == boost::string_ref(b); }
+        inline bool operator()(const std::string& a, boost::string_ref b) const
+            { return boost::string_ref(a) == b; }
+    };
+
+    /** \brief Append-only directory from addresses to table elements which can be read without locking.
+     *
+     * Elements are stored in segments of doubling size which are never moved or freed
+     * while the directory exists, hence a pointer to an element remains valid
+     * while other threads append further elements.
+     * The number of elements is published with release semantics after an element was added,
+     * readers load it with acquire semantics and hence always see completely initialized entries.
+     *
+     * Only one thread may append at a time (tables call push_back under their WriteLock),
+     * any number of threads may call get concurrently.
+     * The elements themselves must not change after they were published. */
+    template<typename ValueT>
+    class AddressDirectory
+    {
+        public:
+            /** \brief Constructor. */
+            AddressDirectory(): published(0) {
+                for(unsigned s = 0; s < MaxSegments; ++s)
+                    segments[s] = 0;
+            }
+
+            /** \brief Copy-constructor, creates an empty directory.
+             *
+             * Entries point into the storage of a specific table, hence they must
+             * be rebuilt for the storage of the copied table (see AddressDirectory::rebuild). */
+            AddressDirectory(const AddressDirectory&): published(0) {
+                for(unsigned s = 0; s < MaxSegments; ++s)
+                    segments[s] = 0;
+            }
+
+            /** \brief Destructor. */
+            ~AddressDirectory() { clear(); }
+
+            /** \brief Retrieves the number of published elements.
+             * @return Number of elements which can be retrieved by AddressDirectory::get. */
+            inline IDAddress size() const
+                { return published.load(boost::memory_order_acquire); }
+
+            /** \brief Retrieves an element by its address.
+             * @param addr Address of the element; the result is undefined if \p addr >= AddressDirectory::size().
+             * @return Element at address \p addr. */
+            inline const ValueT& get(IDAddress addr) const
+            {
+                unsigned segment, offset;
+                locate(addr, segment, offset);
+                return *segments[segment][offset];
+            }
+
+            /** \brief Appends an element (only one thread may do this at a time).
+             * @param value Element in stable storage; its address is the current size of the directory. */
+            void push_back(const ValueT& value)
+            {
+                const IDAddress addr = published.load(boost::memory_order_relaxed);
+                unsigned segment, offset;
+                locate(addr, segment, offset);
+                assert(segment < MaxSegments);
+                if( offset == 0 && segments[segment] == 0 )
+                    segments[segment] = new const ValueT*[static_cast<std::size_t>(FirstSegmentSize) << segment];
+                segments[segment][offset] = &value;
+                published.store(addr + 1, boost::memory_order_release);
+            }
+
+            /** \brief Replaces all entries by pointers to the elements of a random access range (not thread-safe).
+             * @param begin Begin of the range of elements in stable storage.
+             * @param end End of the range of elements. */
+            template<typename Iterator>
+            void rebuild(Iterator begin, Iterator end)
+            {
+                clear();
+                for(Iterator it = begin; it != end; ++it)
+                    push_back(*it);
+            }
+
+        private:
+            AddressDirectory& operator=(const AddressDirectory&);
+
+            /** \brief Frees all segments (not thread-safe). */
+            void clear()
+            {
+                for(unsigned s = 0; s < MaxSegments; ++s) {
+                    delete[] segments[s];
+                    segments[s] = 0;
+                }
+                published.store(0, boost::memory_order_release);
+            }
+
+            /** \brief Computes segment and offset of an address.
+             * @param addr Address.
+             * @param segment Receives the segment; segment s holds FirstSegmentSize*2^s entries.
+             * @param offset Receives the offset within the segment. */
+            static inline void locate(IDAddress addr, unsigned& segment, unsigned& offset)
+            {
+                const uint64_t n = static_cast<uint64_t>(addr) + FirstSegmentSize;
+                segment = static_cast<unsigned>(boost::integer_log2(n)) - FirstSegmentBits;
+                offset = static_cast<unsigned>(n - (static_cast<uint64_t>(FirstSegmentSize) << segment));
+            }
+
+            enum
+            {
+                FirstSegmentBits = 10,
+                FirstSegmentSize = 1 << FirstSegmentBits,
+                // enough segments for all 32 bit addresses
+                MaxSegments = 32 - FirstSegmentBits + 1
+            };
+
+            /** \brief Segments of pointers to the elements. */
+            const ValueT** segments[MaxSegments];
+            /** \brief Number of published elements. */
+            boost::atomic<IDAddress> published;
+    };
 }
 
 
@@ -129,6 +277,7 @@ public ostream_printable< Table<ValueT,IndexT> >
         Table& operator=(const Table& other) {
             WriteLock lock(mutex);
             container = other.container;
+            return *this;
         }
 
         /** \brief Retrieves the size of the table.
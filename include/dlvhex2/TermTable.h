@@ -41,11 +41,66 @@
 #include "dlvhex2/Table.h"
 
 #include <boost/multi_index/member.hpp>
+#include <boost/multi_index/identity.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/random_access_index.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
 
+namespace impl
+{
+    /** \brief Lookup key for nested terms given by their function symbol and arguments (see TermTable::getIDByArguments). */
+    struct NestedTermKey
+    {
+        /** \brief Element [0] is the function symbol, the remaining elements are the arguments (see Term::arguments). */
+        const std::vector<ID>& arguments;
+        /** \brief True for range terms, which have the same arguments as the function term "range(a,b)". */
+        bool range;
+        NestedTermKey(const std::vector<ID>& arguments, IDKind kind):
+            arguments(arguments), range((kind & ID::PROPERTY_TERM_RANGE) != 0) {}
+    };
+
+    /** \brief Hash function of the arguments index of TermTable.
+     *
+     * Nested terms are hashed by their arguments, primitive terms (whose only argument is ID_FAIL)
+     * by their symbol, such that primitive terms do not share a bucket. */
+    struct TermArgumentsHash
+    {
+        typedef std::size_t result_type;
+        inline std::size_t operator()(const NestedTermKey& key) const
+        {
+            std::size_t seed = boost::hash_range(key.arguments.begin(), key.arguments.end());
+            if( key.range )
+                boost::hash_combine(seed, 1);
+            return seed;
+        }
+        inline std::size_t operator()(const Term& term) const
+        {
+            if( !term.isNestedTerm() )
+                return SymbolHash()(term.symbol);
+            return operator()(NestedTermKey(term.arguments, term.kind));
+        }
+    };
+
+    /** \brief Equality of the arguments index of TermTable (see impl::TermArgumentsHash). */
+    struct TermArgumentsEqual
+    {
+        inline bool operator()(const NestedTermKey& key, const Term& term) const
+        {
+            return term.isNestedTerm() && key.range == ((term.kind & ID::PROPERTY_TERM_RANGE) != 0) &&
+                key.arguments == term.arguments;
+        }
+        inline bool operator()(const Term& term, const NestedTermKey& key) const
+            { return operator()(key, term); }
+        inline bool operator()(const Term& a, const Term& b) const
+        {
+            if( !a.isNestedTerm() || !b.isNestedTerm() )
+                return a.symbol == b.symbol;
+            return operator()(NestedTermKey(a.arguments, a.kind), b);
+        }
+    };
+}
+
 /** \brief Lookup tables for terms. */
 class TermTable:
 public Table<
@@ -60,7 +115,15 @@ boost::multi_index::tag<impl::AddressTag>
 // unique IDs for unique symbol strings
 boost::multi_index::hashed_unique<
 boost::multi_index::tag<impl::TermTag>,
-BOOST_MULTI_INDEX_MEMBER(Term,std::string,symbol)
+BOOST_MULTI_INDEX_MEMBER(Term,std::string,symbol),
+impl::SymbolHash
+>,
+// nested terms by function symbol and arguments (hash-consing)
+boost::multi_index::hashed_non_unique<
+boost::multi_index::tag<impl::TupleTag>,
+boost::multi_index::identity<Term>,
+impl::TermArgumentsHash,
+impl::TermArgumentsEqual
 >
 >
 >
@@ -70,8 +133,33 @@ BOOST_MULTI_INDEX_MEMBER(Term,std::string,symbol)
         typedef Container::index<impl::AddressTag>::type AddressIndex;
         typedef Container::index<impl::TermTag>::type TermIndex;
 
+    protected:
+        /** \brief Terms by address for retrieval without locking (see impl::AddressDirectory). */
+        impl::AddressDirectory<Term> byAddress;
+
         // methods
     public:
+        /** \brief Constructor. */
+        TermTable() {}
+
+        /** \brief Copy-constructor.
+         * @param other Other table. */
+        TermTable(const TermTable& other):
+        Table(other) {
+            const AddressIndex& idx = container.get<impl::AddressTag>();
+            byAddress.rebuild(idx.begin(), idx.end());
+        }
+
+        /** \brief Assignment operator.
+         * @param other Other table.
+         * @return This table. */
+        TermTable& operator=(const TermTable& other) {
+            Table::operator=(other);
+            const AddressIndex& idx = container.get<impl::AddressTag>();
+            byAddress.rebuild(idx.begin(), idx.end());
+            return *this;
+        }
+
         /** \brief Retrieve by ID.
          *
          * Assert that id.kind is correct for Term.
@@ -87,6 +175,28 @@ BOOST_MULTI_INDEX_MEMBER(Term,std::string,symbol)
          * @return ID_FAIL if term is not stored, otherwise return term ID. */
         inline ID getIDByString(const std::string& str) const throw();
 
+        /** \brief Given a symbol and its hash, look if already stored.
+         *
+         * Does not copy the symbol; use this if the same symbol is looked up in several tables.
+         * @param symbol Term string to lookup.
+         * @param hash Hash of \p symbol (see TermTable::hashSymbol).
+         * @return ID_FAIL if term is not stored, otherwise return term ID. */
+        inline ID getIDBySymbol(boost::string_ref symbol, std::size_t hash) const throw();
+
+        /** \brief Given the function symbol and arguments of a nested term, look if already stored.
+         *
+         * Unlike TermTable::getIDByString, this does not require the textual representation of the term.
+         * @param args Element [0] is the function symbol, the remaining elements are the arguments (see Term::arguments).
+         * @param kind Kind of the nested term (only PROPERTY_TERM_RANGE is relevant).
+         * @return ID_FAIL if term is not stored, otherwise return term ID. */
+        inline ID getIDByArguments(const std::vector<ID>& args, IDKind kind = ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED) const throw();
+
+        /** \brief Computes the hash of a symbol as used by TermTable and PredicateTable.
+         * @param symbol Term string.
+         * @return Hash of \p symbol. */
+        static inline std::size_t hashSymbol(boost::string_ref symbol) throw()
+            { return impl::SymbolHash()(symbol); }
+
         /** \brief Store term in the table.
          * Store symbol, assuming it does not exist.
          * Assert that symbol did not exist.
@@ -108,6 +218,10 @@ ID id) const throw ()
     assert(id.isTerm());
     // integers are not allowed in this table!
     assert(id.isConstantTerm() || id.isVariableTerm() || id.isNestedTerm());
+    // terms are never modified after they were stored, hence no lock is required
+    if( id.address < byAddress.size() )
+        return byAddress.get(id.address);
+    // the term was stored by another thread and is not yet visible in byAddress (synchronize via mutex)
     ReadLock lock(mutex);
     const AddressIndex& idx = container.get<impl::AddressTag>();
     // the following check only works for random access indices, but here it is ok
@@ -120,11 +234,22 @@ ID id) const throw ()
 // if no, return ID_FAIL, otherwise return ID
 ID TermTable::getIDByString(
 const std::string& str) const throw()
+{
+    return getIDBySymbol(str, hashSymbol(str));
+}
+
+
+// given symbol and its hash, look if already stored
+// if no, return ID_FAIL, otherwise return ID
+ID TermTable::getIDBySymbol(
+boost::string_ref symbol, std::size_t hash) const throw()
 {
     typedef Container::index<impl::TermTag>::type TermIndex;
+    assert(hash == hashSymbol(symbol));
     ReadLock lock(mutex);
     const TermIndex& sidx = container.get<impl::TermTag>();
-    TermIndex::const_iterator it = sidx.find(str);
+    // the index uses impl::SymbolHash, hence we can use the given hash
+    TermIndex::const_iterator it = sidx.find(symbol, impl::ConstantHash(hash), impl::SymbolEqual());
     if( it == sidx.end() )
         return ID_FAIL;
     else {
@@ -138,16 +263,17 @@ const std::string& str) const throw()
 }
 
 
-#if 0
-// given an argument vector, look if already stored
+// given function symbol and arguments, look if already stored
 // if no, return ID_FAIL, otherwise return ID
 ID TermTable::getIDByArguments(
-const std::vector<ID>& args) const throw()
+const std::vector<ID>& args, IDKind kind) const throw()
 {
     typedef Container::index<impl::TupleTag>::type ArgIndex;
+    assert(!args.empty() && args[0] != ID_FAIL);
     ReadLock lock(mutex);
     const ArgIndex& sidx = container.get<impl::TupleTag>();
-    ArgIndex::const_iterator it = sidx.find(args);
+    const impl::NestedTermKey key(args, kind);
+    ArgIndex::const_iterator it = sidx.find(key, impl::TermArgumentsHash(), impl::TermArgumentsEqual());
     if( it == sidx.end() )
         return ID_FAIL;
     else {
@@ -159,7 +285,6 @@ const std::vector<ID>& args) const throw()
             );
     }
 }
-#endif
 
 // store symbol, assuming it does not exist
 // assert that symbol did not exist
@@ -179,6 +304,7 @@ const Term& symb) throw()
     boost::tie(it, success) = idx.push_back(symb);
     (void)success;
     assert(success);
+    byAddress.push_back(*it);
 
     return ID(
         symb.kind,               // kind
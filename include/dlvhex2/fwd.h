@@ -73,6 +73,12 @@ struct ExternalAtom;
 class EAInputTupleCache;
 typedef boost::shared_ptr<EAInputTupleCache> EAInputTupleCachePtr;
 
+class EvalProfile;
+typedef boost::shared_ptr<EvalProfile> EvalProfilePtr;
+
+class PreparedSubprogram;
+typedef boost::shared_ptr<PreparedSubprogram> PreparedSubprogramPtr;
+
 // FinalEvalGraph is a typedef and must not be forward-declared!
 
 class HexParser;
@@ -213,7 +213,10 @@ namespace ASPSolver
                                         ogatom.tuple.push_back(id);
                                     }
                                 }
-                                idga = registry->ogatoms.storeAndGetID(ogatom);
+                                // the text index is optional (see OrdinaryAtomTable::setStoreText)
+                                idga = registry->ogatoms.getIDByTuple(ogatom.tuple);
+                                if( idga == ID_FAIL )
+                                    idga = registry->ogatoms.storeAndGetID(ogatom);
                             }
                             assert(idga != ID_FAIL);
                             as->interpretation->setFact(idga.address);
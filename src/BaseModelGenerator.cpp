@@ -475,14 +475,18 @@ bool* fromCache) const
         projectEAtomInputInterpretation(ctx.registry(), eatom, inputi);
     DBGLOG(DBG,"projected input interpretation = " << *eatominp);
 
+    // (share projections of identical interpretations instead of computing them again)
     InterpretationConstPtr eatomassigned;
-    if (assigned) eatomassigned = projectEAtomInputInterpretation(ctx.registry(), eatom, assigned);
+    if (assigned && assigned == inputi) eatomassigned = eatominp;
+    else if (assigned) eatomassigned = projectEAtomInputInterpretation(ctx.registry(), eatom, assigned);
 
     InterpretationConstPtr eatomchanged;
-    if (changed) eatomchanged = projectEAtomInputInterpretation(ctx.registry(), eatom, changed);
+    if (changed && changed == inputi) eatomchanged = eatominp;
+    else if (changed && changed == assigned) eatomchanged = eatomassigned;
+    else if (changed) eatomchanged = projectEAtomInputInterpretation(ctx.registry(), eatom, changed);
 
     InterpretationPtr pim = InterpretationPtr(new Interpretation(ctx.registry()));
-    pim->add(*eatom.getPredicateInputMask());
+    pim->getStorage() = eatom.getPredicateInputMask()->getStorage();
     if( eatom.auxInputPredicate == ID_FAIL ) {
         // only one input tuple, and that is the one stored in eatom.inputs
 
@@ -571,13 +575,13 @@ bool* fromCache) const
 
     PluginAtom::Answer answer;
     assert(!!eatom.pluginAtom);
-    bool fromCache_ = eatom.pluginAtom->retrieveFacade(query, answer, nogoods, query.ctx->config.getOption("UseExtAtomCache"));
+    bool fromCache_ = eatom.pluginAtom->retrieveFacade(query, answer, nogoods, query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
     if (fromCache) *fromCache = fromCache_;
     LOG(PLUGIN,"got " << answer.get().size() << " answer tuples");
 
     if( !answer.get().empty() ) {
         Tuple it;
-        if (ctx.config.getOption("IncludeAuxInputInAuxiliaries") && eatom.auxInputPredicate != ID_FAIL) {
+        if (ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && eatom.auxInputPredicate != ID_FAIL) {
             it.push_back(eatom.auxInputPredicate);
         }
         BOOST_FOREACH (ID i, inputtuple) it.push_back(i);
@@ -629,6 +633,9 @@ NogoodContainerPtr nogoods) const
     // if this is wrong, we might have mixed up registries between plugin and program
     assert(!!eatom.pluginAtom && eatom.getExtSourceProperties().providesSupportSets() && eatom.predicate == eatom.pluginAtom->getPredicateID());
 
+    // model builders may learn support sets concurrently
+    PluginAtom::EvaluationLock lock(*eatom.pluginAtom);
+
     // update masks (inputMask and auxInputMask)
     eatom.updatePredicateInputMask();
 
@@ -637,7 +644,7 @@ NogoodContainerPtr nogoods) const
     eatominp->add(*eatom.getPredicateInputMask());
 
     InterpretationPtr pim = InterpretationPtr(new Interpretation(ctx.registry()));
-    pim->add(*eatom.getPredicateInputMask());
+    pim->getStorage() = eatom.getPredicateInputMask()->getStorage();
     if( eatom.auxInputPredicate == ID_FAIL ) {
         // only one input tuple, and that is the one stored in eatom.inputs
 
@@ -756,12 +763,14 @@ const ExternalAtom& eatom, InterpretationConstPtr full) const
     // we do this in general for the eatom
     //eatom.updatePredicateInputMask();
 
-    InterpretationPtr ret;
-    if( full == 0 )
-        ret.reset(new Interpretation(reg));
-    else
-        ret.reset(new Interpretation(*full));
-    ret->getStorage() &= eatom.getPredicateInputMask()->getStorage();
+    // start from the mask and intersect with the full interpretation:
+    // this way we never copy atoms of full which are not relevant for eatom
+    // (the mask usually covers only a small part of the interpretation)
+    InterpretationPtr ret(new Interpretation(reg));
+    if( full != 0 ) {
+        ret->getStorage() = eatom.getPredicateInputMask()->getStorage();
+        ret->getStorage() &= full->getStorage();
+    }
     return ret;
 }
 
@@ -783,10 +792,11 @@ InterpretationPtr inputs) const
     assert(eatom.auxInputPredicate != ID_FAIL);
 
     // otherwise find all aux input predicates that are true and extract their tuples
-    Interpretation relevant(reg);
-    relevant.getStorage() |= interpretation->getStorage() & eatom.getAuxInputMask()->getStorage();
-    Interpretation::TrueBitIterator it, it_end;
-    boost::tie(it, it_end) = relevant.trueBits();
+    // (intersect block-wise, starting from a copy of the mask which is usually small,
+    // rather than testing the interpretation for each bit of the mask)
+    Interpretation::Storage relevant(eatom.getAuxInputMask()->getStorage());
+    relevant &= interpretation->getStorage();
+    Interpretation::TrueBitIterator it = relevant.first(), it_end = relevant.end();
     {
         for(;it != it_end; ++it) {
             IDAddress inputAtomBit = *it;
@@ -869,7 +879,7 @@ ProgramCtx& ctx, const Tuple& body, Tuple& convbody)
             replacement.tuple.push_back(
                 reg->getAuxiliaryConstantSymbol('r',
                 eatom.pluginAtom->getPredicateID()));
-            if (ctx.config.getOption("IncludeAuxInputInAuxiliaries") && eatom.auxInputPredicate != ID_FAIL) {
+            if (ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && eatom.auxInputPredicate != ID_FAIL) {
                 replacement.tuple.push_back(eatom.auxInputPredicate);
             }
             replacement.tuple.insert(replacement.tuple.end(),
@@ -1014,7 +1024,7 @@ void BaseModelGeneratorFactory::addDomainPredicatesAndCreateDomainExplorationPro
                         OrdinaryAtom replacement(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYN | ID::PROPERTY_AUX | ID::PROPERTY_EXTERNALAUX);
                         replacement.tuple.push_back(reg->getAuxiliaryConstantSymbol('r', eatom.predicate));
 
-                        if (ctx.config.getOption("IncludeAuxInputInAuxiliaries") && eatom.auxInputPredicate != ID_FAIL) {
+                        if (ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && eatom.auxInputPredicate != ID_FAIL) {
                             replacement.tuple.push_back(eatom.auxInputPredicate);
                         }
                         replacement.tuple.insert(replacement.tuple.end(), eatom.inputs.begin(), eatom.inputs.end());
@@ -1033,7 +1043,7 @@ void BaseModelGeneratorFactory::addDomainPredicatesAndCreateDomainExplorationPro
                         chosenDomainAtom.tuple.push_back(reg->getAuxiliaryConstantSymbol('r', b));
                                  // exploration program anyway
                         notChosenDomainAtom.tuple.push_back(reg->getAuxiliaryConstantSymbol('n', b));
-                        if (ctx.config.getOption("IncludeAuxInputInAuxiliaries") && ea.auxInputPredicate != ID_FAIL) {
+                        if (ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && ea.auxInputPredicate != ID_FAIL) {
                             domainAtom.tuple.push_back(ea.auxInputPredicate);
                             chosenDomainAtom.tuple.push_back(ea.auxInputPredicate);
                             notChosenDomainAtom.tuple.push_back(ea.auxInputPredicate);
@@ -1111,13 +1121,113 @@ void BaseModelGeneratorFactory::addDomainPredicatesAndCreateDomainExplorationPro
 }
 
 
-InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(ProgramCtx& ctx, InterpretationConstPtr edb, std::vector<ID>& deidb, std::vector<ID>& deidbInnerEatoms, std::vector<ID> pseudoInnerEatoms)
+InterpretationConstPtr DomainExplorationCache::project(RegistryPtr reg, InterpretationConstPtr edb, const std::vector<ID>& deidb, const std::vector<ID>& deidbInnerEatoms)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    if (!initialized) {
+        initialized = true;
+        mask.setRegistry(reg);
+
+        // all predicates which occur in the domain-exploration program
+        std::vector<ID> lits;
+        BOOST_FOREACH (ID rid, deidb) {
+            const Rule& rule = reg->rules.getByID(rid);
+            lits.insert(lits.end(), rule.head.begin(), rule.head.end());
+            lits.insert(lits.end(), rule.body.begin(), rule.body.end());
+        }
+        while (!lits.empty() && projectable) {
+            ID lit = lits.back();
+            lits.pop_back();
+            if (lit.isOrdinaryAtom()) {
+                mask.addPredicate(reg->lookupOrdinaryAtom(lit).tuple[0]);
+            }
+            else if (lit.isAggregateAtom()) {
+                const AggregateAtom& aatom = reg->aatoms.getByID(lit);
+                lits.insert(lits.end(), aatom.literals.begin(), aatom.literals.end());
+            }
+            else if (!lit.isBuiltinAtom()) {
+                DBGLOG(DBG, "Domain-exploration program contains " << lit << ": domain exploration results are stored for the unprojected input");
+                projectable = false;
+            }
+        }
+
+        // input predicates of the external atoms which are evaluated during domain exploration
+        BOOST_FOREACH (ID eaid, deidbInnerEatoms) {
+            const ExternalAtom& ea = reg->eatoms.getByID(eaid);
+            for (uint32_t i = 0; i < ea.inputs.size(); ++i) {
+                if (ea.pluginAtom->getInputType(i) == PluginAtom::PREDICATE) mask.addPredicate(ea.inputs[i]);
+            }
+            if (ea.auxInputPredicate != ID_FAIL) mask.addPredicate(ea.auxInputPredicate);
+        }
+    }
+
+    if (!projectable) return edb;
+
+    mask.updateMask();
+    InterpretationPtr input(new Interpretation(reg));
+    input->getStorage() |= edb->getStorage();
+    input->getStorage() &= mask.mask()->getStorage();
+    return input;
+}
+
+
+InterpretationConstPtr DomainExplorationCache::lookup(InterpretationConstPtr input, Entry& base)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    std::size_t inputHash = hash_value(*input);
+    unsigned inputCount = input->getStorage().count();
+    unsigned baseCount = 0;
+    for (std::list<Entry>::iterator it = entries.begin(); it != entries.end(); ++it) {
+        if (it->inputHash == inputHash && *it->input == *input) {
+            // move to front
+            entries.splice(entries.begin(), entries, it);
+            return entries.front().domain;
+        }
+        unsigned count = it->input->getStorage().count();
+        if (count <= inputCount && (!base.input || count > baseCount) &&
+        (it->input->getStorage() - input->getStorage()).none()) {
+            base = *it;
+            baseCount = count;
+        }
+    }
+    return InterpretationConstPtr();
+}
+
+
+void DomainExplorationCache::store(const Entry& entry, unsigned capacity)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    entries.push_front(entry);
+    entries.front().inputHash = hash_value(*entry.input);
+    while (entries.size() > capacity) entries.pop_back();
+}
+
+
+InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(ProgramCtx& ctx, InterpretationConstPtr edb, std::vector<ID>& deidb, std::vector<ID>& deidbInnerEatoms, std::vector<ID> pseudoInnerEatoms, DomainExplorationCache* cache)
 {
 
     RegistryPtr reg = ctx.registry();
     if (deidbInnerEatoms.empty()) return InterpretationPtr(new Interpretation(reg));
 
     DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidcedp,"computeExtensionOfDomainPreds");
+
+    // reuse results of previous domain explorations of this unit (pseudo-inner external atoms depend on the full input, thus we do not cache in this case)
+    unsigned cacheSize = ctx.config.getOption("DomainExplorationCacheSize");
+    bool useCache = !!cache && cacheSize > 0 && pseudoInnerEatoms.empty();
+    DomainExplorationCache::Entry base;
+    if (useCache) {
+        edb = cache->project(reg, edb, deidb, deidbInnerEatoms);
+        InterpretationConstPtr domain = cache->lookup(edb, base);
+        if (!!domain) {
+            DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidcachehit, "DomainExpl cache hits", 1);
+            DBGLOG(DBG, "Reusing extension of domain predicates for input " << *edb);
+            return domain;
+        }
+    }
+
     DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidhexground, "HEX grounder time");
 
     // get the set of all predicates defined in deidb
@@ -1134,6 +1244,11 @@ InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(Pr
 
     InterpretationPtr domintr = InterpretationPtr(new Interpretation(reg));
     domintr->getStorage() |= edb->getStorage();
+    if (!!base.domain) {
+        // the input extends a previously explored one: continue the fixpoint iteration from its result
+        DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidcacheincr, "DomainExpl incremental", 1);
+        domintr->getStorage() |= base.domain->getStorage();
+    }
 
     DBGLOG(DBG, "Computing fixpoint of extensions of domain predicates");
     DBGLOG(DBG, "" << deidbInnerEatoms.size() << " inner external atoms are necessary for establishing de-safety");
@@ -1145,6 +1260,7 @@ InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(Pr
     InterpretationPtr herbrandBase = InterpretationPtr(new Interpretation(reg));
     InterpretationPtr oldherbrandBase = InterpretationPtr(new Interpretation(reg));
     herbrandBase->getStorage() |= edb->getStorage();
+    if (!!base.herbrandBase) herbrandBase->getStorage() |= base.herbrandBase->getStorage();
     do {
         oldherbrandBase->getStorage() = herbrandBase->getStorage();
 
@@ -1274,7 +1390,7 @@ InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(Pr
                         OrdinaryAtom domatom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG | ID::PROPERTY_AUX);
                         domatom.tuple.push_back(reg->getAuxiliaryConstantSymbol('d', eaid));
                         int io = 1;
-                        //							if (ea.auxInputPredicate != ID_FAIL && ctx.config.getOption("IncludeAuxInputInAuxiliaries")) io = 2;
+                        //							if (ea.auxInputPredicate != ID_FAIL && ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES)) io = 2;
                         for (uint32_t i = io; i < ogatom.tuple.size(); ++i) {
                             domatom.tuple.push_back(ogatom.tuple[i]);
                         }
@@ -1291,6 +1407,14 @@ InterpretationConstPtr BaseModelGenerator::computeExtensionOfDomainPredicates(Pr
 
     domintr->getStorage() -= edb->getStorage();
     DBGLOG(DBG, "Domain extension interpretation (final result): " << *domintr);
+
+    if (useCache) {
+        DomainExplorationCache::Entry entry;
+        entry.input = edb;
+        entry.domain = domintr;
+        entry.herbrandBase = herbrandBase;
+        cache->store(entry, cacheSize);
+    }
     return domintr;
 }
 
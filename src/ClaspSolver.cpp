@@ -1037,7 +1037,7 @@ void ClaspSolver::updateSymbolTable()
         std::string ss(it->second.name.c_str());
         IDAddress hexAdr = stringToIDAddress(it->second.name.c_str());
         storeHexToClasp(hexAdr, it->second.lit);
-        DBGLOG(DBG, "H:" << hexAdr << " (" << reg->ogatoms.getByAddress(hexAdr).text <<  ") <--> "
+        DBGLOG(DBG, "H:" << hexAdr << " (" << printToString<RawPrinter>(reg->ogatoms.getIDByAddress(hexAdr), reg) <<  ") <--> "
             "C:" << it->second.lit.index() << "/" << (it->second.lit.sign() ? "!" : "") << it->second.lit.var());
         assert(it->second.lit.index() < claspToHex.size());
         AddressVector* &c2h = claspToHex[it->second.lit.index()];
@@ -1366,7 +1366,7 @@ void ClaspSolver::addNogoodSet(const NogoodSet& ns, InterpretationConstPtr froze
     // add new variables
     claspctx.symbolTable().startInit(Clasp::SymbolTable::map_indirect);
     for (int i = 0; i < ns.getNogoodCount(); ++i) {
-        const Nogood ng = ns.getNogood(i);
+        const Nogood& ng = ns.getNogood(i);
         BOOST_FOREACH (ID id, ng) {
             // this will register the variable if not already available
             convertHexToClaspProgramLit(id.address, true);
@@ -45,8 +45,39 @@
 
 DLVHEX_NAMESPACE_BEGIN
 
+namespace
+{
+    // names of the options in Configuration::cachedOption_t (in the same order)
+    const char* cachedOptionNames[Configuration::CACHED_OPTION_COUNT] = {
+    "Verbose",
+    "GenuineSolver",
+    "ExternalLearning",
+    "ExternalLearningUser",
+    "ExternalLearningIOBehavior",
+    "ExternalLearningFunctionality",
+    "ExternalLearningNeg",
+    "ExternalLearningLinearity",
+    "ExternalLearningMonotonicity",
+    "UseExtAtomCache",
+    "IncludeAuxInputInAuxiliaries",
+    "MinimizeNogoods",
+    "MinimizeNogoodsOpt",
+    "MinimizeNogoodsOnConflict",
+    "MinimizationSize",
+    "TransUnitLearning",
+    "NoPropagator",
+    "SupportSets",
+    "ExternalAtomVerificationFromLearnedNogoods"
+    };
+}
+
 Configuration::Configuration()
 {
+    for (unsigned o = 0; o < CACHED_OPTION_COUNT; ++o) {
+        cachedOptionValue[o] = 0;
+        cachedOptionSet[o] = false;
+    }
+
     //
     // program analysis
     //
@@ -86,13 +117,20 @@ Configuration::getOption(const std::string& option) const
 }
 
 
+void
+Configuration::throwUnsetOption(cachedOption_t option) const
+{
+    throw std::runtime_error(std::string("requested non-existing/unset option '") + cachedOptionNames[option] + "'");
+}
+
+
 bool
 Configuration::doVerbose(verboseAction_t va)
 {
     //
     // bitwise and
     //
-    return (this->getOption("Verbose") & verboseLevel[va]) != 0;
+    return (this->getOption(OPTION_VERBOSE) & verboseLevel[va]) != 0;
 }
 
 
@@ -100,6 +138,15 @@ void
 Configuration::setOption(const std::string& option, unsigned value)
 {
     optionMap[option] = value;
+
+    // keep options which are read in hot paths up to date
+    for (unsigned o = 0; o < CACHED_OPTION_COUNT; ++o) {
+        if (option == cachedOptionNames[o]) {
+            cachedOptionValue[o] = value;
+            cachedOptionSet[o] = true;
+            break;
+        }
+    }
 }
 
 
@@ -82,6 +82,12 @@ bool EvalHeuristicGreedy::mergeComponents(ProgramCtx& ctx, const ComponentGraph:
 }
 
 
+bool EvalHeuristicGreedy::mergeProfitable(ProgramCtx& ctx, const ComponentGraph& compgraph, ComponentGraph::Component comp1, ComponentGraph::Component comp2) const
+{
+    return true;
+}
+
+
 EvalHeuristicGreedy::EvalHeuristicGreedy():
 Base()
 {
@@ -370,7 +376,8 @@ void EvalHeuristicGreedy::build(EvalGraphBuilder& builder)
                                   (negdep.find(std::pair<ComponentGraph::Component, ComponentGraph::Component>(comp2, comp)) != negdep.end());
                         }
 
-                        if (mergeComponents(ctx, compgraph.propsOf(comp), compgraph.propsOf(comp2), nd)) {
+                        if (mergeComponents(ctx, compgraph.propsOf(comp), compgraph.propsOf(comp2), nd) &&
+                        mergeProfitable(ctx, compgraph, comp, comp2)) {
                             if (std::find(collapse.begin(), collapse.end(), comp2) == collapse.end()) {
                                 collapse.insert(comp2);
                                 // merge only one pair at a time, otherwise this could create cycles which are not detected above:
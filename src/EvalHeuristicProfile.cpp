@@ -0,0 +1,123 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   EvalHeuristicProfile.cpp
+ *
+ * @brief  Evaluation heuristic that merges components based on metrics of a previous run.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/EvalHeuristicProfile.h"
+#include "dlvhex2/Logger.h"
+#include "dlvhex2/ProgramCtx.h"
+
+#include <algorithm>
+
+DLVHEX_NAMESPACE_BEGIN
+
+namespace
+{
+
+    // true if comp2 directly depends on comp1
+    bool dependsOn(const ComponentGraph& compgraph, ComponentGraph::Component comp2, ComponentGraph::Component comp1)
+    {
+        ComponentGraph::PredecessorIterator pit, pit_end;
+        for(boost::tie(pit, pit_end) = compgraph.getDependencies(comp2);
+        pit != pit_end; ++pit) {
+            if( compgraph.targetOf(*pit) == comp1 )
+                return true;
+        }
+        return false;
+    }
+
+    // cost of one unit where the part of b is solved for each candidate of a
+    double mergedCost(const EvalProfile::Estimate& a, const EvalProfile::Estimate& b)
+    {
+        return a.groundingTime + b.groundingTime +
+            (a.time - a.groundingTime) + a.candidates * (b.time - b.groundingTime);
+    }
+
+}
+
+
+EvalHeuristicProfile::EvalHeuristicProfile(const std::string& fname):
+Base(),
+fname(fname)
+{
+}
+
+
+EvalHeuristicProfile::~EvalHeuristicProfile()
+{
+}
+
+
+bool EvalHeuristicProfile::mergeProfitable(ProgramCtx& ctx, const ComponentGraph& compgraph, ComponentGraph::Component comp1, ComponentGraph::Component comp2) const
+{
+    assert(!!profile);
+    EvalProfile::Estimate e1 = profile->estimate(compgraph.propsOf(comp1));
+    EvalProfile::Estimate e2 = profile->estimate(compgraph.propsOf(comp2));
+    if( !e1.known || !e2.known ) {
+        DBGLOG(DBG,"no profile data for " << comp1 << " or " << comp2 << ", merging");
+        return true;
+    }
+
+    double separate, merged;
+    if( dependsOn(compgraph, comp2, comp1) ) {
+        separate = e1.time + e1.models * e2.time;
+        merged = mergedCost(e1, e2);
+    }
+    else if( dependsOn(compgraph, comp1, comp2) ) {
+        separate = e2.time + e2.models * e1.time;
+        merged = mergedCost(e2, e1);
+    }
+    else {
+        separate = e1.time + e2.time;
+        merged = std::min(mergedCost(e1, e2), mergedCost(e2, e1));
+    }
+    LOG(ANALYZE,"predicted cost of " << comp1 << " and " << comp2 << ": separate " << separate << "s, merged " << merged << "s");
+    return merged <= separate;
+}
+
+
+void EvalHeuristicProfile::build(EvalGraphBuilder& builder)
+{
+    profile.reset(new EvalProfile(builder.registry()));
+    profile->load(fname);
+    Base::build(builder);
+}
+
+
+DLVHEX_NAMESPACE_END
+
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
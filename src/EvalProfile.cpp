@@ -0,0 +1,333 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   EvalProfile.cpp
+ *
+ * @brief  Per-unit evaluation metrics recorded in one run and used to plan later runs.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/EvalProfile.h"
+#include "dlvhex2/Benchmarking.h"
+#include "dlvhex2/Error.h"
+#include "dlvhex2/Logger.h"
+#include "dlvhex2/Printer.h"
+#include "dlvhex2/Registry.h"
+
+#include <boost/foreach.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+DLVHEX_NAMESPACE_BEGIN
+
+namespace
+{
+
+    typedef EvalProfile::Unit Unit;
+    typedef EvalProfile::UnitPtr UnitPtr;
+    typedef ModelGeneratorBase<Interpretation> MyModelGeneratorBase;
+    typedef ModelGeneratorFactoryBase<Interpretation> MyModelGeneratorFactoryBase;
+
+    double toSeconds(const benchmark::Duration& d)
+    {
+        return double(d.total_microseconds()) / 1000000.0;
+    }
+
+    // benchmark counters which are attributed to the unit that is currently evaluated
+    struct ProfiledCounters
+    {
+        benchmark::ID grounder;
+        benchmark::ID hexGrounder;
+        benchmark::ID eatom;
+        benchmark::ID ufs;
+        benchmark::ID candidates;
+
+        ProfiledCounters() {
+            benchmark::BenchmarkController& bmc = benchmark::BenchmarkController::Instance();
+            grounder = bmc.getInstrumentationID("Grounder time");
+            hexGrounder = bmc.getInstrumentationID("HEX grounder time");
+            eatom = bmc.getInstrumentationID("PluginAtom retrieve");
+            ufs = bmc.getInstrumentationID("UnfoundedSetChkMgr::getUFS");
+            candidates = bmc.getInstrumentationID("Candidate compatible sets");
+        }
+
+        static const ProfiledCounters& instance() {
+            static ProfiledCounters counters;
+            return counters;
+        }
+    };
+
+    // state of time, counters and registry before a call into a model generator (factory)
+    class Snapshot
+    {
+        private:
+            RegistryPtr reg;
+            benchmark::Time start;
+            unsigned groundAtoms;
+            benchmark::Duration grounder, hexGrounder, eatom, ufs;
+            benchmark::Count eatomCalls, candidates;
+
+        public:
+            Snapshot(RegistryPtr reg):
+            reg(reg),
+            start(boost::posix_time::microsec_clock::local_time()),
+            groundAtoms(reg->ogatoms.getSize()) {
+                const ProfiledCounters& pc = ProfiledCounters::instance();
+                benchmark::BenchmarkController& bmc = benchmark::BenchmarkController::Instance();
+                grounder = bmc.getStat(pc.grounder).duration;
+                hexGrounder = bmc.getStat(pc.hexGrounder).duration;
+                eatom = bmc.getStat(pc.eatom).duration;
+                eatomCalls = bmc.getStat(pc.eatom).count;
+                ufs = bmc.getStat(pc.ufs).duration;
+                candidates = bmc.getStat(pc.candidates).count;
+            }
+
+            // add everything that happened since construction to the unit
+            void addTo(Unit& unit, unsigned instantiations, unsigned models) const {
+                const ProfiledCounters& pc = ProfiledCounters::instance();
+                benchmark::BenchmarkController& bmc = benchmark::BenchmarkController::Instance();
+                benchmark::Time now(boost::posix_time::microsec_clock::local_time());
+
+                // "HEX grounder time" may contain "Grounder time", so take the larger one
+                double grounding = std::max(
+                    toSeconds(bmc.getStat(pc.grounder).duration - grounder),
+                    toSeconds(bmc.getStat(pc.hexGrounder).duration - hexGrounder));
+
+                boost::mutex::scoped_lock lock(unit.mutex);
+                EvalProfile::UnitMetrics& m = unit.metrics;
+                m.instantiations += instantiations;
+                m.models += models;
+                m.candidates += bmc.getStat(pc.candidates).count - candidates;
+                m.groundAtoms += reg->ogatoms.getSize() - groundAtoms;
+                m.eatomCalls += bmc.getStat(pc.eatom).count - eatomCalls;
+                m.time += toSeconds(now - start);
+                m.groundingTime += grounding;
+                m.eatomTime += toSeconds(bmc.getStat(pc.eatom).duration - eatom);
+                m.ufsTime += toSeconds(bmc.getStat(pc.ufs).duration - ufs);
+            }
+    };
+
+    class ProfilingModelGenerator:
+    public MyModelGeneratorBase
+    {
+        protected:
+            MyModelGeneratorBase::Ptr inner;
+            UnitPtr unit;
+            RegistryPtr reg;
+
+        public:
+            ProfilingModelGenerator(MyModelGeneratorBase::Ptr inner, UnitPtr unit, RegistryPtr reg):
+            MyModelGeneratorBase(InterpretationConstPtr()),
+            inner(inner), unit(unit), reg(reg) {}
+
+            virtual InterpretationPtr generateNextModel() {
+                Snapshot snapshot(reg);
+                InterpretationPtr model = inner->generateNextModel();
+                snapshot.addTo(*unit, 0, !!model ? 1 : 0);
+                return model;
+            }
+
+            virtual const Nogood* getInconsistencyCause() { return inner->getInconsistencyCause(); }
+            virtual void addNogood(const Nogood* ng) { inner->addNogood(ng); }
+            virtual std::ostream& print(std::ostream& o) const { return inner->print(o); }
+    };
+
+    class ProfilingModelGeneratorFactory:
+    public MyModelGeneratorFactoryBase
+    {
+        protected:
+            MyModelGeneratorFactoryBase::Ptr inner;
+            UnitPtr unit;
+            RegistryPtr reg;
+
+        public:
+            ProfilingModelGeneratorFactory(MyModelGeneratorFactoryBase::Ptr inner, UnitPtr unit, RegistryPtr reg):
+            inner(inner), unit(unit), reg(reg) {}
+
+            virtual void addInconsistencyCauseFromSuccessor(const Nogood* cause) {
+                inner->addInconsistencyCauseFromSuccessor(cause);
+            }
+
+            // model generators may already ground and solve in their constructor
+            virtual ModelGeneratorPtr createModelGenerator(InterpretationConstPtr input) {
+                Snapshot snapshot(reg);
+                ModelGeneratorPtr mg = inner->createModelGenerator(input);
+                snapshot.addTo(*unit, 1, 0);
+                return ModelGeneratorPtr(new ProfilingModelGenerator(mg, unit, reg));
+            }
+
+            virtual std::ostream& print(std::ostream& o) const { return inner->print(o); }
+    };
+
+}
+
+
+EvalProfile::UnitMetrics::UnitMetrics():
+instantiations(0), models(0), candidates(0), groundAtoms(0), eatomCalls(0),
+time(0.0), groundingTime(0.0), eatomTime(0.0), ufsTime(0.0)
+{
+}
+
+
+EvalProfile::Estimate::Estimate():
+known(false), time(0.0), groundingTime(0.0), models(0.0), candidates(0.0)
+{
+}
+
+
+EvalProfile::EvalProfile(RegistryPtr reg):
+reg(reg)
+{
+}
+
+
+std::vector<std::string> EvalProfile::getRuleTexts(const ComponentGraph::ComponentInfo& ci) const
+{
+    std::vector<std::string> texts;
+    std::vector<ID> rules(ci.innerRules);
+    rules.insert(rules.end(), ci.innerConstraints.begin(), ci.innerConstraints.end());
+    BOOST_FOREACH (ID rid, rules) {
+        std::string text = printToString<RawPrinter>(rid, reg);
+        // one rule per line in the profile
+        std::replace(text.begin(), text.end(), '\n', ' ');
+        texts.push_back(text);
+    }
+    std::sort(texts.begin(), texts.end());
+    return texts;
+}
+
+
+EvalProfile::ModelGeneratorFactoryPtr EvalProfile::record(const ComponentGraph::ComponentInfo& ci, ModelGeneratorFactoryPtr mgf)
+{
+    UnitPtr unit(new Unit);
+    unit->rules = getRuleTexts(ci);
+    units.push_back(unit);
+    BOOST_FOREACH (const std::string& rule, unit->rules) unitOfRule[rule] = unit;
+    return ModelGeneratorFactoryPtr(new ProfilingModelGeneratorFactory(mgf, unit, reg));
+}
+
+
+// format:
+// unit <instantiations> <models> <candidates> <groundatoms> <eatomcalls> <time> <groundingtime> <eatomtime> <ufstime>
+// rule <rule text>
+// ...
+void EvalProfile::write(std::ostream& o) const
+{
+    o << "% dlvhex evaluation profile: unit instantiations models candidates groundatoms eatomcalls time groundingtime eatomtime ufstime" << std::endl;
+    BOOST_FOREACH (UnitPtr unit, units) {
+        boost::mutex::scoped_lock lock(unit->mutex);
+        const UnitMetrics& m = unit->metrics;
+        o << "unit " << m.instantiations << " " << m.models << " " << m.candidates << " " << m.groundAtoms << " " << m.eatomCalls << " " <<
+            m.time << " " << m.groundingTime << " " << m.eatomTime << " " << m.ufsTime << std::endl;
+        BOOST_FOREACH (const std::string& rule, unit->rules) o << "rule " << rule << std::endl;
+    }
+}
+
+
+void EvalProfile::load(const std::string& fname)
+{
+    std::ifstream in(fname.c_str());
+    if( !in.is_open() )
+        throw FatalError("could not open evaluation profile '" + fname + "'");
+
+    UnitPtr unit;
+    std::string line;
+    unsigned lineno = 0;
+    while( std::getline(in, line) ) {
+        lineno++;
+        if( line.empty() || line[0] == '%' )
+            continue;
+        if( line.substr(0, 5) == "unit " ) {
+            unit.reset(new Unit);
+            UnitMetrics& m = unit->metrics;
+            std::istringstream is(line.substr(5));
+            if( !(is >> m.instantiations >> m.models >> m.candidates >> m.groundAtoms >> m.eatomCalls >>
+            m.time >> m.groundingTime >> m.eatomTime >> m.ufsTime) ) {
+                std::stringstream ss;
+                ss << "evaluation profile '" << fname << "': bad unit in line " << lineno;
+                throw SyntaxError(ss.str());
+            }
+            units.push_back(unit);
+        }
+        else if( line.substr(0, 5) == "rule " && !!unit ) {
+            unit->rules.push_back(line.substr(5));
+            unitOfRule[unit->rules.back()] = unit;
+        }
+        else {
+            std::stringstream ss;
+            ss << "evaluation profile '" << fname << "': unexpected line " << lineno;
+            throw SyntaxError(ss.str());
+        }
+    }
+    LOG(INFO,"loaded evaluation profile with " << units.size() << " units from '" << fname << "'");
+}
+
+
+EvalProfile::Estimate EvalProfile::estimate(const ComponentGraph::ComponentInfo& ci) const
+{
+    Estimate e;
+
+    // count how many rules of the component fall into each profiled unit
+    std::map<UnitPtr, unsigned> overlap;
+    BOOST_FOREACH (const std::string& rule, getRuleTexts(ci)) {
+        std::map<std::string, UnitPtr>::const_iterator it = unitOfRule.find(rule);
+        if( it != unitOfRule.end() ) overlap[it->second]++;
+    }
+
+    typedef std::pair<UnitPtr, unsigned> Overlap;
+    BOOST_FOREACH (const Overlap& ov, overlap) {
+        const UnitMetrics& m = ov.first->metrics;
+        if( m.instantiations == 0 || ov.first->rules.empty() )
+            continue;
+        e.known = true;
+        // times are distributed evenly over the rules of the profiled unit
+        double share = double(ov.second) / double(ov.first->rules.size()) / double(m.instantiations);
+        e.time += m.time * share;
+        e.groundingTime += m.groundingTime * share;
+        // a part of a unit has at most as many models as the unit
+        e.models = std::max(e.models, double(m.models) / double(m.instantiations));
+        e.candidates = std::max(e.candidates, double(m.candidates) / double(m.instantiations));
+    }
+    // each model is a candidate
+    e.candidates = std::max(e.candidates, e.models);
+    DBGLOG(DBG,"profile estimate for " << ci << ": known=" << e.known << ", time=" << e.time <<
+        ", grounding=" << e.groundingTime << ", models=" << e.models << ", candidates=" << e.candidates);
+    return e;
+}
+
+
+DLVHEX_NAMESPACE_END
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
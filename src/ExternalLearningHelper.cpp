@@ -89,12 +89,12 @@ Nogood ExternalLearningHelper::DefaultInputNogoodProvider::operator()(const Plug
         if (!prop.doesProvidePartialAnswer() || !query.assigned || query.assigned->getFact(*en)) {
             if (query.interpretation->getFact(*en) != negateMonotonicity) {
                 // positive
-                if (!prop.isAntimonotonic(index) || !query.ctx->config.getOption("ExternalLearningMonotonicity")) {
+                if (!prop.isAntimonotonic(index) || !query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_MONOTONICITY)) {
                     extNgInput.insert(NogoodContainer::createLiteral(*en, query.interpretation->getFact(*en)));
                 }
             } else {
                 // negative
-                if (!prop.isMonotonic(index) || !query.ctx->config.getOption("ExternalLearningMonotonicity")) {
+                if (!prop.isMonotonic(index) || !query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_MONOTONICITY)) {
                     extNgInput.insert(NogoodContainer::createLiteral(*en, query.interpretation->getFact(*en)));
                 }
             }
@@ -121,7 +121,7 @@ Set<ID> ExternalLearningHelper::getOutputAtoms(const PluginAtom::Query& query, c
     replacement.tuple.resize(1);
     replacement.tuple[0] = query.ctx->registry()->getAuxiliaryConstantSymbol(sign ? 'r' : 'n', query.ctx->registry()->eatoms.getByID(query.eatomID).predicate);
 
-    if (query.ctx->config.getOption("IncludeAuxInputInAuxiliaries") && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
+    if (query.ctx->config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
         //		replacement.tuple.push_back(query.ctx->registry()->storeVariableTerm("X"));
         //		replacement.kind |= ID::SUBKIND_ATOM_ORDINARYN;
         replacement.tuple.push_back(query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate);
@@ -154,7 +154,7 @@ ID ExternalLearningHelper::getOutputAtom(const PluginAtom::Query& query, Tuple o
     else replacement.kind |= ID::SUBKIND_ATOM_ORDINARYN;
     replacement.tuple.resize(1);
     replacement.tuple[0] = query.ctx->registry()->getAuxiliaryConstantSymbol(sign ? 'r' : 'n', query.ctx->registry()->eatoms.getByID(query.eatomID).predicate);
-    if (query.ctx->config.getOption("IncludeAuxInputInAuxiliaries") && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
+    if (query.ctx->config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
         //		replacement.tuple.push_back(query.ctx->registry()->storeVariableTerm("X"));
         //		replacement.kind |= ID::SUBKIND_ATOM_ORDINARYN;
         replacement.tuple.push_back(query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate);
@@ -184,7 +184,7 @@ ID ExternalLearningHelper::getOutputAtom(const PluginAtom::Query& query, const T
     else replacement.kind |= ID::SUBKIND_ATOM_ORDINARYN;
     replacement.tuple.resize(1);
     replacement.tuple[0] = query.ctx->registry()->getAuxiliaryConstantSymbol(sign ? 'r' : 'n', query.ctx->registry()->eatoms.getByID(query.eatomID).predicate);
-    if (query.ctx->config.getOption("IncludeAuxInputInAuxiliaries") && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
+    if (query.ctx->config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
         //		replacement.tuple.push_back(query.ctx->registry()->storeVariableTerm("X"));
         //		replacement.kind |= ID::SUBKIND_ATOM_ORDINARYN;
         replacement.tuple.push_back(query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate);
@@ -283,7 +283,7 @@ Nogood ExternalLearningHelper::getMinimalConflict(Tuple t, const PluginAtom::Que
 
         PluginAtom::Answer ans;
 
-        query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+        query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
         Set<ID> ansout = ExternalLearningHelper::getOutputAtoms(qa, ans, false);
 
@@ -336,7 +336,7 @@ Nogood ExternalLearningHelper::getMinimalConflict(Tuple t, const PluginAtom::Que
 
 void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Query& query, const PluginAtom::Answer& answer, const ExtSourceProperties& prop, NogoodContainerPtr nogoods, InputNogoodProviderConstPtr inp) {
     if (nogoods) {
-        DBGLOG(DBG, "External Learning: IOBehavior" << (query.ctx->config.getOption("ExternalLearningMonotonicity") ? " by exploiting monotonicity" : ""));
+        DBGLOG(DBG, "External Learning: IOBehavior" << (query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_MONOTONICITY) ? " by exploiting monotonicity" : ""));
 
         // containers for storing nogoods that still have to be minimized 
         SimpleNogoodContainer newNogoodsContainer;
@@ -359,11 +359,11 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
 
             DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidweakenednumber, "EA-Nogoods from weakened intr.", (weakenedPremiseLiterals > 0 ? 1 : 0));
 
-            if (query.ctx->config.getOption("MinimizeNogoods") && !query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+            if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && !query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
                 // if nogoods should be minimized store them in intermediary container
                 DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
                 newNogoodsContainer.addNogood(extNg);
-            } else if (query.ctx->config.getOption("MinimizeNogoods") && query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+            } else if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
                 DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
                 // if answers w.r.t. the inputs should be cached, input and output atoms have to be stored separately
                 std::pair<Nogood, ID> newNogood(extNgInput, oid);
@@ -374,11 +374,11 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
         }
 
         // nogood minimization without caching answers of external atom
-        if (query.ctx->config.getOption("MinimizeNogoods") && !query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+        if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && !query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
             // iterate through all newly added nogoods
             for (int i = 0; i < newNogoodsContainer.getNogoodCount(); ++i) {
-                if (newNogoodsContainer.getNogood(i).size() <= query.ctx->config.getOption("MinimizationSize")) {
+                if (newNogoodsContainer.getNogood(i).size() <= query.ctx->config.getOption(Configuration::OPTION_MINIMIZATION_SIZE)) {
                     // copy the respective nogood
                     Nogood testNg = newNogoodsContainer.getNogood(i);
                     // store the ID of answer atom that should still be contained in answer after minimization
@@ -390,7 +390,7 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
                         }
                     }
 
-                    if (!query.ctx->config.getOption("MinimizeNogoodsOnConflict") || (!query.inputi || query.inputi->getFact(ansID.address))) {
+                    if (!query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_ON_CONFLICT) || (!query.inputi || query.inputi->getFact(ansID.address))) {
                         DBGLOG(DBG, "Conflicting nogood");
 
                         testNg.erase(ansID);
@@ -430,9 +430,9 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
                                     assigned->clearFact(iid.address);
 
                                     // query
-                                    //if (query.ctx->config.getOption("UseExtAtomCache")) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
+                                    //if (query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE)) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
                                     //else query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieve(qa, ans, NogoodContainerPtr());
-                                    query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+                                    query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
                                     // get all answer atoms
                                     Set<ID> ansout = ExternalLearningHelper::getOutputAtoms(qa, ans, false);
@@ -463,7 +463,7 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
 
 
         // nogood minimization with caching answers of external atom:
-        if (query.ctx->config.getOption("MinimizeNogoods") && query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+        if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
 
             BOOST_FOREACH(ID& iid, extNgInput) {
@@ -471,8 +471,8 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
                 std::map<std::size_t, PluginAtom::Answer> externalEvaluationsCache;
 
                 for (int i = 0; i < newNogoods.size(); ++i) {
-                    if ((!query.ctx->config.getOption("MinimizeNogoodsOnConflict") || (!query.inputi || query.inputi->getFact(newNogoods[i].second.address)))
-                            && (newNogoods[i].first.size() <= query.ctx->config.getOption("MinimizationSize"))) {
+                    if ((!query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_ON_CONFLICT) || (!query.inputi || query.inputi->getFact(newNogoods[i].second.address)))
+                            && (newNogoods[i].first.size() <= query.ctx->config.getOption(Configuration::OPTION_MINIMIZATION_SIZE))) {
                         Nogood testNg = newNogoods[i].first;
 
                         testNg.erase(iid);
@@ -502,9 +502,9 @@ void ExternalLearningHelper::learnFromInputOutputBehavior(const PluginAtom::Quer
                             DBGLOG(DBG, "minimizing nogood " << testNg.getStringRepresentation(query.ctx->registry()) << " from input-output behavior");
 
                             // query
-                            //if (query.ctx->config.getOption("UseExtAtomCache")) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
+                            //if (query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE)) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
                             //else query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieve(qa, ans, NogoodContainerPtr());
-                            query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+                            query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
                             externalEvaluationsCache[testNg.getHash()] = ans;
                         }
@@ -615,7 +615,7 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
 
                 // compare auxiliary predicate input
                 int aux = 0;
-                if (query.ctx->config.getOption("IncludeAuxInputInAuxiliaries")) {
+                if (query.ctx->config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES)) {
                     if (query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate != ID_FAIL) {
                         aux = 1;
                         if (atom.tuple[1] != query.ctx->registry()->eatoms.getByID(query.eatomID).auxInputPredicate) paramMatch = false;
@@ -674,12 +674,12 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
                                 ? extNgInput
                                 : (*inp)(query, prop, false, t);
 
-                        if (query.ctx->config.getOption("MinimizeNogoods") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+                        if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
                             // store the output tuples of the external auxiliary atom for minimization queries
                             ID externalAuxiliaryID = NogoodContainer::createLiteral(posAtomID.address);
                             externalAuxiliaryTable[externalAuxiliaryID] = t;
 
-                            if (query.ctx->config.getOption("MinimizeNogoodsOpt")) {
+                            if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT)) {
                                 // if answers w.r.t. the inputs should be cached, input and output atoms have to be stored separately
                                 std::pair<Nogood, ID> newNogood(extNgInput, externalAuxiliaryID);
                                 newNogoods.push_back(newNogood);
@@ -700,11 +700,11 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
         }
 
         // nogood minimization without caching answers of external atom
-        if (query.ctx->config.getOption("MinimizeNogoods") && !query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+        if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && !query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
             // iterate through all newly added nogoods
             for (int i = 0; i < newNogoodsContainer.getNogoodCount(); ++i) {
-                if (newNogoodsContainer.getNogood(i).size() <= query.ctx->config.getOption("MinimizationSize")) {
+                if (newNogoodsContainer.getNogood(i).size() <= query.ctx->config.getOption(Configuration::OPTION_MINIMIZATION_SIZE)) {
                     // copy the respective nogood
                     Nogood testNg = newNogoodsContainer.getNogood(i);
                     // store the ID of answer atom that should still not be contained in answer after minimization
@@ -716,7 +716,7 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
                         }
                     }
 
-                    if (!query.ctx->config.getOption("MinimizeNogoodsOnConflict") || (!query.inputi || query.inputi->getFact(ansID.address))) {
+                    if (!query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_ON_CONFLICT) || (!query.inputi || query.inputi->getFact(ansID.address))) {
                         DBGLOG(DBG, "Conflicting nogood");
 
                         testNg.erase(ansID);
@@ -757,9 +757,9 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
                                     assigned->clearFact(iid.address);
 
                                     // query
-                                    //if (query.ctx->config.getOption("UseExtAtomCache")) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
+                                    //if (query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE)) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
                                     //else query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieve(qa, ans, NogoodContainerPtr());
-                                    query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+                                    query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
                                     Tuple t = externalAuxiliaryTable[ansID];
 
@@ -789,7 +789,7 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
         }
 
         // nogood minimization with caching answers of external atom:
-        if (query.ctx->config.getOption("MinimizeNogoods") && query.ctx->config.getOption("MinimizeNogoodsOpt") && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
+        if (query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS) && query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_OPT) && !inp->dependsOnOutputTuple() && prop.doesProvidePartialAnswer()) {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidmin, "Nogood minimization");
 
             BOOST_FOREACH(ID& iid, extNgInput) {
@@ -797,8 +797,8 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
                 std::map<std::size_t, PluginAtom::Answer> externalEvaluationsCache;
 
                 for (int i = 0; i < newNogoods.size(); ++i) {
-                    if (!query.ctx->config.getOption("MinimizeNogoodsOnConflict") || ((!query.inputi || query.inputi->getFact(newNogoods[i].second.address)))
-                            && (newNogoods[i].first.size() <= query.ctx->config.getOption("MinimizationSize"))) {
+                    if (!query.ctx->config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS_ON_CONFLICT) || ((!query.inputi || query.inputi->getFact(newNogoods[i].second.address)))
+                            && (newNogoods[i].first.size() <= query.ctx->config.getOption(Configuration::OPTION_MINIMIZATION_SIZE))) {
                         Nogood testNg = newNogoods[i].first;
 
                         testNg.erase(iid);
@@ -826,9 +826,9 @@ void ExternalLearningHelper::learnFromNegativeAtoms(const PluginAtom::Query& que
                             qa.assigned = assigned;
 
                             // query
-                            //if (query.ctx->config.getOption("UseExtAtomCache")) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
+                            //if (query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE)) query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveCached(qa, ans, NogoodContainerPtr());
                             //else query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieve(qa, ans, NogoodContainerPtr());
-                            query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+                            query.ctx->registry()->eatoms.getByID(query.eatomID).pluginAtom->retrieveFacade(qa, ans, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
                             externalEvaluationsCache[testNg.getHash()] = ans;
                         }
@@ -130,7 +130,7 @@ ID FLPModelGeneratorFactoryBase::createEatomGuessingRule(const ProgramCtx& ctx,
     gpMask.addPredicate(pospredicate);
     gnMask.addPredicate(negpredicate);
 
-    if (ctx.config.getOption("IncludeAuxInputInAuxiliaries") && eatom.auxInputPredicate != ID_FAIL)
+    if (ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && eatom.auxInputPredicate != ID_FAIL)
         replacement.tuple.push_back(eatom.auxInputPredicate);
 
     // build (nonground) replacement and harvest all variables
@@ -467,7 +467,7 @@ SimpleNogoodContainerPtr nc)
     if( !evaluateExternalAtoms(
         ctx, factory.innerEatoms,
         candidateCompatibleSet, cb,
-    ctx.config.getOption("ExternalLearning") ? nc : SimpleNogoodContainerPtr())) {
+    ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? nc : SimpleNogoodContainerPtr())) {
         return false;
     }
 
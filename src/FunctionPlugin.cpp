@@ -298,9 +298,8 @@ class FunctionComposeAtom : public PluginAtom
         retrieve(const Query& query, Answer& answer) throw (PluginError) {
             Registry &registry = *getRegistry();
 
-            Term t(ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED, query.input, getRegistry());
-            ID tid = registry.terms.getIDByString(t.symbol);
-            if (tid == ID_FAIL) tid = registry.terms.storeAndGetID(t);
+            // looked up by function symbol and arguments, the text is only created for new terms
+            ID tid = registry.storeNestedTerm(query.input);
             Tuple tuple;
             tuple.push_back(tid);
             answer.get().push_back(tuple);
@@ -473,7 +472,7 @@ class FunctionInterprete : public PluginAtom
                     Tuple empty;
                     PluginAtom::Query nquery(query.ctx, query.interpretation, args, empty, ID_FAIL, query.predicateInputMask, query.assigned, query.changed);
                     PluginAtom::Answer nanswer;
-                    pa->retrieveFacade(nquery, nanswer, NogoodContainerPtr(), query.ctx->config.getOption("UseExtAtomCache"));
+                    pa->retrieveFacade(nquery, nanswer, NogoodContainerPtr(), query.ctx->config.getOption(Configuration::OPTION_USE_EXTATOM_CACHE));
 
                     // transfer answer
                     if (nanswer.get().size() != 1) throw PluginError("Function must return exactly one value");
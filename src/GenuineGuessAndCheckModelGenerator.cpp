@@ -234,10 +234,10 @@ guessingProgram(factory.reg)
         DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidhexground, "HEX grounder time");
 
         // with trans-unit learning, outer external atoms must not be facts to make sure that inconsistency analysis finds the reasons for them being true
-        if (factory.ctx.config.getOption("TransUnitLearning")){
+        if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
             InterpretationPtr oea(new Interpretation(reg));
             IntegrateExternalAnswerIntoInterpretationCB cb(oea);
-            int mnsetting = factory.ctx.config.getOption("MinimizeNogoods");
+            int mnsetting = factory.ctx.config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS);
             if (factory.ctx.config.getOption("TransUnitLearningMN") &&
                 ((float)factory.inconsistentEvaluationCnt * 100.0f / (float)factory.evaluationCnt >= (float)factory.ctx.config.getOption("TransUnitLearningAT"))) {
                     factory.ctx.config.setOption("MinimizeNogoods", 1);
@@ -282,7 +282,7 @@ guessingProgram(factory.reg)
 //    deinput->add(*postprocInput);
     std::vector<ID> solverAssumptions;
 //    std::vector<ID> deidb = factory.deidb;
-    if (factory.ctx.config.getOption("TransUnitLearning")){
+    if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
         initializeInconsistencyExplanationAtoms();
 /*
         // we add a guess of the truth value of all explanation atoms and enforce its truth value in the facts using assumptions.
@@ -318,7 +318,7 @@ guessingProgram(factory.reg)
 /*
         // evaluate pseudo-inner external atoms (external atoms which are intentionally handled as inner although they depend only on predecessor units)
         std::vector<ID> pseudoInnerExternalAtoms;
-        if( factory.ctx.config.getOption("NoOuterExternalAtoms") && factory.ctx.config.getOption("ExternalLearning") ) {
+        if( factory.ctx.config.getOption("NoOuterExternalAtoms") && factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ) {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidtulearning, "genuine g&c evaluate pseudo-inner external atoms");
             BOOST_FOREACH (ID eatomID, factory.innerEatoms) {
                 const ExternalAtom& eatom = reg->eatoms.getByID(eatomID);
@@ -337,12 +337,12 @@ guessingProgram(factory.reg)
         }
 */
 
-        InterpretationConstPtr domPredictaesExtension = computeExtensionOfDomainPredicates(factory.ctx, postprocInput, factory.deidb, factory.deidbInnerEatoms /*, pseudoInnerExternalAtoms*/);
+        InterpretationConstPtr domPredictaesExtension = computeExtensionOfDomainPredicates(factory.ctx, postprocInput, factory.deidb, factory.deidbInnerEatoms, std::vector<ID>() /*pseudoInnerExternalAtoms*/, &factory.domainExplorationCache);
         postprocInput->add(*domPredictaesExtension);
 
 /*
         // evaluate pseudo-inner external atoms
-        int mnsetting = factory.ctx.config.getOption("MinimizeNogoods");
+        int mnsetting = factory.ctx.config.getOption(Configuration::OPTION_MINIMIZE_NOGOODS);
 //        factory.ctx.config.setOption("MinimizeNogoods", 1);
         BOOST_FOREACH (ID eatomID, pseudoInnerExternalAtoms) {
             DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidevalpseudoinnereatom, "Evaluated pseudo-inner eatoms", 1);
@@ -391,7 +391,7 @@ guessingProgram(factory.reg)
 
     {
         // update nogoods learned from successor (add all ground atoms which have been added to the registry in the meantime in negative form) and add their atoms to the explanation atoms
-        if (factory.ctx.config.getOption("TransUnitLearning")){
+        if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidtulearning, "genuine g&c init transunit learning");
 
             typedef std::pair<Nogood, int> NogoodIntegerPair;
@@ -427,7 +427,7 @@ guessingProgram(factory.reg)
     // support sets and nonground nogoods initialization
     learnedEANogoodsTransferredIndex = 0;
     nogoodGrounder = NogoodGrounderPtr(new ImmediateNogoodGrounder(factory.ctx.registry(), learnedEANogoods, learnedEANogoods, annotatedGroundProgram));
-    if(factory.ctx.config.getOption("NoPropagator") == 0) {
+    if(factory.ctx.config.getOption(Configuration::OPTION_NO_PROPAGATOR) == 0) {
         DBGLOG(DBG, "Adding propagator to solver");
         solver->addPropagator(this);
     }
@@ -438,8 +438,8 @@ guessingProgram(factory.reg)
     //     Concerning the last parameter, note that clasp backend uses choice rules for implementing disjunctions:
     //     this must be regarded in UFS checking (see examples/trickyufs.hex)
     ufscm = UnfoundedSetCheckerManagerPtr(new UnfoundedSetCheckerManager(*this, factory.ctx, annotatedGroundProgram,
-        factory.ctx.config.getOption("GenuineSolver") >= 3,
-        factory.ctx.config.getOption("ExternalLearning") ? learnedEANogoods : SimpleNogoodContainerPtr()));
+        factory.ctx.config.getOption(Configuration::OPTION_GENUINE_SOLVER) >= 3,
+        factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? learnedEANogoods : SimpleNogoodContainerPtr()));
 
     initializeHeuristics();
     initializeVerificationWatchLists();
@@ -882,7 +882,7 @@ InterpretationPtr GenuineGuessAndCheckModelGenerator::generateNextModel()
         DBGLOG(DBG, "Statistics:" << std::endl << solver->getStatistics());
         if( !modelCandidate ) {
             // compute reasons
-            if (factory.ctx.config.getOption("TransUnitLearning") && cmModelCount == 0) {
+            if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING) && cmModelCount == 0) {
                 factory.inconsistentEvaluationCnt++;
                 if ((float)factory.inconsistentEvaluationCnt * 100.0f / (float)factory.evaluationCnt >= (float)factory.ctx.config.getOption("TransUnitLearningAT")) identifyInconsistencyCause();
             }
@@ -1247,7 +1247,7 @@ std::cerr << std::endl;
     }
 
     // learn from successor units
-    if (factory.ctx.config.getOption("TransUnitLearning")){
+    if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
         DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidiic5, "iIC learnsucc");
         typedef std::pair<Nogood, int> NogoodIntegerPair;
         DBGLOG(DBG, "[IR] Adding nogoods from successor to inconsistency analyzer");
@@ -1297,14 +1297,14 @@ const Nogood* GenuineGuessAndCheckModelGenerator::getInconsistencyCause(){
     DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidic, "Unit inconsistency causes", (haveInconsistencyCause ? 1 : 0));
     printUnitInfo("[IR] ");
     DBGLOG(DBG, "[IR] Inconsistency cause was requested: " << (haveInconsistencyCause ? "" : "not") << " available");
-    return (factory.ctx.config.getOption("TransUnitLearning") && haveInconsistencyCause ? &inconsistencyCause : 0);
+    return (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING) && haveInconsistencyCause ? &inconsistencyCause : 0);
 }
 
 void GenuineGuessAndCheckModelGenerator::addNogood(const Nogood* cause){
     DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidna, "Nogoods added from outside to GnC mg", 1);
     printUnitInfo("[IR] ");
     DBGLOG(DBG, "[IR] Adding nogood to model generator: " << cause->getStringRepresentation(factory.ctx.registry()));
-    if (factory.ctx.config.getOption("TransUnitLearning")){
+    if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
         if (!!solver) solver->addNogood(*cause);
     }
 }
@@ -1339,7 +1339,7 @@ void GenuineGuessAndCheckModelGenerator::generalizeNogood(Nogood ng)
 void GenuineGuessAndCheckModelGenerator::learnSupportSets()
 {
 
-    if (factory.ctx.config.getOption("SupportSets")) {
+    if (factory.ctx.config.getOption(Configuration::OPTION_SUPPORT_SETS)) {
         SimpleNogoodContainerPtr potentialSupportSets = SimpleNogoodContainerPtr(new SimpleNogoodContainer());
         SimpleNogoodContainerPtr supportSets = SimpleNogoodContainerPtr(new SimpleNogoodContainer());
         for(unsigned eaIndex = 0; eaIndex < activeInnerEatoms.size(); ++eaIndex) {
@@ -1450,7 +1450,7 @@ InterpretationConstPtr changed)
             // we cannot use i==1 because of learnedEANogoods.clear() below in this function
             static bool first = true;
             if( first ) {
-                if (factory.ctx.config.getOption("GenuineSolver") >= 3) {
+                if (factory.ctx.config.getOption(Configuration::OPTION_GENUINE_SOLVER) >= 3) {
                     LOG(DBG, "( NOTE: With clasp backend, learned nogoods become effective with a delay because of multithreading! )");
                 }
                 else {
@@ -1467,12 +1467,12 @@ InterpretationConstPtr changed)
                 filev << ng.getStringRepresentation(reg) << std::endl;
             }
             solver->addNogood(ng);
-            if (factory.ctx.config.getOption("TransUnitLearning")) {
+            if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)) {
                 DBGLOG(DBG, "[IR] Adding learned nogood to inconsistency analyzer: " << ng.getStringRepresentation(reg));
                 analysissolverNogoods->addNogood(ng);
             }
 
-            if ( factory.ctx.config.getOption("ExternalAtomVerificationFromLearnedNogoods") ) {
+            if ( factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS) ) {
                 eavTree.addNogood(ng, reg, true);
                 DBGLOG(DBG, "Adding nogood " << ng.getStringRepresentation(reg) << "; to verification tree; updated tree:" << std::endl << eavTree.toString(reg));
             }
@@ -1503,8 +1503,8 @@ bool GenuineGuessAndCheckModelGenerator::finalCompatibilityCheck(InterpretationC
 
     compatible = true;
     for (uint32_t eaIndex = 0; eaIndex < activeInnerEatoms.size(); ++eaIndex) {
-        DBGLOG(DBG, "NoPropagator: " << factory.ctx.config.getOption("NoPropagator") << ", eaEvaluated[" << eaIndex << "]=" << eaEvaluated[eaIndex]);
-        assert(!(factory.ctx.config.getOption("NoPropagator") && eaEvaluated[eaIndex]) && "Verification result was stored for later usage although NoPropagator property was set");
+        DBGLOG(DBG, "NoPropagator: " << factory.ctx.config.getOption(Configuration::OPTION_NO_PROPAGATOR) << ", eaEvaluated[" << eaIndex << "]=" << eaEvaluated[eaIndex]);
+        assert(!(factory.ctx.config.getOption(Configuration::OPTION_NO_PROPAGATOR) && eaEvaluated[eaIndex]) && "Verification result was stored for later usage although NoPropagator property was set");
         if (eaEvaluated[eaIndex] == true && eaVerified[eaIndex] == true) {
         }
         if (eaEvaluated[eaIndex] == true && eaVerified[eaIndex] == false) {
@@ -1547,7 +1547,7 @@ bool GenuineGuessAndCheckModelGenerator::isModel(InterpretationConstPtr compatib
             DBGLOG(DBG, "FLP Check");
             // do FLP check (possibly with nogood learning) and add the learned nogoods to the main search
             bool result = isSubsetMinimalFLPModel<GenuineSolver>(compatibleSet, postprocessedInput, factory.ctx,
-                factory.ctx.config.getOption("ExternalLearning") ? learnedEANogoods : SimpleNogoodContainerPtr());
+                factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? learnedEANogoods : SimpleNogoodContainerPtr());
             updateEANogoods(compatibleSet);
             return result;
         }
@@ -1659,7 +1659,7 @@ bool GenuineGuessAndCheckModelGenerator::unfoundedSetCheck(InterpretationConstPt
     if (performCheck) {
         std::vector<IDAddress> ufs = ufscm->getUnfoundedSet(partialInterpretation,
             (partial ? ufsCheckHeuristics->getSkipProgram() : emptySkipProgram),
-            factory.ctx.config.getOption("ExternalLearning") ? learnedEANogoods : SimpleNogoodContainerPtr());
+            factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? learnedEANogoods : SimpleNogoodContainerPtr());
         bool ufsFound = (ufs.size() > 0);
         #ifndef NDEBUG
         std::stringstream ss;
@@ -1682,7 +1682,7 @@ bool GenuineGuessAndCheckModelGenerator::unfoundedSetCheck(InterpretationConstPt
             }
             #endif
             solver->addNogood(ng);
-            if (factory.ctx.config.getOption("TransUnitLearning")) analysissolverNogoods->addNogood(ng);
+            if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)) analysissolverNogoods->addNogood(ng);
         }
         return !ufsFound;
     }
@@ -1838,7 +1838,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtom(int eaIndex, Interpr
     const ExternalAtom& eatom = reg->eatoms.getByID(activeInnerEatoms[eaIndex]);
 
     // if support sets are enabled, and the external atom provides complete support sets, we use them for verification
-    if (!assigned && !changed && factory.ctx.config.getOption("SupportSets") &&
+    if (!assigned && !changed && factory.ctx.config.getOption(Configuration::OPTION_SUPPORT_SETS) &&
         (eatom.getExtSourceProperties().providesCompletePositiveSupportSets() || eatom.getExtSourceProperties().providesCompleteNegativeSupportSets()) &&
     annotatedGroundProgram.allowsForVerificationUsingCompleteSupportSets()) {
         if (answeredFromCacheOrSupportSets) *answeredFromCacheOrSupportSets = true;
@@ -1854,7 +1854,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
 {
     assert (!!partialInterpretation && "interpretation not set");
 
-    if (factory.ctx.config.getOption("ExternalAtomVerificationFromLearnedNogoods")) {
+    if (factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS)) {
         DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sideav, "gen. g&c verifyEAtom by eav (attempt)");
         InterpretationConstPtr verifiedAuxes = eavTree.getVerifiedAuxiliaries(partialInterpretation, assigned, factory.ctx.registry());
 
@@ -1889,7 +1889,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
 
         DBGLOG(DBG, "Assigning all auxiliary inputs");
         InterpretationConstPtr evalIntr = partialInterpretation;
-        if (!factory.ctx.config.getOption("IncludeAuxInputInAuxiliaries")) {
+        if (!factory.ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES)) {
             // make sure that ALL input auxiliary atoms are true, otherwise we might miss some output atoms and consider true output atoms wrongly as unfounded
             // clone and extend
             InterpretationPtr ncevalIntr(new Interpretation(*partialInterpretation));
@@ -1907,7 +1907,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
         if (factory.ctx.config.getOption("EAEvalDebounce") != 1.0) {
             int nogoodCount = learnedEANogoods->getNogoodCount();
             evaluateExternalAtom(factory.ctx, activeInnerEatoms[eaIndex], evalIntr, vcb,
-            factory.ctx.config.getOption("ExternalLearning") ? learnedEANogoods : NogoodContainerPtr(), assigned, changed, answeredFromCache);
+            factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? learnedEANogoods : NogoodContainerPtr(), assigned, changed, answeredFromCache);
             std::set<ID> answers;
             
             for (int i = nogoodCount; i < learnedEANogoods->getNogoodCount(); ++i) {
@@ -1931,7 +1931,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
             updateEANogoods(partialInterpretation, assigned, changed);
         } else {
             evaluateExternalAtom(factory.ctx, activeInnerEatoms[eaIndex], evalIntr, vcb,
-            factory.ctx.config.getOption("ExternalLearning") ? learnedEANogoods : NogoodContainerPtr(), assigned, changed, answeredFromCache);
+            factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) ? learnedEANogoods : NogoodContainerPtr(), assigned, changed, answeredFromCache);
             updateEANogoods(partialInterpretation, assigned, changed);
         }
 
@@ -1944,7 +1944,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
             DBGLOG(DBG, "Verifying " << activeInnerEatoms[eaIndex] << " (Result: " << eaVerified[eaIndex] << ")");
 
             // generate nogoods for falsified external atom auxiliaries
-            if (!eaVerified[eaIndex] && factory.ctx.config.getOption("TransUnitLearning")){
+            if (!eaVerified[eaIndex] && factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)){
                 Nogood ng;
                 bm::bvector<>::enumerator en = annotatedGroundProgram.getEAMask(eaIndex)->mask()->getStorage().first();
                 bm::bvector<>::enumerator en_end = annotatedGroundProgram.getEAMask(eaIndex)->mask()->getStorage().end();
@@ -1956,11 +1956,11 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomByEvaluation(int eaIn
                 }
                 ng.insert(NogoodContainer::createLiteral(vcb.getFalsifiedAtom().address, partialInterpretation->getFact(vcb.getFalsifiedAtom().address)));
                 DBGLOG(DBG, "[IR] Adding nogood for falsified external atom: " << ng.getStringRepresentation(factory.ctx.registry()));
-                if (factory.ctx.config.getOption("TransUnitLearning")) analysissolverNogoods->addNogood(ng);
+                if (factory.ctx.config.getOption(Configuration::OPTION_TRANS_UNIT_LEARNING)) analysissolverNogoods->addNogood(ng);
             }
 
             // we remember that we evaluated, only if there is a propagator that can undo this memory (that can unverify an eatom during model search)
-            if(factory.ctx.config.getOption("NoPropagator") == 0) {
+            if(factory.ctx.config.getOption(Configuration::OPTION_NO_PROPAGATOR) == 0) {
                 DBGLOG(DBG, "Setting external atom status of " << eaIndex << " to evaluated");
                 eaEvaluated[eaIndex] = true;
                if (eaVerified[eaIndex]) verifiedAuxes->getStorage() |= annotatedGroundProgram.getEAMask(eaIndex)->mask()->getStorage();
@@ -1985,7 +1985,7 @@ bool GenuineGuessAndCheckModelGenerator::verifyExternalAtomBySupportSets(int eaI
     if (eaVerified[eaIndex]) verifiedAuxes->getStorage() |= annotatedGroundProgram.getEAMask(eaIndex)->mask()->getStorage();
 
     // we remember that we evaluated, only if there is a propagator that can undo this memory (that can unverify an eatom during model search)
-    if( factory.ctx.config.getOption("NoPropagator") == 0 ) {
+    if( factory.ctx.config.getOption(Configuration::OPTION_NO_PROPAGATOR) == 0 ) {
         DBGLOG(DBG, "Setting external atom status of " << eaIndex << " to evaluated");
         eaEvaluated[eaIndex] = true;
     }
@@ -43,8 +43,10 @@
 #include "dlvhex2/GringoGrounder.h"
 #include "dlvhex2/Rule.h"
 #include "dlvhex2/Benchmarking.h"
+#include "dlvhex2/GroundProgramCache.h"
 
 #include <boost/tokenizer.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <iostream>
 #include <sstream>
@@ -64,6 +66,15 @@ using dlvhex::ID;
 
 DLVHEX_NAMESPACE_BEGIN
 
+namespace
+{
+    boost::mutex& gringoMutex()
+    {
+        static boost::mutex mutex;
+        return mutex;
+    }
+}
+
 void GringoGrounder::Printer::printRule(ID id)
 {
 
@@ -351,8 +362,19 @@ void GringoGrounder::GroundHexProgramBuilder::transformRules()
         groundProgram.idb.clear();
         groundProgram.idb.reserve(rules.size());
     }
-    BOOST_FOREACH (const LParseRule& lpr, rules) {
-        Rule r(ID::MAINKIND_RULE);
+    // consume the buffered lparse rules while converting them, such that the lparse and the HEX version
+    // of the ground program are not kept in memory at the same time
+    // the rule is converted in a scratch rule which is copied into the registry;
+    // reusing it keeps the capacity of its tuples, such that storing a rule
+    // allocates only the tuples of the stored copy
+    Rule r(ID::MAINKIND_RULE);
+    for (; !rules.empty(); rules.pop_front()) {
+        const LParseRule& lpr = rules.front();
+        r.kind = ID::MAINKIND_RULE;
+        r.head.clear();
+        r.body.clear();
+        r.bodyWeightVector.clear();
+        r.bound = ID_FAIL;
         switch (lpr.type) {
             case LParseRule::Weight:
                 r.kind |= ID::SUBKIND_RULE_WEIGHT;
@@ -399,6 +421,8 @@ void GringoGrounder::GroundHexProgramBuilder::transformRules()
                 }
                 else {
                     // rules
+                    r.head.reserve(lpr.head.size());
+                    r.body.reserve(lpr.body.size());
                     BOOST_FOREACH (uint32_t h, lpr.head) {
                         if (h != false_) {
                             addSymbol(h);
@@ -492,7 +516,8 @@ void GringoGrounder::GroundHexProgramBuilder::printSymbol(unsigned atomUid, Grin
     v.print(ss);
     std::string str = ss.str();
 
-    ID dlvhexId = ctx.registry()->ogatoms.getIDByString(str);
+    // without stored text the lookup by string always fails (the atom is looked up by tuple below)
+    ID dlvhexId = ctx.registry()->ogatoms.storesText() ? ctx.registry()->ogatoms.getIDByString(str) : ID_FAIL;
     if( dlvhexId == ID_FAIL ) {
         OrdinaryAtom ogatom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG, str);
 
@@ -526,7 +551,10 @@ void GringoGrounder::GroundHexProgramBuilder::printSymbol(unsigned atomUid, Grin
             if( id.isExternalInputAuxiliary() ) ogatom.kind |= ID::PROPERTY_EXTERNALINPUTAUX;
         }
         assert (ogatom.tuple.size() > 0 && "Cannot store empty atom");
-        dlvhexId = ctx.registry()->ogatoms.storeAndGetID(ogatom);
+        // the text index is optional (see OrdinaryAtomTable::setStoreText)
+        dlvhexId = ctx.registry()->ogatoms.getIDByTuple(ogatom.tuple);
+        if( dlvhexId == ID_FAIL )
+            dlvhexId = ctx.registry()->ogatoms.storeAndGetID(ogatom);
 
         GPDBGLOG(DBG, "Registered atom " << str << " (arity " << (ogatom.tuple.size() - 1) << ") with tuple " << printvector(ogatom.tuple) << " and Gringo-ID " << atomUid << " and dlvhex-ID " << dlvhexId);
     }
@@ -580,6 +608,9 @@ struct EmptyMod : public Gringo::GringoModule {
 
 int GringoGrounder::doRun()
 {
+    // gringo keeps global state (message printer, std::cerr redirection),
+    // so grounders of units which are evaluated in parallel must not overlap
+    boost::mutex::scoped_lock lock(gringoMutex());
     DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidgroundertime, "Grounder time");
 
     try
@@ -634,6 +665,18 @@ int GringoGrounder::doRun()
 
         LOG(DBG, "Sending the following input to Gringo: {{" << programStream->str() << "}}");
 
+        // reuse the ground program of a previous run with the same grounder input
+        GroundProgramCache cache(ctx);
+        std::string cacheKey;
+        if (cache.enabled()) {
+            cacheKey = programStream->str();
+            if (cache.load(cacheKey, groundProgram)) {
+                DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidcachehit, "Ground programs from cache", 1);
+                delete programStream;
+                return EXIT_SUCCESS;
+            }
+        }
+
         // grounding
         //parser.pushStream("s1", std::unique_ptr<std::stringstream>(new std::stringstream("a | b.")));
         parser.pushStream("dlvhex", std::unique_ptr<std::stringstream>(programStream));
@@ -648,6 +691,8 @@ int GringoGrounder::doRun()
         out.finish();
         outputter.transformRules();
 
+        if (cache.enabled()) cache.store(cacheKey, groundProgram, nongroundProgram.mask);
+
         #if 0
         // adding new modules incrementally can be done by repeating the above code as follows:
         // (previously defined atoms need to be defined as external in order to prevent them from being optimized away)
@@ -712,6 +757,7 @@ DLVHEX_NAMESPACE_END
 #ifdef HAVE_LIBGRINGO
 
 #include "dlvhex2/GringoGrounder.h"
+#include "dlvhex2/GroundProgramCache.h"
 #include <gringo/inclit.h>
 #include <gringo/parser.h>
 #include <gringo/converter.h>
@@ -1026,8 +1072,19 @@ void GringoGrounder::GroundHexProgramBuilder::doFinalize()
     groundProgram.edb = edb;
     groundProgram.idb.clear();
     groundProgram.idb.reserve(rules.size());
-    BOOST_FOREACH (const LParseRule& lpr, rules) {
-        Rule r(ID::MAINKIND_RULE);
+    // consume the buffered lparse rules while converting them, such that the lparse and the HEX version
+    // of the ground program are not kept in memory at the same time
+    // the rule is converted in a scratch rule which is copied into the registry;
+    // reusing it keeps the capacity of its tuples, such that storing a rule
+    // allocates only the tuples of the stored copy
+    Rule r(ID::MAINKIND_RULE);
+    for (; !rules.empty(); rules.pop_front()) {
+        const LParseRule& lpr = rules.front();
+        r.kind = ID::MAINKIND_RULE;
+        r.head.clear();
+        r.body.clear();
+        r.bodyWeightVector.clear();
+        r.bound = ID_FAIL;
         switch (lpr.type) {
             case LParseRule::Weight:
                 r.kind |= ID::SUBKIND_RULE_WEIGHT;
@@ -1074,6 +1131,8 @@ void GringoGrounder::GroundHexProgramBuilder::doFinalize()
                 }
                 else {
                     // rules
+                    r.head.reserve(lpr.head.size());
+                    r.body.reserve(lpr.pos.size() + lpr.neg.size());
                     BOOST_FOREACH (uint32_t h, lpr.head) {
                         if (h != false_) {
                             addSymbol(h);
@@ -1198,7 +1257,8 @@ void GringoGrounder::GroundHexProgramBuilder::printSymbolTableEntry(const AtomRe
     assert(symbolstarts.size() == arity+1);
     OrdinaryAtom ogatom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG, ss.str());
 
-    ID dlvhexId = ctx.registry()->ogatoms.getIDByString(ogatom.text);
+    // without stored text the lookup by string always fails (the atom is looked up by tuple below)
+    ID dlvhexId = ctx.registry()->ogatoms.storesText() ? ctx.registry()->ogatoms.getIDByString(ogatom.text) : ID_FAIL;
 
     if( dlvhexId == ID_FAIL ) {
         // parse groundatom, register and store
@@ -1223,7 +1283,10 @@ void GringoGrounder::GroundHexProgramBuilder::printSymbolTableEntry(const AtomRe
                 lastsymbolstart = symbolstarts[symidx];
             }
         }
-        dlvhexId = ctx.registry()->ogatoms.storeAndGetID(ogatom);
+        // the text index is optional (see OrdinaryAtomTable::setStoreText)
+        dlvhexId = ctx.registry()->ogatoms.getIDByTuple(ogatom.tuple);
+        if( dlvhexId == ID_FAIL )
+            dlvhexId = ctx.registry()->ogatoms.storeAndGetID(ogatom);
     }
 
     indexToGroundAtomID[atom.first] = dlvhexId;
@@ -1280,6 +1343,9 @@ Streams::StreamPtr GringoGrounder::constStream() const
 
 int GringoGrounder::doRun()
 {
+    // gringo keeps global state (message printer, std::cerr redirection),
+    // so grounders of units which are evaluated in parallel must not overlap
+    boost::mutex::scoped_lock lock(gringoMutex());
     DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidgroundertime, "Grounder time");
 
     // redirect std::cerr output to temporary string because gringo spams std:cerr with lots of useless warnings
@@ -1323,6 +1389,19 @@ int GringoGrounder::doRun()
 
         LOG(DBG, "Sending the following input to Gringo: {{" << programStream.str() << "}}");
 
+        // reuse the ground program of a previous run with the same grounder input
+        GroundProgramCache cache(ctx);
+        std::string cacheKey;
+        if (cache.enabled()) {
+            cacheKey = programStream.str();
+            if (cache.load(cacheKey, groundProgram)) {
+                DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidcachehit, "Ground programs from cache", 1);
+                if( origcerr != NULL )
+                    std::cerr.rdbuf(origcerr);
+                return EXIT_SUCCESS;
+            }
+        }
+
         // grounding
         std::auto_ptr<Output> o(output());
         Streams inputStreams;
@@ -1355,6 +1434,8 @@ int GringoGrounder::doRun()
             o->finalize();
         }
 
+        if (cache.enabled()) cache.store(cacheKey, groundProgram, nongroundProgram.mask);
+
         // restore cerr output
         if( origcerr != NULL ) {
             std::cerr.rdbuf(origcerr);
@@ -0,0 +1,393 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   GroundProgramCache.cpp
+ *
+ * @brief  On-disk cache of ground programs of evaluation units.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/GroundProgramCache.h"
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/Logger.h"
+#include "dlvhex2/Printer.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Term.h"
+#include "dlvhex2/Benchmarking.h"
+
+#include <boost/foreach.hpp>
+#include <boost/unordered_map.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
+DLVHEX_NAMESPACE_BEGIN
+
+namespace
+{
+    // file layout (all numbers are uint32_t in host byte order, strings are prefixed by their length):
+    //   magic, version, key,
+    //   #atoms, (kind, address, text)*,
+    //   #facts, atom*,
+    //   #masked atoms, atom*,
+    //   #rules, (kind, bound kind, bound address, #head, atom*, #body, (atom << 1 | naf)*, #weights, weight*)*
+    // where atom is an index into the atom list of the file and address is the one of the atom when it was stored
+    // (the bound is stored with its kind, as rules other than weight rules have bound ID_FAIL)
+    const char magic[8] = { 'D', 'L', 'V', 'H', 'E', 'X', 'G', 'P' };
+    const uint32_t formatVersion = 3;
+
+    void writeUInt(std::ostream& o, uint32_t value)
+    {
+        o.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(std::ostream& o, const std::string& str)
+    {
+        writeUInt(o, str.size());
+        o.write(str.data(), str.size());
+    }
+
+    // reads from a memory-mapped cache file; reading beyond the end marks the reader as failed
+    class Reader
+    {
+        public:
+            Reader(const char* begin, const char* end): pos(begin), end(end), failed(false) {}
+
+            uint32_t readUInt() {
+                uint32_t value = 0;
+                if (failed || static_cast<std::size_t>(end - pos) < sizeof(value)) {
+                    failed = true;
+                    return 0;
+                }
+                std::memcpy(&value, pos, sizeof(value));
+                pos += sizeof(value);
+                return value;
+            }
+
+            bool readString(const char*& str, uint32_t& len) {
+                len = readUInt();
+                if (failed || static_cast<std::size_t>(end - pos) < len) {
+                    failed = true;
+                    return false;
+                }
+                str = pos;
+                pos += len;
+                return true;
+            }
+
+            // number of elements of a sequence; must not exceed the remaining file size
+            uint32_t readCount() {
+                uint32_t count = readUInt();
+                if (failed || static_cast<std::size_t>(end - pos) / sizeof(uint32_t) < count) {
+                    failed = true;
+                    return 0;
+                }
+                return count;
+            }
+
+            // index into the atom list of the file
+            ID readAtom(const std::vector<ID>& atoms) {
+                uint32_t index = readUInt();
+                if (failed || index >= atoms.size()) {
+                    failed = true;
+                    return ID_FAIL;
+                }
+                return atoms[index];
+            }
+
+            // atom index shifted by one, the lowest bit denotes default-negation
+            ID readLiteral(const std::vector<ID>& atoms) {
+                uint32_t lit = readUInt();
+                if (failed || (lit >> 1) >= atoms.size()) {
+                    failed = true;
+                    return ID_FAIL;
+                }
+                return ID::literalFromAtom(atoms[lit >> 1], (lit & 1) == 1);
+            }
+
+            bool ok() const
+                { return !failed; }
+
+        private:
+            const char* pos;
+            const char* end;
+            bool failed;
+    };
+
+    // number atoms in the order of their first occurrence
+    uint32_t atomIndex(IDAddress adr, std::vector<IDAddress>& atoms, boost::unordered_map<IDAddress, uint32_t>& indices)
+    {
+        boost::unordered_map<IDAddress, uint32_t>::iterator it = indices.find(adr);
+        if (it != indices.end()) return it->second;
+        indices[adr] = atoms.size();
+        atoms.push_back(adr);
+        return atoms.size() - 1;
+    }
+
+    // FNV-1a
+    uint64_t hashKey(const std::string& key)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        BOOST_FOREACH (char c, key) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+}
+
+
+GroundProgramCache::GroundProgramCache(ProgramCtx& ctx):
+ctx(ctx), directory(ctx.config.getStringOption("GroundingCacheDir"))
+{
+}
+
+
+std::string GroundProgramCache::getFileName(const std::string& key) const
+{
+    std::stringstream ss;
+    ss << directory << "/" << std::hex << std::setw(16) << std::setfill('0') << hashKey(key) << ".hexground";
+    return ss.str();
+}
+
+
+ID GroundProgramCache::registerAtom(IDKind kind, const std::string& text)
+{
+    RegistryPtr reg = ctx.registry();
+
+    // parse atom as nested term (see GringoGrounder)
+    // (the atom is looked up by tuple, as the text index is optional)
+    OrdinaryAtom ogatom(kind);
+    Term dummyTerm(ID::MAINKIND_TERM, text);
+    dummyTerm.analyzeTerm(reg);
+    if (dummyTerm.arguments.empty()) {
+        ogatom.tuple.push_back(reg->storeTerm(dummyTerm));
+    }
+    else {
+        ogatom.tuple = dummyTerm.arguments;
+    }
+    assert(ogatom.tuple.size() > 0 && !ogatom.tuple[0].isVariableTerm());
+    if( ogatom.tuple[0].isAuxiliary() ) ogatom.kind |= ID::PROPERTY_AUX;
+    if( ogatom.tuple[0].isExternalAuxiliary() ) ogatom.kind |= ID::PROPERTY_EXTERNALAUX;
+    if( ogatom.tuple[0].isExternalInputAuxiliary() ) ogatom.kind |= ID::PROPERTY_EXTERNALINPUTAUX;
+    return reg->storeOrdinaryGAtom(ogatom);
+}
+
+
+bool GroundProgramCache::load(const std::string& key, OrdinaryASPProgram& groundProgram)
+{
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidload, "GroundProgramCache::load");
+
+    std::string fileName = getFileName(key);
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(fileName);
+    }
+    catch(const std::exception&) {
+        DBGLOG(DBG, "No cached ground program in " << fileName);
+        return false;
+    }
+    if (!file.is_open()) return false;
+
+    Reader reader(file.data(), file.data() + file.size());
+    const char* str;
+    uint32_t len;
+
+    // header and key (the file name is only a hash of the key)
+    if (!reader.readString(str, len) || len != sizeof(magic) || std::memcmp(str, magic, sizeof(magic)) != 0 ||
+        reader.readUInt() != formatVersion) {
+        LOG(WARNING, "Ignoring invalid ground program cache file " << fileName);
+        return false;
+    }
+    if (!reader.readString(str, len) || len != key.size() || std::memcmp(str, key.data(), len) != 0) {
+        DBGLOG(DBG, "Cached ground program in " << fileName << " belongs to a different grounder input");
+        return false;
+    }
+
+    // atoms
+    RegistryPtr reg = ctx.registry();
+    std::vector<ID> atoms(reader.readCount());
+    for (uint32_t i = 0; i < atoms.size() && reader.ok(); ++i) {
+        IDKind kind = reader.readUInt();
+        IDAddress adr = reader.readUInt();
+        if (!reader.readString(str, len)) break;
+        std::string text(str, len);
+        // in the run which stored the program and after restoring a registry snapshot the atom
+        // still has its address, then it need not be parsed and looked up again
+        if (adr < reg->ogatoms.getSize() && reg->ogatoms.getByAddress(adr).kind == kind &&
+            printToString<RawPrinter>(ID(kind, adr), reg) == text) {
+            atoms[i] = ID(kind, adr);
+        }
+        else {
+            atoms[i] = registerAtom(kind, text);
+        }
+    }
+
+    // facts and masked atoms
+    InterpretationPtr edb(new Interpretation(reg));
+    InterpretationPtr mask(new Interpretation(reg));
+    if (!!groundProgram.mask) mask->add(*groundProgram.mask);
+    for (uint32_t n = reader.readCount(); n > 0 && reader.ok(); --n) {
+        ID a = reader.readAtom(atoms);
+        if (reader.ok()) edb->setFact(a.address);
+    }
+    for (uint32_t n = reader.readCount(); n > 0 && reader.ok(); --n) {
+        ID a = reader.readAtom(atoms);
+        if (reader.ok()) mask->setFact(a.address);
+    }
+
+    // rules
+    std::vector<ID> idb(reader.readCount());
+    for (uint32_t i = 0; i < idb.size() && reader.ok(); ++i) {
+        Rule r(ID::MAINKIND_RULE);
+        r.kind = reader.readUInt();
+        r.bound.kind = reader.readUInt();
+        r.bound.address = reader.readUInt();
+        r.head.resize(reader.readCount());
+        BOOST_FOREACH (ID& h, r.head) h = reader.readAtom(atoms);
+        r.body.resize(reader.readCount());
+        BOOST_FOREACH (ID& b, r.body) b = reader.readLiteral(atoms);
+        r.bodyWeightVector.resize(reader.readCount());
+        BOOST_FOREACH (ID& w, r.bodyWeightVector) w = ID::termFromInteger(reader.readUInt());
+        if (!reader.ok() || !ID(r.kind, 0).isRule() || (r.head.empty() && r.body.empty()) ||
+            (r.bound != ID_FAIL && !r.bound.isIntegerTerm()) ||
+            (ID(r.kind, 0).isWeightRule() && r.bodyWeightVector.size() != r.body.size())) {
+            LOG(WARNING, "Ignoring corrupt ground program cache file " << fileName);
+            return false;
+        }
+        idb[i] = reg->storeRule(r);
+    }
+
+    if (!reader.ok()) {
+        LOG(WARNING, "Ignoring truncated or corrupt ground program cache file " << fileName);
+        return false;
+    }
+
+    DBGLOG(DBG, "Loaded ground program with " << idb.size() << " rules from " << fileName);
+    groundProgram.edb = edb;
+    groundProgram.idb.swap(idb);
+    groundProgram.mask = mask;
+    return true;
+}
+
+
+void GroundProgramCache::store(const std::string& key, const OrdinaryASPProgram& groundProgram, InterpretationConstPtr inputMask)
+{
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidstore, "GroundProgramCache::store");
+
+    RegistryPtr reg = ctx.registry();
+
+    // number the atoms of the ground program
+    std::vector<IDAddress> atoms;
+    boost::unordered_map<IDAddress, uint32_t> indices;
+
+    std::vector<uint32_t> facts;
+    if (!!groundProgram.edb) {
+        bm::bvector<>::enumerator en = groundProgram.edb->getStorage().first();
+        bm::bvector<>::enumerator en_end = groundProgram.edb->getStorage().end();
+        for (; en < en_end; ++en) facts.push_back(atomIndex(*en, atoms, indices));
+    }
+    std::vector<uint32_t> masked;
+    if (!!groundProgram.mask) {
+        bm::bvector<> added = groundProgram.mask->getStorage();
+        if (!!inputMask) added -= inputMask->getStorage();
+        bm::bvector<>::enumerator en = added.first();
+        bm::bvector<>::enumerator en_end = added.end();
+        for (; en < en_end; ++en) masked.push_back(atomIndex(*en, atoms, indices));
+    }
+
+    std::stringstream rules;
+    BOOST_FOREACH (ID rid, groundProgram.idb) {
+        const Rule& r = reg->rules.getByID(rid);
+        if (!r.headGuard.empty() || ID(r.kind, 0).isWeakConstraint()) {
+            DBGLOG(DBG, "Ground program contains rules which cannot be cached");
+            return;
+        }
+        writeUInt(rules, r.kind);
+        writeUInt(rules, r.bound.kind);
+        writeUInt(rules, r.bound.address);
+        writeUInt(rules, r.head.size());
+        BOOST_FOREACH (ID h, r.head) writeUInt(rules, atomIndex(h.address, atoms, indices));
+        writeUInt(rules, r.body.size());
+        BOOST_FOREACH (ID b, r.body) writeUInt(rules, atomIndex(b.address, atoms, indices) << 1 | (b.isNaf() ? 1 : 0));
+        writeUInt(rules, r.bodyWeightVector.size());
+        BOOST_FOREACH (ID w, r.bodyWeightVector) writeUInt(rules, w.address);
+    }
+
+    // write to a temporary file first such that concurrent runs never see partial files
+    std::string fileName = getFileName(key);
+    std::stringstream tmpName;
+    tmpName << fileName << "." << getpid() << "." << reinterpret_cast<std::size_t>(this) << ".tmp";
+    {
+        std::ofstream out(tmpName.str().c_str(), std::ios::binary);
+        writeString(out, std::string(magic, sizeof(magic)));
+        writeUInt(out, formatVersion);
+        writeString(out, key);
+        writeUInt(out, atoms.size());
+        BOOST_FOREACH (IDAddress adr, atoms) {
+            const OrdinaryAtom& ogatom = reg->ogatoms.getByAddress(adr);
+            writeUInt(out, ogatom.kind);
+            writeUInt(out, adr);
+            writeString(out, printToString<RawPrinter>(ID(ogatom.kind, adr), reg));
+        }
+        writeUInt(out, facts.size());
+        BOOST_FOREACH (uint32_t a, facts) writeUInt(out, a);
+        writeUInt(out, masked.size());
+        BOOST_FOREACH (uint32_t a, masked) writeUInt(out, a);
+        writeUInt(out, groundProgram.idb.size());
+        out << rules.rdbuf();
+        if (!out) {
+            LOG(WARNING, "Could not write ground program cache file " << tmpName.str());
+            std::remove(tmpName.str().c_str());
+            return;
+        }
+    }
+    if (std::rename(tmpName.str().c_str(), fileName.c_str()) != 0) {
+        LOG(WARNING, "Could not write ground program cache file " << fileName);
+        std::remove(tmpName.str().c_str());
+        return;
+    }
+    DBGLOG(DBG, "Stored ground program with " << groundProgram.idb.size() << " rules in " << fileName);
+}
+
+
+DLVHEX_NAMESPACE_END
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -329,7 +329,7 @@ InterpretationPtr GuessAndCheckModelGenerator::generateNextModel()
         DBGLOG(DBG,"= got guess model " << *modelCandidate);
 
         DBGLOG(DBG, "doing compatibility check for model candidate " << *modelCandidate);
-        assert(!factory.ctx.config.getOption("ExternalLearning") &&
+        assert(!factory.ctx.config.getOption(Configuration::OPTION_EXTERNAL_LEARNING) &&
             "cannot use external learning in (non-genuine) GuessAndCheckModelGenerator");
         bool compatible = isCompatibleSet(
             modelCandidate, postprocessedInput, factory.ctx,
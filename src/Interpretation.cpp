@@ -39,6 +39,7 @@
 #include "dlvhex2/Logger.h"
 #include "dlvhex2/Printer.h"
 #include "dlvhex2/Benchmarking.h"
+#include <bm/bmalgo.h>
 #include <boost/functional/hash.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
@@ -58,7 +59,8 @@ std::size_t hash_value(const Interpretation& intr)
 
 Interpretation::Interpretation(RegistryPtr registry):
 registry(registry),
-bits()
+bits(),
+hashUpdated(false)
 {
 }
 
@@ -224,6 +226,19 @@ bool Interpretation::operator!=(const Interpretation& other) const
 }
 
 
+bool interpretationSubsumes(const Interpretation& super, const Interpretation& sub)
+{
+    return !bm::any_sub(sub.getStorage(), super.getStorage());
+}
+
+
+void compactInterpretation(Interpretation& intr)
+{
+    intr.setBlockStrategy(bm::BM_GAP);
+    intr.getStorage().optimize();
+}
+
+
 bool Interpretation::operator<(const Interpretation& other) const
 {
     return bits < other.bits;
@@ -238,7 +238,7 @@ ID MLPSolver::rewriteOrdinaryAtom(ID oldAtomID, int idxMI)
     // replace the atom text
     atomRnew.text = getAtomTextFromTuple(atomRnew.tuple);
     // try to locate the new atom (the rewritten one)
-    ID atomFind = tbl->getIDByString(atomRnew.text);
+    ID atomFind = tbl->getIDByTuple(atomRnew.tuple);
     DBGLOG(DBG, "[MLPSolver::rewriteOrdinaryAtom] ID atomFind = " << atomFind);
     if (atomFind == ID_FAIL) {
         atomFind = tbl->storeAndGetID(atomRnew);
@@ -413,7 +413,7 @@ void MLPSolver::replacedModuleAtoms(int instIdx, InterpretationPtr& edb, Tuple&
                         // replace the atom text
                         newOutputAtom.text = getAtomTextFromTuple(newOutputAtom.tuple);
                         // try to locate the new atom (the rewritten one)
-                        ID atomFind = tbl->getIDByString(newOutputAtom.text);
+                        ID atomFind = tbl->getIDByTuple(newOutputAtom.tuple);
                         DBGLOG(DBG, "[MLPSolver::replacedModuleAtoms] ID atomFind = " << atomFind);
                         if (atomFind == ID_FAIL) {
                             atomFind = tbl->storeAndGetID(newOutputAtom);
@@ -1029,7 +1029,7 @@ void MLPSolver::restrictionAndRenaming(const Interpretation& intr, const Tuple&
         while ( itA != actualInputs.end() && found == false) {
             if (*itA == predName) {
                                  // if found in the actual input restriction
-                resultRestriction.push_back(registrySolver->ogatoms.getIDByString(atomR.text));
+                resultRestriction.push_back(registrySolver->ogatoms.getIDByAddress(*it));
                 OrdinaryAtom atomRnew = atomR;
                 DBGLOG(DBG, "[MLPSolver::restrictionAndRenaming] atomR: " << atomR);
                 DBGLOG(DBG, "[MLPSolver::restrictionAndRenaming] atomRnew: " << atomRnew);
@@ -2101,10 +2101,12 @@ const Tuple& MLPSolver::getOgatomsInInst(int instIdx)
         instOgatoms.resize( moduleInstTable.size() );
         for (int i=totalSizeInstOgatoms; i<registrySolver->ogatoms.getSize();i++ ) {
             const OrdinaryAtom& oa = registrySolver->ogatoms.getByAddress(i);
-            int n = oa.text.find( MODULEINSTSEPARATOR );
+            // the instance prefix is part of the predicate
+            const std::string text = printToString<RawPrinter>(oa.tuple.front(), registrySolver);
+            int n = text.find( MODULEINSTSEPARATOR );
             if ( n != std::string::npos ) {
                 // MODULEINSTSEPARATOR found
-                std::string pref = oa.text.substr(0, n);
+                std::string pref = text.substr(0, n);
                 pref = pref.substr( 1 );
                 int instIdx = atoi( pref.c_str() );
                 instOgatoms.at(instIdx).push_back( ID(oa.kind, i) );
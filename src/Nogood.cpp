@@ -91,7 +91,7 @@ void Nogood::recomputeHash()
 }
 
 
-size_t Nogood::getHash()
+size_t Nogood::getHash() const
 {
     return hashValue;
 }
@@ -381,6 +381,7 @@ void Nogood::dbgload(std::string str)
 const NogoodSet& NogoodSet::operator=(const NogoodSet& other)
 {
     nogoods = other.nogoods;
+    addCount = other.addCount;
     freeIndices = other.freeIndices;
     nogoodsWithHash = other.nogoodsWithHash;
 
@@ -388,46 +389,60 @@ const NogoodSet& NogoodSet::operator=(const NogoodSet& other)
 }
 
 
+int NogoodSet::findNogood(const Nogood& ng) const
+{
+    typedef boost::unordered_multimap<std::size_t, int>::const_iterator Iterator;
+    std::pair<Iterator, Iterator> range = nogoodsWithHash.equal_range(ng.getHash());
+    for (Iterator it = range.first; it != range.second; ++it) {
+        if (nogoods[it->second] == ng) return it->second;
+    }
+    return -1;
+}
+
+
 // reorders the nogoods such that there are no free indices in the range 0-(getNogoodCount()-1)
 void NogoodSet::defragment()
 {
     if (freeIndices.size() == 0) return;
 
-    int free = 0;
+    // move used nogoods from the back into free slots (front to back),
+    // such that indices of nogoods before the first free slot do not change
     int used = nogoods.size() - 1;
-    while (free < used) {
+    BOOST_FOREACH (int free, freeIndices) {
         // let used point to the last element which is not free
-        while (used > 0 && freeIndices.count(used) > 0) {
-            nogoods.pop_back();
-            used--;
-        }
-        // let free point to the next free index in the range 0-(ngg.nogoods.size()-1)
-        while (free < (int)nogoods.size() - 1 && freeIndices.count(free) == 0) free++;
+        while (used > free && freeIndices.contains(used)) used--;
+        if (used <= free) break;
+
         // move used to free
-        if (free < used) {
-            nogoods[free] = nogoods[used];
-            addCount[free] = addCount[used];
-            nogoods.pop_back();
-            addCount.pop_back();
-            nogoodsWithHash[nogoods[free].getHash()].erase(used);
-            nogoodsWithHash[nogoods[free].getHash()].insert(free);
-            freeIndices.erase(free);
-            free++;
-            used--;
+        typedef boost::unordered_multimap<std::size_t, int>::iterator Iterator;
+        std::pair<Iterator, Iterator> range = nogoodsWithHash.equal_range(nogoods[used].getHash());
+        for (Iterator it = range.first; it != range.second; ++it) {
+            if (it->second == used) {
+                it->second = free;
+                break;
+            }
         }
+        nogoods[free] = nogoods[used];
+        addCount[free] = addCount[used];
+        used--;
     }
+
+    // release the storage of the slots which are not used anymore
+    const int count = getNogoodCount();
+    nogoods.erase(nogoods.begin() + count, nogoods.end());
+    addCount.resize(count);
+    freeIndices.clear();
+
     #ifndef NDEBUG
     // there must not be pointers to non-existing nogoods
     {
-        typedef std::pair<size_t, Set<int> > Pair;
-        BOOST_FOREACH (Pair p, nogoodsWithHash) {
-            BOOST_FOREACH (int i, p.second) {
-                assert (i < (int)nogoods.size());
-            }
+        typedef std::pair<std::size_t, int> Pair;
+        BOOST_FOREACH (const Pair& p, nogoodsWithHash) {
+            assert (p.second < (int)nogoods.size());
+            assert (nogoods[p.second].getHash() == p.first);
         }
     }
     #endif
-    freeIndices.clear();
 }
 
 
@@ -438,16 +453,14 @@ int NogoodSet::addNogood(Nogood ng)
     DBGLOG(DBG, "Hash of " << ng << " is " << ng.getHash());
 
     // check if ng is already present
-    BOOST_FOREACH (int i, nogoodsWithHash[ng.getHash()]) {
-        if (nogoods[i] == ng) {
-            addCount[i]++;
-            DBGLOG(DBG, "Already contained with index " << i);
-            return i;
-        }
+    int index = findNogood(ng);
+    if (index != -1) {
+        addCount[index]++;
+        DBGLOG(DBG, "Already contained with index " << index);
+        return index;
     }
 
     // nogood is not present
-    int index;
     if (freeIndices.size() == 0) {
         nogoods.push_back(ng);
         addCount.push_back(1);
@@ -461,7 +474,7 @@ int NogoodSet::addNogood(Nogood ng)
     }
     DBGLOG(DBG, "Adding with index " << index);
 
-    nogoodsWithHash[ng.getHash()].insert(index);
+    nogoodsWithHash.insert(std::make_pair(ng.getHash(), index));
     return index;
 }
 
@@ -481,7 +494,14 @@ const Nogood& NogoodSet::getNogood(int index) const
 void NogoodSet::removeNogood(int nogoodIndex)
 {
     addCount[nogoodIndex] = 0;
-    nogoodsWithHash[nogoods[nogoodIndex].getHash()].erase(nogoodIndex);
+    typedef boost::unordered_multimap<std::size_t, int>::iterator Iterator;
+    std::pair<Iterator, Iterator> range = nogoodsWithHash.equal_range(nogoods[nogoodIndex].getHash());
+    for (Iterator it = range.first; it != range.second; ++it) {
+        if (it->second == nogoodIndex) {
+            nogoodsWithHash.erase(it);
+            break;
+        }
+    }
     freeIndices.insert(nogoodIndex);
     //	defragment();	// make sure that the nogood vector does not contain free slots
 }
@@ -492,15 +512,12 @@ void NogoodSet::removeNogood(Nogood ng)
     ng.recomputeHash();
 
     // check if ng is present
-    BOOST_FOREACH (int i, nogoodsWithHash[ng.getHash()]) {
-        if (nogoods[i] == ng) {
-            DBGLOG(DBG, "Deleting nogood " << ng << " (index: " << i << ")");
-            // yes: delete it
-            removeNogood(i);
-            return;
-        }
+    int index = findNogood(ng);
+    if (index != -1) {
+        DBGLOG(DBG, "Deleting nogood " << ng << " (index: " << index << ")");
+        // yes: delete it
+        removeNogood(index);
     }
-    return;
 }
 
 
@@ -519,7 +536,7 @@ void NogoodSet::forgetLeastFrequentlyAdded()
     }
     // delete those with an add count of less than 5% of the maximum add count
     for (uint32_t i = 0; i < nogoods.size(); i++) {
-        if (addCount[i] < mac * 0.05) {
+        if (addCount[i] < mac * 0.05 && !freeIndices.contains(i)) {
             DBGLOG(DBG, "Forgetting nogood " << nogoods[i]);
             removeNogood(i);
         }
@@ -546,7 +563,7 @@ std::string NogoodSet::getStringRepresentation(RegistryPtr reg) const
 std::ostream& NogoodSet::print(std::ostream& o) const
 {
     o << "{ ";
-    for (std::vector<Nogood>::const_iterator it = nogoods.begin(); it != nogoods.end(); ++it) {
+    for (std::deque<Nogood>::const_iterator it = nogoods.begin(); it != nogoods.end(); ++it) {
         if (it != nogoods.begin()) o << ", ";
         o << (*it);
     }
@@ -72,7 +72,7 @@ void ImmediateNogoodGrounder::update(InterpretationConstPtr partialInterpretatio
     if (instantiatedNongroundNogoodsIndex >= max) instantiatedNongroundNogoodsIndex = 0;
     DBGLOG(DBG, "Updating nogood grounder from " << instantiatedNongroundNogoodsIndex << " to " << max);
     for (int i = instantiatedNongroundNogoodsIndex; i < max; ++i) {
-        Nogood ng = watched->getNogood(i);
+        const Nogood& ng = watched->getNogood(i);
         DBGLOG(DBG, "Checking nogood " << ng.getStringRepresentation(reg));
         if (ng.isGround()) continue;
 
@@ -197,7 +197,7 @@ void LazyNogoodGrounder::update(InterpretationConstPtr partialInterpretation, In
     if (watchedNogoodsCount >= max) watchedNogoodsCount = 0;
     DBGLOG(DBG, "Updating nogood grounder from " << watchedNogoodsCount << " to " << max);
     for (int i = watchedNogoodsCount; i < max; ++i) {
-        Nogood ng = watched->getNogood(i);
+        const Nogood& ng = watched->getNogood(i);
         DBGLOG(DBG, "Checking nogood " << ng.getStringRepresentation(reg));
         if (ng.isGround()) continue;
 
@@ -0,0 +1,129 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   ParallelModelBuilder.cpp
+ *
+ * @brief  Thread pool for the parallel model builder.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/ParallelModelBuilder.h"
+
+DLVHEX_NAMESPACE_BEGIN
+
+boost::exception_ptr captureModelGeneratorException()
+{
+    // boost::current_exception only knows the standard exceptions,
+    // so we copy our own exceptions with their static type
+    try
+    {
+        throw;
+    }
+    catch(const UsageError& e) {
+        return boost::copy_exception(e);
+    }
+    catch(const PluginError& e) {
+        return boost::copy_exception(e);
+    }
+    catch(const FatalError& e) {
+        return boost::copy_exception(e);
+    }
+    catch(const SyntaxError& e) {
+        return boost::copy_exception(e);
+    }
+    catch(const GeneralError& e) {
+        return boost::copy_exception(e);
+    }
+    catch(...) {
+        return boost::current_exception();
+    }
+}
+
+
+ModelBuildingThreadPool::ModelBuildingThreadPool(unsigned threads):
+threads(threads),
+tasks(),
+shutdown(false)
+{
+    if( this->threads == 0 )
+        this->threads = boost::thread::hardware_concurrency();
+    if( this->threads == 0 )
+        this->threads = 1;
+    for(unsigned i = 0; i < this->threads; ++i) {
+        workers.create_thread(boost::bind(&ModelBuildingThreadPool::worker, this));
+    }
+}
+
+
+ModelBuildingThreadPool::~ModelBuildingThreadPool()
+{
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        shutdown = true;
+        tasks.clear();
+    }
+    taskAvailable.notify_all();
+    workers.join_all();
+}
+
+
+void ModelBuildingThreadPool::submit(const Task& task)
+{
+    {
+        boost::mutex::scoped_lock lock(mutex);
+        tasks.push_back(task);
+    }
+    taskAvailable.notify_one();
+}
+
+
+void ModelBuildingThreadPool::worker()
+{
+    for(;;) {
+        Task task;
+        {
+            boost::mutex::scoped_lock lock(mutex);
+            while( tasks.empty() && !shutdown )
+                taskAvailable.wait(lock);
+            if( shutdown )
+                return;
+            task = tasks.front();
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+
+DLVHEX_NAMESPACE_END
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
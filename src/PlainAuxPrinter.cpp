@@ -53,7 +53,7 @@ std::ostream& out, ID id, const std::string& prefix) const
 {
     // simply print all IDs
     assert(id.isOrdinaryGroundAtom() && id.isAuxiliary());
-    out << prefix << reg->ogatoms.getByAddress(id.address).text;
+    out << prefix << printToString<RawPrinter>(reg->ogatoms.getIDByAddress(id.address), reg);
     return true;
 }
 
@@ -52,8 +52,16 @@
 #include "dlvhex2/HexParser.h"
 #include "dlvhex2/ExternalLearningHelper.h"
 
+#include <boost/thread/recursive_mutex.hpp>
+
 DLVHEX_NAMESPACE_BEGIN
 
+namespace
+{
+    // serializes the evaluation of all external atoms which are not thread-safe
+    boost::recursive_mutex evaluationMutex;
+}
+
 #if 0
 bool PluginAtom::Query::operator<(const Query& other) const
 {
@@ -204,6 +212,28 @@ PluginAtom::setOutputArity(const unsigned arity)
 }
 
 
+void
+PluginAtom::setThreadSafe(bool threadSafe)
+{
+    this->threadSafe = threadSafe;
+}
+
+
+PluginAtom::EvaluationLock::EvaluationLock(const PluginAtom& atom):
+locked(!atom.isThreadSafe())
+{
+    if( locked )
+        evaluationMutex.lock();
+}
+
+
+PluginAtom::EvaluationLock::~EvaluationLock()
+{
+    if( locked )
+        evaluationMutex.unlock();
+}
+
+
 bool
 PluginAtom::checkOutputArity(const ExtSourceProperties& prop, const unsigned arity) const
 {
@@ -255,6 +285,8 @@ void PluginAtom::retrieveCached(const Query& query, Answer& answer)
 bool PluginAtom::retrieveFacade(const Query& query, Answer& answer, NogoodContainerPtr nogoods, bool useCache)
 {
     DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidrf,"PluginAtom retrieveFacade");
+    // model builders may call this concurrently, also the learning below uses otuples and replacements
+    EvaluationLock lock(*this);
     bool fromCache = false;
 
     // split the query
@@ -276,14 +308,14 @@ bool PluginAtom::retrieveFacade(const Query& query, Answer& answer, NogoodContai
             subqueryFromCache = false;
 
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidr,"PluginAtom retrieve");
-            retrieve(atomicQuery, atomicAnswer, query.ctx->config.getOption("ExternalLearningUser") ? nogoods : NogoodContainerPtr());
+            retrieve(atomicQuery, atomicAnswer, query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_USER) ? nogoods : NogoodContainerPtr());
         }
 
         // if (!subqueryFromCache)
         {
             DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidr,"retrieveFacade Learning");
-            if (!!nogoods && query.ctx->config.getOption("ExternalLearningIOBehavior")) ExternalLearningHelper::learnFromInputOutputBehavior(atomicQuery, atomicAnswer, prop, nogoods);
-            if (!!nogoods && query.ctx->config.getOption("ExternalLearningFunctionality") && prop.isFunctional()) ExternalLearningHelper::learnFromFunctionality(atomicQuery, atomicAnswer, prop, otuples, nogoods);
+            if (!!nogoods && query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_IO_BEHAVIOR)) ExternalLearningHelper::learnFromInputOutputBehavior(atomicQuery, atomicAnswer, prop, nogoods);
+            if (!!nogoods && query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_FUNCTIONALITY) && prop.isFunctional()) ExternalLearningHelper::learnFromFunctionality(atomicQuery, atomicAnswer, prop, otuples, nogoods);
         }
 
         // overall answer is the union of the atomic answers
@@ -297,7 +329,7 @@ bool PluginAtom::retrieveFacade(const Query& query, Answer& answer, NogoodContai
 
     {
         DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidr,"retrieveFacade neg. learning");
-        if (!!nogoods && query.ctx->config.getOption("ExternalLearningNeg")) ExternalLearningHelper::learnFromNegativeAtoms(query, answer, prop, nogoods);
+        if (!!nogoods && query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_NEG)) ExternalLearningHelper::learnFromNegativeAtoms(query, answer, prop, nogoods);
     }
 
     return fromCache;
@@ -410,7 +442,7 @@ bool PluginAtom::retrieveCached(const Query& query, Answer& answer, NogoodContai
                 assert(!ans.second);
 
                 ans.second.reset(new SimpleNogoodContainer());
-                retrieve(queryc, ans.first, query.ctx->config.getOption("ExternalLearningUser") ? ans.second : NogoodContainerPtr());
+                retrieve(queryc, ans.first, query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_USER) ? ans.second : NogoodContainerPtr());
                 for (int i = 0; i < ans.second->getNogoodCount(); ++i) nogoods->addNogood(ans.second->getNogood(i));
                 answer = ans.first;
             }
@@ -454,7 +486,7 @@ std::vector<PluginAtom::Query> PluginAtom::splitQuery(const Query& query, const
 {
 
     std::vector<Query> atomicQueries;
-    if (query.eatomID != ID_FAIL && (prop.isLinearOnAtomLevel() || prop.isLinearOnTupleLevel()) && query.ctx->config.getOption("ExternalLearningLinearity")) {
+    if (query.eatomID != ID_FAIL && (prop.isLinearOnAtomLevel() || prop.isLinearOnTupleLevel()) && query.ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_LINEARITY)) {
 	const ExternalAtom& eatom = query.ctx->registry()->eatoms.getByID(query.eatomID);
 
         DBGLOG(DBG, "Splitting query by exploiting linearity");
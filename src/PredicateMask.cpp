@@ -102,8 +102,9 @@ void PredicateMask::addPredicate(ID pred)
     DBGLOG_VSCOPE(DBG,"PM::aP",this,false);
     DBGLOG(DBG,"adding predicate " << pred << ", knownAddresses was " << knownAddresses);
     assert(pred.isTerm() && pred.isConstantTerm() && "predicate masks can only be done on constant terms");
-    predicates.insert(pred.address);
-    knownAddresses = 0;          // scan the whole address space again
+    // (if the predicate is new, all its atoms are unknown)
+    predicates.insert(std::make_pair(pred.address, 0));
+    knownAddresses = 0;          // force the next update
 }
 
 
@@ -111,74 +112,43 @@ void PredicateMask::updateMask()
 {
     //DBGLOG_VSCOPE(DBG,"PM::uM",this,false);
     //DBGLOG(DBG,"= PredicateMask::updateMask for predicates " <<
-    //    printset(predicates));
+    //    printrange(predicates));
 
     assert(!!maski);
     RegistryPtr reg = maski->getRegistry();
     Interpretation::Storage& bits = maski->getStorage();
 
-    unsigned maxaddr = 0;
-
-    OrdinaryAtomTable::AddressIterator it_begin;
-    {
-        // get one state of it_end, encoded in maxaddr
-        // (we must not use it_end, as it is a generic object but denotes
-        // different endpoints if ogatoms changes during this method)
-        OrdinaryAtomTable::AddressIterator it_end;
-        boost::tie(it_begin, it_end) = reg->ogatoms.getAllByAddress();
-        maxaddr = it_end - it_begin;
-    }
+    // get one state of the size of ogatoms
+    // (atoms added later are either picked up below or by the next update)
+    unsigned maxaddr = reg->ogatoms.getSize();
 
     boost::mutex::scoped_lock lock(updateMutex);
 
     // check if we have unknown atoms
     //DBGLOG(DBG,"already inspected ogatoms with address < " << knownAddresses <<
-    //    ", iterator range has size " << maxaddr);
+    //    ", table has size " << maxaddr);
     if( maxaddr == knownAddresses )
         return;
 
     // only log real activity
     DBGLOG_VSCOPE(DBG,"PM::uM(do)",this,false);
-    DBGLOG(DBG,"= PredicateMask::updateMask (need to update) for predicates " <<
-        printset(predicates));
-
-    // if not equal, it must be larger -> we must inspect
-    assert(maxaddr > knownAddresses);
 
-    // advance iterator to first ogatom unknown to predicateInputMask
-    OrdinaryAtomTable::AddressIterator it = it_begin;
-    it += knownAddresses;
+    // if not equal, it must be larger (or we added a predicate) -> we must inspect
+    assert(maxaddr > knownAddresses || knownAddresses == 0);
 
-    unsigned missingBits = maxaddr - knownAddresses;
-    DBGLOG(DBG,"need to inspect " << missingBits << " missing bits");
-
-    // check all new ogatoms till the end
-    #ifndef NDEBUG
-    {
-        std::stringstream s;
-        s << "relevant predicate constants are ";
-        RawPrinter printer(s, reg);
-        BOOST_FOREACH(IDAddress addr, predicates) {
-            printer.print(ID(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, addr));
-            s << ", ";
-        }
-        DBGLOG(DBG,s.str());
+    // instead of inspecting all new ogatoms, we retrieve only the new atoms
+    // over our predicates from the per-predicate index of the table
+    std::vector<IDAddress> newAddresses;
+    typedef std::map<IDAddress, std::size_t>::value_type PredicatePair;
+    BOOST_FOREACH(PredicatePair& p, predicates) {
+        reg->ogatoms.getAddressesByPredicate(p.first, p.second, newAddresses);
     }
-    #endif
-    assert(knownAddresses == (it - it_begin));
-    for(;missingBits != 0; it++, missingBits--) {
-        if (!reg->ogatoms.getIDByAddress(knownAddresses).isHiddenAtom()) {
-            assert(it != reg->ogatoms.getAllByAddress().second);
-            const OrdinaryAtom& oatom = *it;
-            //DBGLOG(DBG,"checking " << oatom.tuple.front());
-            IDAddress addr = oatom.tuple.front().address;
-            if( predicates.find(addr) != predicates.end() ) {
-                bits.set(it - it_begin);
-            }
-        }
-        knownAddresses++;
+    DBGLOG(DBG,"= PredicateMask::updateMask (need to update) for " << predicates.size() <<
+        " predicates: " << newAddresses.size() << " new atoms");
+    BOOST_FOREACH(IDAddress addr, newAddresses) {
+        bits.set(addr);
     }
-    //  knownAddresses += missingBits;
+    knownAddresses = maxaddr;
     DBGLOG(DBG,"updateMask created new set of relevant ogatoms: " << *maski << " and knownAddresses is " << knownAddresses);
 }
 
@@ -216,7 +186,7 @@ void ExternalAtomMask::setEAtom(const ProgramCtx& ctx, const ExternalAtom& eatom
     // replacement tuple cache
     preparedTuple.push_back(posreplacement);
     if( eatom.auxInputPredicate != ID_FAIL &&
-    ctx.config.getOption("IncludeAuxInputInAuxiliaries") ) {
+    ctx.config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) ) {
         preparedTuple.push_back(eatom.auxInputPredicate);
     }
 
@@ -298,11 +268,11 @@ void ExternalAtomMask::addOutputAtoms(InterpretationConstPtr intr)
             const OrdinaryAtom& oatom = ctx->registry()->ogatoms.getByAddress(atom);
             if (oatom.tuple[0] == posreplacement || oatom.tuple[0] == negreplacement) {
                 if (matchOutputAtom(oatom.tuple)) {
-                    DBGLOG(DBG, "Output atom " << oatom.text << " matches the external atom");
+                    DBGLOG(DBG, "Output atom " << printToString<RawPrinter>(id, reg) << " matches the external atom");
                     maski->setFact(atom);
                 }
                 else {
-                    DBGLOG(DBG, "Output atom " << oatom.text << " does not match the external atom");
+                    DBGLOG(DBG, "Output atom " << printToString<RawPrinter>(id, reg) << " does not match the external atom");
                 }
             }
         }
@@ -388,7 +358,7 @@ bool ExternalAtomMask::matchOutputAtom(const Tuple& togatom)
     #if 0
     // check predicate and constant input
     int aux = 0;
-    if (ctx->config.getOption("IncludeAuxInputInAuxiliaries") && eatom->auxInputPredicate != ID_FAIL) {
+    if (ctx->config.getOption(Configuration::OPTION_INCLUDE_AUX_INPUT_IN_AUXILIARIES) && eatom->auxInputPredicate != ID_FAIL) {
         if (togatom[1] != eatom->auxInputPredicate) return false;
         aux = 1;
     }
@@ -521,11 +491,11 @@ void ExternalAtomMask::updateMask()
             const IDAddress outputAtom = *en;
             const OrdinaryAtom& oatom = eatom->pluginAtom->getRegistry()->ogatoms.getByAddress(outputAtom);
             if (matchOutputAtom(oatom.tuple)) {
-                DBGLOG(DBG, "Output atom " << oatom.text << " matches the external atom");
+                DBGLOG(DBG, "Output atom " << printToString<RawPrinter>(eatom->pluginAtom->getRegistry()->ogatoms.getIDByAddress(outputAtom), eatom->pluginAtom->getRegistry()) << " matches the external atom");
                 maski->setFact(outputAtom);
             }
             else {
-                DBGLOG(DBG, "Output atom " << oatom.text << " does not match the external atom");
+                DBGLOG(DBG, "Output atom " << printToString<RawPrinter>(eatom->pluginAtom->getRegistry()->ogatoms.getIDByAddress(outputAtom), eatom->pluginAtom->getRegistry()) << " does not match the external atom");
             }
             en++;
         }
@@ -0,0 +1,147 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   PreparedSubprogram.cpp
+ *
+ * @brief  Subprogram which is analysed once and evaluated under many sets of facts.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/PreparedSubprogram.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/State.h"
+#include "dlvhex2/Benchmarking.h"
+#include "dlvhex2/Logger.h"
+
+#include <boost/foreach.hpp>
+
+DLVHEX_NAMESPACE_BEGIN
+
+namespace
+{
+    std::vector<InterpretationPtr> copyAnswerSets(const std::vector<InterpretationPtr>& answersets) {
+        std::vector<InterpretationPtr> result;
+        result.reserve(answersets.size());
+        BOOST_FOREACH (InterpretationPtr intr, answersets) {
+            result.push_back(InterpretationPtr(new Interpretation(*intr)));
+        }
+        return result;
+    }
+}
+
+
+PreparedSubprogram::PreparedSubprogram(const ProgramCtx& ctx, const std::vector<ID>& idb, unsigned memoSize):
+pc(new ProgramCtx(ctx)),
+memoSize(memoSize)
+{
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sid,"PreparedSubprogram prepare");
+    pc->idb = idb;
+    pc->edb = InterpretationPtr(new Interpretation(ctx.registry()));
+    pc->currentOptimum.clear();
+    pc->currentOptimumRelevantLevels = 0;
+    // the evaluation graph must be valid for all sets of facts, so do not optimize wrt. the (empty) EDB
+    pc->prepareSubprogram(*pc, false, false);
+    baseEdb = pc->edb;
+    preparedConfig = pc->config;
+}
+
+
+PreparedSubprogram::~PreparedSubprogram()
+{
+    // destruct model generators before the factories in the evaluation graph
+    pc->modelBuilder.reset();
+}
+
+
+std::vector<InterpretationPtr> PreparedSubprogram::evaluate(InterpretationConstPtr edb)
+{
+    boost::mutex::scoped_lock lock(mutex);
+
+    std::size_t hash = hash_value(*edb);
+    if( memoSize > 0 ) {
+        Memo::const_iterator it, itend;
+        for(boost::tie(it, itend) = memo.equal_range(hash); it != itend; ++it) {
+            if( *it->second.edb == *edb ) {
+                DLVHEX_BENCHMARK_REGISTER_AND_COUNT(sidhit,"PreparedSubprogram memo hits",1);
+                DBGLOG(DBG,"PreparedSubprogram: answering from memo");
+                return copyAnswerSets(it->second.answersets);
+            }
+        }
+    }
+
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sid,"PreparedSubprogram evaluate");
+
+    // restore the state after preparation, only the facts are new
+    pc->config = preparedConfig;
+    pc->currentOptimum.clear();
+    pc->currentOptimumRelevantLevels = 0;
+    pc->integrateNextOptimum = false;
+    InterpretationPtr runEdb(new Interpretation(*baseEdb));
+    runEdb->add(*edb);
+    pc->edb = runEdb;
+
+    pc->modelCallbacks.clear();
+    pc->finalCallbacks.clear();
+    ProgramCtx::SubprogramAnswerSetCallback* spasc = new ProgramCtx::SubprogramAnswerSetCallback();
+    ModelCallbackPtr spascp = ModelCallbackPtr(spasc);
+    pc->modelCallbacks.push_back(spascp);
+
+    pc->changeState(StatePtr(new EvaluateState));
+    pc->evaluate();
+    // model generators refer to the facts of this run
+    pc->modelBuilder.reset();
+
+    if( memoSize > 0 ) {
+        if( memo.size() >= memoSize ) {
+            // drop the oldest result (iterators of the memo do not survive rehashing, so find it again)
+            Memo::iterator it, itend;
+            for(boost::tie(it, itend) = memo.equal_range(memoOrder.front().first); it != itend; ++it) {
+                if( it->second.edb == memoOrder.front().second ) {
+                    memo.erase(it);
+                    break;
+                }
+            }
+            memoOrder.pop_front();
+        }
+        MemoEntry entry;
+        entry.edb.reset(new Interpretation(*edb));
+        entry.answersets = spasc->answersets;
+        memo.insert(std::make_pair(hash, entry));
+        memoOrder.push_back(std::make_pair(hash, entry.edb));
+        return copyAnswerSets(spasc->answersets);
+    }
+    return spasc->answersets;
+}
+
+DLVHEX_NAMESPACE_END
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
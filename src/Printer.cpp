@@ -40,6 +40,7 @@
 #include "dlvhex2/Registry.h"
 
 #include <cassert>
+#include <sstream>
 
 DLVHEX_NAMESPACE_BEGIN
 
@@ -76,10 +77,10 @@ void RawPrinter::print(ID id)
         case ID::MAINKIND_ATOM:
             switch(id.kind & ID::SUBKIND_MASK) {
                 case ID::SUBKIND_ATOM_ORDINARYG:
-                    out << registry->ogatoms.getByID(id).text;
+                    printOrdinaryAtom(registry->ogatoms.getByID(id));
                     break;
                 case ID::SUBKIND_ATOM_ORDINARYN:
-                    out << registry->onatoms.getByID(id).text;
+                    printOrdinaryAtom(registry->onatoms.getByID(id));
                     break;
                 case ID::SUBKIND_ATOM_BUILTIN:
                 {
@@ -298,6 +299,24 @@ std::string RawPrinter::toString(RegistryPtr reg, ID id)
 }
 
 
+void RawPrinter::printOrdinaryAtom(const OrdinaryAtom& atom)
+{
+    if( !atom.text.empty() ) {
+        out << atom.text;
+        return;
+    }
+    // text was not stored, create it from the tuple
+    assert(!atom.tuple.empty());
+    print(atom.tuple.front());
+    if( atom.tuple.size() > 1 ) {
+        Tuple t(atom.tuple.begin()+1, atom.tuple.end());
+        out << "(";
+        printmany(t,",");
+        out << ")";
+    }
+}
+
+
 // remove the prefix
 // from m0___p1__q(a) to q(a)
 std::string RawPrinter::removeModulePrefix(const std::string& text)
@@ -319,7 +338,11 @@ void RawPrinter::printWithoutPrefix(ID id)
         case ID::MAINKIND_ATOM:
             switch(id.kind & ID::SUBKIND_MASK) {
                 case ID::SUBKIND_ATOM_ORDINARYG:
-                    out << removeModulePrefix(registry->ogatoms.getByID(id).text);
+                {
+                    std::stringstream ss;
+                    RawPrinter(ss, registry).print(id);
+                    out << removeModulePrefix(ss.str());
+                }
                     break;
                 default:
                     assert(false);
@@ -45,6 +45,7 @@
 #include "dlvhex2/PluginContainer.h"
 #include "dlvhex2/State.h"
 #include "dlvhex2/Printer.h"
+#include "dlvhex2/OnlineModelBuilder.h"
 //#include "dlvhex2/DLVProcess.h"
 //#include "dlvhex2/EvalHeuristicEasy.h"
 
@@ -107,8 +108,11 @@ maxint(0), currentOptimumRelevantLevels(0), terminationRequest(false)
     config.setOption("Split", 0);
     config.setOption("SkipStrongSafetyCheck",0);
     config.setOption("LiberalSafety",1);
+                                 // number of stored domain-exploration results per evaluation unit (0 = disabled)
+    config.setOption("DomainExplorationCacheSize",16);
     config.setOption("IncludeAuxInputInAuxiliaries",0);
     config.setOption("DumpEvaluationPlan",0);
+    config.setOption("DumpEvaluationProfile",0);
     config.setOption("DumpStats",0);
                                  // perhaps only temporary
     config.setOption("BenchmarkEAstderr",0);
@@ -118,6 +122,10 @@ maxint(0), currentOptimumRelevantLevels(0), terminationRequest(false)
     config.setOption("PrintLearnedNogoods",0);
     // frumpy is the name of the failsafe clasp config option
     config.setStringOption("ClaspConfiguration","frumpy");
+                                 // see --help
+    config.setStringOption("Goal","all");
+                                 // see --help
+    config.setOption("StoreAtomText",1);
     config.setOption("ClaspIncrementalInterpretationExtraction",1);
     config.setOption("ClaspSingletonLoopNogoods",0);
     config.setOption("ClaspInverseLiterals", 0);
@@ -130,12 +138,22 @@ maxint(0), currentOptimumRelevantLevels(0), terminationRequest(false)
     config.setOption("NoPropagator", 0);
                                  // see --help
     config.setOption("UseConstantSpace", 0);
+                                 // worker threads and per-unit model buffer of --modelbuilder=parallel
+    config.setOption("ModelBuilderThreads", 0);
+    config.setOption("ModelBufferSize", 4);
+                                 // see --help
+    config.setOption("CompactModels", 0);
     config.setOption("ClaspForceSingleThreaded", 0);
     config.setOption("LazyUFSCheckerInitialization", 0);
     config.setOption("SupportSets", 0);
     config.setOption("ExternalSourceInlining", 0);
     config.setOption("ForceGC", 0);
     config.setStringOption("PluginDirs", "");
+                                 // directory of the on-disk ground program cache (empty = disabled)
+    config.setStringOption("GroundingCacheDir", "");
+                                 // binary snapshot written after and read before parsing (empty = disabled)
+    config.setStringOption("SaveSnapshot", "");
+    config.setStringOption("LoadSnapshot", "");
     config.setOption("IncrementalGrounding", 0);
     config.setOption("MinimizationSize", 10000);
     config.setOption("EAEvalDebounce", 1000);
@@ -376,11 +394,36 @@ std::vector<InterpretationPtr> ProgramCtx::evaluateSubprogram(ProgramCtx& pc, bo
 {
 //    benchmark::BenchmarkController::Instance().suspend();
 
+    prepareSubprogram(pc, parse, true);
+
+    DBGLOG(DBG, "Setting AnswerSetCallback");
+    pc.modelCallbacks.clear();
+    pc.finalCallbacks.clear();
+    SubprogramAnswerSetCallback* spasc = new SubprogramAnswerSetCallback();
+    ModelCallbackPtr spascp = ModelCallbackPtr(spasc);
+    pc.modelCallbacks.push_back(spascp);
+
+    DBGLOG(DBG, "Evaluate subprogram");
+    pc.evaluate();
+    std::vector<InterpretationPtr> result;
+    BOOST_FOREACH (InterpretationPtr intr, spasc->answersets) {
+        result.push_back(intr);
+    }
+
+//    benchmark::BenchmarkController::Instance().resume();
+
+    return result;
+}
+
+
+void ProgramCtx::prepareSubprogram(ProgramCtx& pc, bool parse, bool optimizeEDB)
+{
     DBGLOG(DBG, "Resetting context");
     pc.state.reset();
     pc.modelBuilder.reset();
     pc.parser.reset();
     pc.evalgraph.reset();
+    pc.evalProfile.reset();
     pc.compgraph.reset();
     pc.depgraph.reset();
 
@@ -391,6 +434,12 @@ std::vector<InterpretationPtr> ProgramCtx::evaluateSubprogram(ProgramCtx& pc, bo
     pc.config.setOption("DumpModelGraph",0);
     pc.config.setOption("DumpIModelGraph",0);
     pc.config.setOption("DumpAttrGraph",0);
+    pc.config.setOption("DumpEvaluationProfile",0);
+
+    // subprograms are evaluated from within external atoms, which might hold the
+    // evaluation lock of plugin atoms (see PluginAtom::EvaluationLock); model builders
+    // evaluating external atoms in other threads would then wait for this thread forever
+    pc.modelBuilderFactory = boost::factory<OnlineModelBuilder<FinalEvalGraph>*>();
 
     if( !pc.evalHeuristic ) {
         assert(false);
@@ -425,8 +474,11 @@ std::vector<InterpretationPtr> ProgramCtx::evaluateSubprogram(ProgramCtx& pc, bo
     if( pc.terminationRequest ) throw GeneralError("Liberal safety check for subprogram failed");
     pc.createDependencyGraph();
     if( pc.terminationRequest ) throw GeneralError("Create dependency graph for subprogram failed");
-    pc.optimizeEDBDependencyGraph();
-    if( pc.terminationRequest ) throw GeneralError("Optimize EDB dependency graph for subprogram failed");
+    // (the state is optional, if we skip it createComponentGraph proceeds without it)
+    if( optimizeEDB ) {
+        pc.optimizeEDBDependencyGraph();
+        if( pc.terminationRequest ) throw GeneralError("Optimize EDB dependency graph for subprogram failed");
+    }
     pc.createComponentGraph();
     if( pc.terminationRequest ) throw GeneralError("Create component graph for subprogram failed");
     // use SCCs to do strong safety check
@@ -438,24 +490,6 @@ std::vector<InterpretationPtr> ProgramCtx::evaluateSubprogram(ProgramCtx& pc, bo
     if( pc.terminationRequest ) throw GeneralError("Create evaluation graph for subprogram failed");
     pc.setupProgramCtx();
     if( pc.terminationRequest ) throw GeneralError("Setup ProgramCtx for subprogram failed");
-
-    DBGLOG(DBG, "Setting AnswerSetCallback");
-    pc.modelCallbacks.clear();
-    pc.finalCallbacks.clear();
-    SubprogramAnswerSetCallback* spasc = new SubprogramAnswerSetCallback();
-    ModelCallbackPtr spascp = ModelCallbackPtr(spasc);
-    pc.modelCallbacks.push_back(spascp);
-
-    DBGLOG(DBG, "Evaluate subprogram");
-    pc.evaluate();
-    std::vector<InterpretationPtr> result;
-    BOOST_FOREACH (InterpretationPtr intr, spasc->answersets) {
-        result.push_back(intr);
-    }
-
-//    benchmark::BenchmarkController::Instance().resume();
-
-    return result;
 }
 
 
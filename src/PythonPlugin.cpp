@@ -42,6 +42,7 @@
 #include "dlvhex2/PythonPlugin.h"
 #include "dlvhex2/PlatformDefinitions.h"
 #include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/PreparedSubprogram.h"
 #include "dlvhex2/State.h"
 #include "dlvhex2/Registry.h"
 #include "dlvhex2/Printer.h"
@@ -205,6 +206,17 @@ namespace
         return id;
     }
 
+    // holds the global interpreter lock of Python while in scope;
+    // external atoms may be evaluated in threads other than the one which initialized Python
+    class PythonGIL
+    {
+        public:
+            PythonGIL(): state(PyGILState_Ensure()) {}
+            ~PythonGIL() { PyGILState_Release(state); }
+        private:
+            PyGILState_STATE state;
+    };
+
 }
 
 
@@ -247,6 +259,7 @@ class PythonAtom : public PluginAtom
 
         virtual void
         retrieve(const Query& query, Answer& answer, NogoodContainerPtr nogoods) throw (PluginError) {
+            PythonGIL gil;
             try
             {
                 DBGLOG(DBG, "Preparing Python for query");
@@ -289,12 +302,14 @@ class PythonAtom : public PluginAtom
             std::stringstream ss;
             ss << "complianceCheck" << std::to_string(compcheck) << "(" << data << "," << std::to_string(i) << "," << std::to_string(j) << "," << std::to_string(k) << ",\"" << inp << "\",\"" << outp << "\")";
             std::string s = ss.str();
+            PythonGIL gil;
             std::string res = boost::python::extract<std::string>(boost::python::eval(s.c_str(),PythonAPI::dict,PythonAPI::dict));
             if (res == "1") return true; else return false;
         }
 
         virtual void learnSupportSets(const Query& query, NogoodContainerPtr nogoods)
         {
+            PythonGIL gil;
             try
             {
                 Answer answer;
@@ -614,30 +629,31 @@ namespace PythonAPI
         return emb_ctx->registry()->storeRule(rule);
     }
 
-    boost::python::tuple evaluateSubprogram(boost::python::tuple tup) {
-
-        boost::python::extract<boost::python::tuple> facts(tup[0]);
-        boost::python::extract<boost::python::tuple> rules(tup[1]);
-
-        if (!facts.check() || !rules.check()) throw PluginError("dlvhex.evaluateSubprogram: Input must be a pair of facts and rules");
-
+    InterpretationPtr factsFromTuple(boost::python::tuple facts, const std::string& caller) {
         InterpretationPtr edb(new Interpretation(emb_ctx->registry()));
-        for (int i = 0; i < boost::python::len(facts()); ++i) {
-            boost::python::extract<ID> get_ID(facts()[i]);
+        for (int i = 0; i < boost::python::len(facts); ++i) {
+            boost::python::extract<ID> get_ID(facts[i]);
             if (!get_ID.check() || !get_ID().isAtom() || !get_ID().isOrdinaryGroundAtom()) {
-                throw PluginError("dlvhex.evaluateSubprogram: Facts must be a tuple of ground atom IDs");
+                throw PluginError(caller + ": Facts must be a tuple of ground atom IDs");
             }
             edb->setFact(get_ID().address);
         }
+        return edb;
+    }
+
+    std::vector<ID> rulesFromTuple(boost::python::tuple rules, const std::string& caller) {
         std::vector<ID> idb;
-        for (int i = 0; i < boost::python::len(rules()); ++i) {
-            boost::python::extract<ID> get_ID(rules()[i]);
+        for (int i = 0; i < boost::python::len(rules); ++i) {
+            boost::python::extract<ID> get_ID(rules[i]);
             if (!get_ID.check() || !get_ID().isRule()) {
-                throw PluginError("dlvhex.evaluateSubprogram: Facts must be a tuple of ground atom IDs");
+                throw PluginError(caller + ": Rules must be a tuple of rule IDs");
             }
             idb.push_back(get_ID());
         }
-        std::vector<InterpretationPtr> answersets = emb_ctx->evaluateSubprogram(edb, idb);
+        return idb;
+    }
+
+    boost::python::tuple answerSetsToTuple(const std::vector<InterpretationPtr>& answersets) {
         boost::python::tuple pythonResult;
         BOOST_FOREACH (InterpretationConstPtr answerset, answersets) {
             boost::python::tuple pythonAS;
@@ -653,6 +669,30 @@ namespace PythonAPI
         return pythonResult;
     }
 
+    boost::python::tuple evaluateSubprogram(boost::python::tuple tup) {
+
+        boost::python::extract<boost::python::tuple> facts(tup[0]);
+        boost::python::extract<boost::python::tuple> rules(tup[1]);
+
+        if (!facts.check() || !rules.check()) throw PluginError("dlvhex.evaluateSubprogram: Input must be a pair of facts and rules");
+
+        InterpretationPtr edb = factsFromTuple(facts(), "dlvhex.evaluateSubprogram");
+        std::vector<ID> idb = rulesFromTuple(rules(), "dlvhex.evaluateSubprogram");
+        std::vector<InterpretationPtr> answersets = emb_ctx->evaluateSubprogram(edb, idb);
+        return answerSetsToTuple(answersets);
+    }
+
+    // analyses the rules once, such that they can be evaluated under many sets of facts
+    boost::shared_ptr<PreparedSubprogram> prepareSubprogram(boost::python::tuple rules) {
+        std::vector<ID> idb = rulesFromTuple(rules, "dlvhex.prepareSubprogram");
+        return boost::shared_ptr<PreparedSubprogram>(new PreparedSubprogram(*emb_ctx, idb));
+    }
+
+    boost::python::tuple PreparedSubprogram_evaluate(PreparedSubprogram& prepared, boost::python::tuple facts) {
+        InterpretationPtr edb = factsFromTuple(facts, "PreparedSubprogram.evaluate");
+        return answerSetsToTuple(prepared.evaluate(edb));
+    }
+
     boost::python::tuple loadSubprogram(std::string filename) {
 
         ProgramCtx pc = *emb_ctx;
@@ -727,7 +767,7 @@ namespace PythonAPI
 
     bool learn(boost::python::tuple args) {
 
-        if (!!emb_nogoods && emb_ctx->config.getOption("ExternalLearningUser")) {
+        if (!!emb_nogoods && emb_ctx->config.getOption(Configuration::OPTION_EXTERNAL_LEARNING_USER)) {
             Nogood ng;
             for (int i = 0; i < boost::python::len(args); ++i) {
                 dlvhex::ID id = boost::python::extract<ID>(args[i]);
@@ -761,7 +801,7 @@ namespace PythonAPI
                 boost::python::extract<std::string> get_string(args[i]);
                 if (get_string.check()) {
                     // store as string
-                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(boost::python::extract<std::string>(args[i])));
+                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(get_string()));
                 }
                 else {
                     boost::python::extract<ID> get_ID(args[i]);
@@ -796,7 +836,7 @@ namespace PythonAPI
                 boost::python::extract<std::string> get_string(args[i]);
                 if (get_string.check()) {
                     // store as string
-                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(boost::python::extract<std::string>(args[i])));
+                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(get_string()));
                 }
                 else {
                     boost::python::extract<ID> get_ID(args[i]);
@@ -827,7 +867,7 @@ namespace PythonAPI
                 boost::python::extract<std::string> get_string(args[i]);
                 if (get_string.check()) {
                     // store as string
-                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(boost::python::extract<std::string>(args[i])));
+                    outputTuple.push_back(emb_ctx->registry()->storeConstantTerm(get_string()));
                 }
                 else {
                     boost::python::extract<ID> get_ID(args[i]);
@@ -1024,6 +1064,7 @@ BOOST_PYTHON_MODULE(dlvhex)
     boost::python::def("storeExternalAtom", PythonAPI::storeExternalAtom);
     boost::python::def("storeRule", PythonAPI::storeRule);
     boost::python::def("evaluateSubprogram", PythonAPI::evaluateSubprogram);
+    boost::python::def("prepareSubprogram", PythonAPI::prepareSubprogram);
     boost::python::def("loadSubprogram", PythonAPI::loadSubprogram);
     boost::python::def("resetCacheOfPlugins", PythonAPI::resetCacheOfPlugins);
     boost::python::def("learnSupportSets", PythonAPI::learnSupportSets);
@@ -1040,6 +1081,8 @@ BOOST_PYTHON_MODULE(dlvhex)
         .def("isTrue", &PythonAPI::ID_isTrue)
         .def("isFalse", &PythonAPI::ID_isFalse)
         .def(boost::python::self == dlvhex::ID());
+    boost::python::class_<dlvhex::PreparedSubprogram, boost::shared_ptr<dlvhex::PreparedSubprogram>, boost::noncopyable>("PreparedSubprogram", boost::python::no_init)
+        .def("evaluate", &PythonAPI::PreparedSubprogram_evaluate);
     boost::python::class_<dlvhex::ExtSourceProperties>("ExtSourceProperties")
         .def("addMonotonicInputPredicate", &dlvhex::ExtSourceProperties::addMonotonicInputPredicate)
         .def("addAntimonotonicInputPredicate", &dlvhex::ExtSourceProperties::addAntimonotonicInputPredicate)
@@ -1137,6 +1180,14 @@ std::vector<PluginAtomPtr> PythonPlugin::createAtoms(ProgramCtx& ctx) const
         PythonAPI::dict = PythonAPI::main.attr("__dict__");
         #endif
 
+    // Py_Initialize acquired the global interpreter lock for this thread; release it such that
+    // model builders can evaluate Python atoms in other threads (calls into Python use PythonGIL)
+    #if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+    #endif
+    PyEval_SaveThread();
+
+    PythonGIL gil;
     BOOST_FOREACH (std::string script, ctxdata.pythonScripts) {
         DBGLOG(DBG, "Loading file \"" + script + "\"");
             try
@@ -1158,6 +1209,7 @@ std::vector<PluginAtomPtr> PythonPlugin::createAtoms(ProgramCtx& ctx) const
 
 void PythonPlugin::runPythonMain(std::string filename)
 {
+    PythonGIL gil;
     try
     {
         boost::python::exec_file(filename.c_str(), PythonAPI::dict, PythonAPI::dict);
@@ -47,8 +47,12 @@
 #include "dlvhex2/HexParser.h"
 #include "dlvhex2/HexParserModule.h"
 #include "dlvhex2/HexGrammar.h"
+#include "dlvhex2/Interpretation.h"
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/range/join.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/strong_components.hpp>
 #include <boost/lexical_cast.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
@@ -63,7 +67,8 @@ ground(false),
 query(),
 varAuxPred(ID_FAIL),
 novarAuxPred(ID_FAIL),
-allWitnesses(false)
+allWitnesses(false),
+magicSets(false)
 {
 }
 
@@ -88,11 +93,13 @@ void QueryPlugin::printUsage(std::ostream& o) const
         << "                      Enable or disable the querying plugin (default is disabled)." << std::endl
         << "     --query-brave    Do brave reasoning." << std::endl
         << "     --query-all      Give all witnesses when doing ground reasoning." << std::endl
-        << "     --query-cautious Do cautious reasoning." << std::endl;
+        << "     --query-cautious Do cautious reasoning." << std::endl
+        << "     --query-magic    Apply magic set rewriting, i.e., restrict grounding and solving" << std::endl
+        << "                      to the part of the program which is relevant for the query." << std::endl;
 }
 
 
-// accepted options: --query-enables --query-brave --query-cautious
+// accepted options: --query-enables --query-brave --query-cautious --query-all --query-magic
 //
 // processes options for this plugin, and removes recognized options from pluginOptions
 // (do not free the pointers, the const char* directly come from argv)
@@ -137,6 +144,10 @@ ProgramCtx& ctx)
             ctxdata.allWitnesses = true;
             processed = true;
         }
+        else if( str == "--query-magic" ) {
+            ctxdata.magicSets = true;
+            processed = true;
+        }
 
         if( processed ) {
             // return value of erase: element after it, maybe end()
@@ -329,6 +340,568 @@ namespace
 
     typedef QueryPlugin::CtxData CtxData;
 
+    // Magic set rewriting for query answering.
+    //
+    // We use a generalized magic set transformation which keeps the original
+    // predicate names: each rule defining a predicate p that is needed with
+    // adornment a (a string of 'b'ound and 'f'ree argument positions) gets the
+    // additional body literal m_p^a(bound arguments of the head), and magic rules
+    // propagate bindings from the query to the body literals.
+    // Sideways information passing goes from left to right over positive
+    // ordinary body literals (and over builtins whose variables are bound).
+    //
+    // This is only sound for the stratified, normal part of the program.
+    // Therefore we compute "root" predicates whose rules are kept unchanged:
+    // * head predicates of disjunctive rules, weight rules, and rules with head guards,
+    // * predicates in a cycle through default negation, aggregates, or nonmonotonic external atoms,
+    // * strongly negated predicates and their positive counterparts, and
+    // * the auxiliary predicates used by QueryAdderRewriter.
+    // The bodies of root rules and of (weak) constraints seed the magic predicates.
+    //
+    // Predicate inputs of external atoms are always needed without bindings,
+    // as the external source may inspect their whole extension.
+    class MagicSetRewriter
+    {
+        public:
+            MagicSetRewriter(ProgramCtx& ctx, const CtxData& ctxdata);
+
+            // replaces ctx.idb by the rewritten program and adds magic seeds to ctx.edb
+            void rewrite();
+
+        protected:
+            // predicate symbol and arity
+            typedef std::pair<ID, unsigned> PredicateKey;
+            // one character per argument: 'b' for bound and 'f' for free
+            typedef std::string Adornment;
+            typedef std::pair<PredicateKey, Adornment> AdornedPredicate;
+
+            // boost graph for finding cycles through nonmonotonic dependencies
+            typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS> PredicateGraph;
+            typedef boost::graph_traits<PredicateGraph>::vertex_descriptor PredicateNode;
+
+        protected:
+            // false if the program contains constructs we do not rewrite
+            bool isApplicable() const;
+            bool isApplicableAtom(ID id) const;
+
+            PredicateKey getPredicateKey(const OrdinaryAtom& atom) const;
+            void getPredicateKeys(ID predicate, std::vector<PredicateKey>& out) const;
+            void collectPredicateKeys();
+            void collectPredicateKeysInAtom(ID id);
+
+            void computeRoots();
+            PredicateNode getNode(const PredicateKey& key);
+            void addDependency(const PredicateKey& from, const PredicateKey& to, bool nonmonotonic);
+            void addDependencies(const PredicateKey& from, ID lit, bool nonmonotonic);
+            bool isExternalPredicateInput(const ExternalAtom& eatom, unsigned index) const;
+            bool isRootRule(const Rule& rule) const;
+
+            Adornment adorn(const OrdinaryAtom& atom, const std::set<ID>& bound) const;
+            ID getMagicPredicate(const PredicateKey& key, const Adornment& adornment);
+            ID createMagicAtom(ID magicPredicate, const OrdinaryAtom& atom, const Adornment& adornment);
+
+            // process body of (root or guarded) rule and create magic rules for its body literals
+            void processBody(const Tuple& body, std::set<ID> bound, Tuple prefix);
+            void needAtom(const OrdinaryAtom& atom, const std::set<ID>& bound, const Tuple& prefix);
+            void needExternalInputs(const ExternalAtom& eatom, const Tuple& prefix);
+            void need(const PredicateKey& key, const Adornment& adornment, ID magicAtom, const Tuple& prefix);
+
+            void addRule(ID rule);
+
+        protected:
+            ProgramCtx& ctx;
+            const CtxData& ctxdata;
+            RegistryPtr reg;
+
+            // all predicates (with arities) which occur in the program
+            std::set<PredicateKey> predicates;
+
+            // predicates which are evaluated without restriction
+            std::set<PredicateKey> roots;
+
+            // non-root rules indexed by their (single) head predicate
+            std::map<PredicateKey, Tuple> rulesByHead;
+
+            // adorned predicates which are already processed or scheduled
+            std::set<AdornedPredicate> needed;
+            std::list<AdornedPredicate> agenda;
+
+            // magic predicate symbols
+            std::map<AdornedPredicate, ID> magicPredicates;
+
+            // dependencies between predicates for computing roots
+            PredicateGraph depgraph;
+            std::map<PredicateKey, PredicateNode> nodes;
+            std::vector<std::pair<PredicateNode, PredicateNode> > nonmonotonicEdges;
+
+            // the rewritten program
+            Tuple newIdb;
+            std::set<ID> newIdbSet;
+            unsigned magicRules;
+            unsigned magicFacts;
+    };
+
+    MagicSetRewriter::MagicSetRewriter(ProgramCtx& ctx, const CtxData& ctxdata):
+    ctx(ctx),
+        ctxdata(ctxdata),
+        reg(ctx.registry()),
+        magicRules(0),
+    magicFacts(0) {
+    }
+
+    bool MagicSetRewriter::isApplicableAtom(ID id) const
+    {
+        if( id.isModuleAtom() )
+            return false;
+        if( id.isOrdinaryAtom() ) {
+            // higher-order atoms are rewritten later by HigherOrderPlugin
+            const OrdinaryAtom& oatom = reg->lookupOrdinaryAtom(id);
+            if( oatom.tuple.front().isVariableTerm() )
+                return false;
+        }
+        if( id.isAggregateAtom() ) {
+            const AggregateAtom& aatom = reg->aatoms.getByID(id);
+            BOOST_FOREACH(ID lit, aatom.literals) {
+                if( !isApplicableAtom(lit) ) return false;
+            }
+            BOOST_FOREACH(const Tuple& literals, aatom.mliterals) {
+                BOOST_FOREACH(ID lit, literals) {
+                    if( !isApplicableAtom(lit) ) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool MagicSetRewriter::isApplicable() const
+    {
+        BOOST_FOREACH(ID ruleid, ctx.idb) {
+            const Rule& rule = reg->rules.getByID(ruleid);
+            BOOST_FOREACH(ID h, boost::join(rule.head, rule.body)) {
+                if( !isApplicableAtom(h) ) {
+                    DBGLOG(DBG,"rule " << printToString<RawPrinter>(ruleid, reg) << " prevents magic set rewriting");
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    MagicSetRewriter::PredicateKey MagicSetRewriter::getPredicateKey(const OrdinaryAtom& atom) const
+    {
+        assert(!atom.tuple.empty());
+        return PredicateKey(atom.tuple.front(), atom.tuple.size() - 1);
+    }
+
+    // external atoms refer to predicates by name, so we have to consider all arities
+    void MagicSetRewriter::getPredicateKeys(ID predicate, std::vector<PredicateKey>& out) const
+    {
+        std::set<PredicateKey>::const_iterator it =
+            predicates.lower_bound(PredicateKey(predicate, 0));
+        for(; it != predicates.end() && it->first == predicate; ++it)
+            out.push_back(*it);
+    }
+
+    void MagicSetRewriter::collectPredicateKeysInAtom(ID id)
+    {
+        if( id.isOrdinaryAtom() ) {
+            predicates.insert(getPredicateKey(reg->lookupOrdinaryAtom(id)));
+        }
+        else if( id.isAggregateAtom() ) {
+            const AggregateAtom& aatom = reg->aatoms.getByID(id);
+            BOOST_FOREACH(ID lit, aatom.literals)
+                collectPredicateKeysInAtom(lit);
+            BOOST_FOREACH(const Tuple& literals, aatom.mliterals) {
+                BOOST_FOREACH(ID lit, literals)
+                    collectPredicateKeysInAtom(lit);
+            }
+        }
+    }
+
+    void MagicSetRewriter::collectPredicateKeys()
+    {
+        BOOST_FOREACH(ID ruleid, ctx.idb) {
+            const Rule& rule = reg->rules.getByID(ruleid);
+            BOOST_FOREACH(ID id, boost::join(rule.head, rule.body))
+                collectPredicateKeysInAtom(id);
+        }
+    }
+
+    MagicSetRewriter::PredicateNode MagicSetRewriter::getNode(const PredicateKey& key)
+    {
+        std::map<PredicateKey, PredicateNode>::const_iterator it = nodes.find(key);
+        if( it != nodes.end() )
+            return it->second;
+        PredicateNode n = boost::add_vertex(depgraph);
+        nodes[key] = n;
+        return n;
+    }
+
+    void MagicSetRewriter::addDependency(const PredicateKey& from, const PredicateKey& to, bool nonmonotonic)
+    {
+        PredicateNode nfrom = getNode(from);
+        PredicateNode nto = getNode(to);
+        boost::add_edge(nfrom, nto, depgraph);
+        if( nonmonotonic )
+            nonmonotonicEdges.push_back(std::make_pair(nfrom, nto));
+    }
+
+    bool MagicSetRewriter::isExternalPredicateInput(const ExternalAtom& eatom, unsigned index) const
+    {
+        if( !eatom.inputs[index].isConstantTerm() )
+            return false;
+        // without plugin atom we conservatively treat all constant inputs as predicates
+        if( !eatom.pluginAtom )
+            return true;
+        const std::vector<PluginAtom::InputType>& types = eatom.pluginAtom->getInputTypes();
+        return index < types.size() && types[index] == PluginAtom::PREDICATE;
+    }
+
+    void MagicSetRewriter::addDependencies(const PredicateKey& from, ID lit, bool nonmonotonic)
+    {
+        if( lit.isOrdinaryAtom() ) {
+            addDependency(from, getPredicateKey(reg->lookupOrdinaryAtom(lit)), nonmonotonic || lit.isNaf());
+        }
+        else if( lit.isExternalAtom() ) {
+            const ExternalAtom& eatom = reg->eatoms.getByID(lit);
+            const ExtSourceProperties& prop = eatom.getExtSourceProperties();
+            for(unsigned i = 0; i < eatom.inputs.size(); ++i) {
+                if( !isExternalPredicateInput(eatom, i) )
+                    continue;
+                bool monotonic = prop.isMonotonic() || prop.isMonotonic(i);
+                std::vector<PredicateKey> keys;
+                getPredicateKeys(eatom.inputs[i], keys);
+                BOOST_FOREACH(const PredicateKey& key, keys) {
+                    addDependency(from, key, nonmonotonic || lit.isNaf() || !monotonic);
+                }
+            }
+        }
+        else if( lit.isAggregateAtom() ) {
+            // we do not analyze monotonicity of aggregates
+            const AggregateAtom& aatom = reg->aatoms.getByID(lit);
+            BOOST_FOREACH(ID innerlit, aatom.literals)
+                addDependencies(from, innerlit, true);
+            BOOST_FOREACH(const Tuple& literals, aatom.mliterals) {
+                BOOST_FOREACH(ID innerlit, literals)
+                    addDependencies(from, innerlit, true);
+            }
+        }
+    }
+
+    void MagicSetRewriter::computeRoots()
+    {
+        DBGLOG_SCOPE(DBG,"roots",false);
+
+        BOOST_FOREACH(ID ruleid, ctx.idb) {
+            const Rule& rule = reg->rules.getByID(ruleid);
+            bool rootHead = rule.head.size() > 1 || ruleid.isWeightRule() || !rule.headGuard.empty();
+            BOOST_FOREACH(ID h, rule.head) {
+                PredicateKey hkey = getPredicateKey(reg->lookupOrdinaryAtom(h));
+                getNode(hkey);
+                if( rootHead )
+                    roots.insert(hkey);
+                BOOST_FOREACH(ID b, rule.body)
+                    addDependencies(hkey, b, false);
+            }
+        }
+
+        // predicates in strongly connected components with nonmonotonic edges
+        std::vector<int> component(boost::num_vertices(depgraph));
+        boost::strong_components(depgraph, &component[0]);
+        std::set<int> nonmonotonicComponents;
+        typedef std::pair<PredicateNode, PredicateNode> Edge;
+        BOOST_FOREACH(const Edge& e, nonmonotonicEdges) {
+            if( component[e.first] == component[e.second] )
+                nonmonotonicComponents.insert(component[e.first]);
+        }
+        typedef std::pair<PredicateKey, PredicateNode> NodePair;
+        BOOST_FOREACH(const NodePair& np, nodes) {
+            if( nonmonotonicComponents.count(component[np.second]) > 0 )
+                roots.insert(np.first);
+        }
+
+        // strong negation: the constraints added by StrongNegationPlugin must see all atoms
+        BOOST_FOREACH(const PredicateKey& key, predicates) {
+            if( !key.first.isAuxiliary() || reg->getTypeByAuxiliaryConstantSymbol(key.first) != 's' )
+                continue;
+            roots.insert(key);
+            std::vector<PredicateKey> poskeys;
+            getPredicateKeys(reg->getIDByAuxiliaryConstantSymbol(key.first), poskeys);
+            roots.insert(poskeys.begin(), poskeys.end());
+        }
+
+        // auxiliary predicates of query, these are inspected by the model callbacks
+        std::vector<PredicateKey> auxkeys;
+        if( ctxdata.varAuxPred != ID_FAIL )
+            getPredicateKeys(ctxdata.varAuxPred, auxkeys);
+        if( ctxdata.novarAuxPred != ID_FAIL )
+            getPredicateKeys(ctxdata.novarAuxPred, auxkeys);
+        roots.insert(auxkeys.begin(), auxkeys.end());
+
+        #ifndef NDEBUG
+        BOOST_FOREACH(const PredicateKey& key, roots) {
+            DBGLOG(DBG,"root predicate " << printToString<RawPrinter>(key.first, reg) << "/" << key.second);
+        }
+        #endif
+    }
+
+    bool MagicSetRewriter::isRootRule(const Rule& rule) const
+    {
+        if( rule.head.empty() )
+            return true;
+        BOOST_FOREACH(ID h, rule.head) {
+            if( roots.count(getPredicateKey(reg->lookupOrdinaryAtom(h))) > 0 )
+                return true;
+        }
+        return false;
+    }
+
+    MagicSetRewriter::Adornment MagicSetRewriter::adorn(const OrdinaryAtom& atom, const std::set<ID>& bound) const
+    {
+        Adornment ret;
+        for(Tuple::const_iterator it = atom.tuple.begin() + 1; it != atom.tuple.end(); ++it) {
+            // an argument is bound iff all its variables are bound
+            std::set<ID> vars;
+            reg->getVariablesInID(*it, vars, true);
+            bool isBound = true;
+            BOOST_FOREACH(ID var, vars) {
+                if( var.isAnonymousVariable() || bound.count(var) == 0 ) {
+                    isBound = false;
+                    break;
+                }
+            }
+            ret.push_back(isBound ? 'b' : 'f');
+        }
+        return ret;
+    }
+
+    ID MagicSetRewriter::getMagicPredicate(const PredicateKey& key, const Adornment& adornment)
+    {
+        AdornedPredicate ap(key, adornment);
+        std::map<AdornedPredicate, ID>::const_iterator it = magicPredicates.find(ap);
+        if( it != magicPredicates.end() )
+            return it->second;
+
+        // auxiliary symbols are keyed by a single ID, so we first register the adorned predicate
+        std::stringstream ss;
+        ss << "\"" << printToString<RawPrinter>(key.first, reg) << "/" << adornment << "\"";
+        ID adornedPredicate = reg->storeConstantTerm(ss.str(), true);
+        ID magicPredicate = reg->getAuxiliaryConstantSymbol('m', adornedPredicate);
+        magicPredicates[ap] = magicPredicate;
+        return magicPredicate;
+    }
+
+    ID MagicSetRewriter::createMagicAtom(ID magicPredicate, const OrdinaryAtom& atom, const Adornment& adornment)
+    {
+        assert(atom.tuple.size() == adornment.size() + 1);
+        OrdinaryAtom magicAtom(ID::MAINKIND_ATOM | ID::PROPERTY_AUX);
+        magicAtom.tuple.push_back(magicPredicate);
+        for(unsigned i = 0; i < adornment.size(); ++i) {
+            if( adornment[i] == 'b' )
+                magicAtom.tuple.push_back(atom.tuple[i+1]);
+        }
+
+        std::set<ID> vars;
+        reg->getVariablesInTuple(magicAtom.tuple, vars, true);
+        if( vars.empty() ) {
+            magicAtom.kind |= ID::SUBKIND_ATOM_ORDINARYG;
+            return reg->storeOrdinaryGAtom(magicAtom);
+        }
+        else {
+            magicAtom.kind |= ID::SUBKIND_ATOM_ORDINARYN;
+            return reg->storeOrdinaryNAtom(magicAtom);
+        }
+    }
+
+    void MagicSetRewriter::addRule(ID rule)
+    {
+        if( newIdbSet.insert(rule).second )
+            newIdb.push_back(rule);
+    }
+
+    void MagicSetRewriter::need(const PredicateKey& key, const Adornment& adornment, ID magicAtom, const Tuple& prefix)
+    {
+        if( prefix.empty() ) {
+            // seed from query or root rule
+            assert(magicAtom.isOrdinaryGroundAtom() && "magic atom without body must be ground");
+            if( !ctx.edb->getFact(magicAtom.address) ) {
+                ctx.edb->setFact(magicAtom.address);
+                magicFacts++;
+            }
+        }
+        else {
+            Rule magicRule(ID::MAINKIND_RULE | ID::SUBKIND_RULE_REGULAR | ID::PROPERTY_AUX);
+            magicRule.head.push_back(magicAtom);
+            magicRule.body = prefix;
+            ID magicRuleId = reg->storeRule(magicRule);
+            if( newIdbSet.count(magicRuleId) == 0 ) {
+                DBGLOG(DBG,"created magic rule " << printToString<RawPrinter>(magicRuleId, reg));
+                magicRules++;
+            }
+            addRule(magicRuleId);
+        }
+
+        AdornedPredicate ap(key, adornment);
+        if( needed.insert(ap).second )
+            agenda.push_back(ap);
+    }
+
+    void MagicSetRewriter::needAtom(const OrdinaryAtom& atom, const std::set<ID>& bound, const Tuple& prefix)
+    {
+        PredicateKey key = getPredicateKey(atom);
+        // roots and predicates which are only defined by facts are not restricted
+        if( rulesByHead.count(key) == 0 )
+            return;
+
+        Adornment adornment = adorn(atom, bound);
+        ID magicAtom = createMagicAtom(getMagicPredicate(key, adornment), atom, adornment);
+        need(key, adornment, magicAtom, prefix);
+    }
+
+    void MagicSetRewriter::needExternalInputs(const ExternalAtom& eatom, const Tuple& prefix)
+    {
+        for(unsigned i = 0; i < eatom.inputs.size(); ++i) {
+            if( !isExternalPredicateInput(eatom, i) )
+                continue;
+
+            std::vector<PredicateKey> keys;
+            getPredicateKeys(eatom.inputs[i], keys);
+            BOOST_FOREACH(const PredicateKey& key, keys) {
+                if( rulesByHead.count(key) == 0 )
+                    continue;
+
+                // the whole extension is needed
+                Adornment adornment(key.second, 'f');
+                OrdinaryAtom magicAtom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG | ID::PROPERTY_AUX);
+                magicAtom.tuple.push_back(getMagicPredicate(key, adornment));
+                need(key, adornment, reg->storeOrdinaryGAtom(magicAtom), prefix);
+            }
+        }
+    }
+
+    void MagicSetRewriter::processBody(const Tuple& body, std::set<ID> bound, Tuple prefix)
+    {
+        // left to right sideways information passing over positive literals
+        Tuple deferred;
+        BOOST_FOREACH(ID lit, body) {
+            if( lit.isOrdinaryAtom() && !lit.isNaf() ) {
+                needAtom(reg->lookupOrdinaryAtom(lit), bound, prefix);
+                prefix.push_back(lit);
+                reg->getVariablesInID(lit, bound);
+            }
+            else if( lit.isBuiltinAtom() && !lit.isNaf() ) {
+                // use builtins as filters if they do not bind variables
+                std::set<ID> vars;
+                reg->getVariablesInID(lit, vars);
+                bool allBound = true;
+                BOOST_FOREACH(ID var, vars) {
+                    if( bound.count(var) == 0 ) {
+                        allBound = false;
+                        break;
+                    }
+                }
+                if( allBound )
+                    prefix.push_back(lit);
+            }
+            else {
+                deferred.push_back(lit);
+            }
+        }
+
+        // the remaining literals do not pass bindings
+        BOOST_FOREACH(ID lit, deferred) {
+            if( lit.isOrdinaryAtom() ) {
+                needAtom(reg->lookupOrdinaryAtom(lit), bound, prefix);
+            }
+            else if( lit.isExternalAtom() ) {
+                needExternalInputs(reg->eatoms.getByID(lit), prefix);
+            }
+            else if( lit.isAggregateAtom() ) {
+                const AggregateAtom& aatom = reg->aatoms.getByID(lit);
+                std::vector<Tuple> literals(aatom.mliterals);
+                if( !aatom.literals.empty() )
+                    literals.push_back(aatom.literals);
+                BOOST_FOREACH(const Tuple& innerLiterals, literals) {
+                    BOOST_FOREACH(ID innerlit, innerLiterals) {
+                        if( innerlit.isOrdinaryAtom() )
+                            needAtom(reg->lookupOrdinaryAtom(innerlit), bound, prefix);
+                        else if( innerlit.isExternalAtom() )
+                            needExternalInputs(reg->eatoms.getByID(innerlit), prefix);
+                    }
+                }
+            }
+        }
+    }
+
+    void MagicSetRewriter::rewrite()
+    {
+        DBGLOG_SCOPE(DBG,"magic",false);
+        DBGLOG(DBG,"= MagicSetRewriter::rewrite");
+
+        if( !isApplicable() ) {
+            LOG(WARNING,"magic set rewriting is not applicable to programs with "
+                "higher-order or module atoms, evaluating the full program");
+            return;
+        }
+
+        collectPredicateKeys();
+        computeRoots();
+
+        // split program into root rules and rules which are restricted by magic predicates
+        Tuple rootRules;
+        BOOST_FOREACH(ID ruleid, ctx.idb) {
+            const Rule& rule = reg->rules.getByID(ruleid);
+            if( isRootRule(rule) ) {
+                rootRules.push_back(ruleid);
+            }
+            else {
+                assert(rule.head.size() == 1);
+                rulesByHead[getPredicateKey(reg->lookupOrdinaryAtom(rule.head.front()))].push_back(ruleid);
+            }
+        }
+
+        // root rules are kept and seed the magic predicates
+        BOOST_FOREACH(ID ruleid, rootRules) {
+            addRule(ruleid);
+            processBody(reg->rules.getByID(ruleid).body, std::set<ID>(), Tuple());
+        }
+
+        // restrict the rules of needed predicates
+        unsigned guardedRules = 0;
+        while( !agenda.empty() ) {
+            AdornedPredicate ap = agenda.front();
+            agenda.pop_front();
+            const PredicateKey& key = ap.first;
+            const Adornment& adornment = ap.second;
+            ID magicPredicate = getMagicPredicate(key, adornment);
+
+            BOOST_FOREACH(ID ruleid, rulesByHead[key]) {
+                // copy, as we modify the registry below
+                const Rule rule = reg->rules.getByID(ruleid);
+                const OrdinaryAtom head = reg->lookupOrdinaryAtom(rule.head.front());
+
+                ID guard = ID::posLiteralFromAtom(createMagicAtom(magicPredicate, head, adornment));
+                std::set<ID> bound;
+                reg->getVariablesInID(guard, bound);
+
+                Rule guardedRule(rule);
+                guardedRule.body.insert(guardedRule.body.begin(), guard);
+                ID guardedRuleId = reg->storeRule(guardedRule);
+                DBGLOG(DBG,"restricted rule " << printToString<RawPrinter>(guardedRuleId, reg));
+                addRule(guardedRuleId);
+                guardedRules++;
+
+                processBody(rule.body, bound, Tuple(1, guard));
+            }
+        }
+
+        LOG(INFO,"magic set rewriting kept " << rootRules.size() << " root rules, restricted " <<
+            guardedRules << " rules, and added " << magicRules << " magic rules and " <<
+            magicFacts << " magic facts (" << ctx.idb.size() << " rules before rewriting)");
+        ctx.idb.swap(newIdb);
+    }
+
+
     class QueryAdderRewriter:
     public PluginRewriter
     {
@@ -483,6 +1056,10 @@ namespace
         else {
             assert("this case should never happen");
         }
+
+        if( ctxdata.magicSets ) {
+            MagicSetRewriter(ctx, ctxdata).rewrite();
+        }
     }
 
 }                                // anonymous namespace
@@ -723,14 +1300,14 @@ namespace
         it != bits.end(); ++it) {
             // build substitution tuple
             const OrdinaryAtom& ogatom = reg->ogatoms.getByAddress(*it);
-            DBGLOG(DBG,"got auxiliary " << ogatom.text);
+            DBGLOG(DBG,"got auxiliary " << printToString<RawPrinter>(reg->ogatoms.getIDByAddress(*it), reg));
             assert(ogatom.tuple.size() > 1);
             Tuple subst(ogatom.tuple.begin()+1, ogatom.tuple.end());
             assert(!subst.empty());
 
             // discard duplicates
             if( printedSubstitutions.find(subst) != printedSubstitutions.end() ) {
-                LOG(DBG,"discarded duplicate substitution from auxiliary atom " << ogatom.text);
+                LOG(DBG,"discarded duplicate substitution from auxiliary atom " << printToString<RawPrinter>(reg->ogatoms.getIDByAddress(*it), reg));
                 continue;
             }
 
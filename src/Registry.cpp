@@ -51,6 +51,7 @@
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/bimap/bimap.hpp>
+#include <boost/thread/mutex.hpp>
 
 DLVHEX_NAMESPACE_BEGIN
 
@@ -66,6 +67,8 @@ DLVHEX_NAMESPACE_BEGIN
  *      (source ID is a rule)
  * 'q': Query evaluation auxiliary (QueryPlugin)
  *      (source ID is ID(0,0) or ID(0,1) ... see QueryPlugin.cpp)
+ * 'm': Magic set predicates for query answering (QueryPlugin)
+ *      (source ID is a string constant naming the adorned predicate)
  * 's': Strong negation auxiliary (StrongNegationPlugin)
  *      (source ID is a constant term)
  * 'h': Higher order auxiliary (HigherOrderPlugin)
@@ -139,12 +142,22 @@ struct Registry::Impl
     PredicateMaskPtr auxGroundAtomMask;
     std::list<AuxPrinterPtr> auxPrinters;
     AuxPrinterPtr defaultAuxPrinter;
+    // auxiliaries may be created by model generators running in parallel
+    boost::mutex auxSymbolsMutex;
 
     Impl():
     auxGroundAtomMask(new PredicateMask) {}
+    Impl(const Impl& other):
+    auxSymbols(other.auxSymbols),
+        auxGroundAtomMask(other.auxGroundAtomMask),
+        auxPrinters(other.auxPrinters),
+        defaultAuxPrinter(other.defaultAuxPrinter),
+        auxSymbolsMutex()        // must not copy mutex!
+        {}
 };
 
 Registry::Registry():
+ogatoms(true),                   // PredicateMask retrieves ground atoms by predicate
 pimpl(new Impl)
 {
     // do not initialize pimpl->auxGroundAtomMask here! (we can do this only outside of the constructor)
@@ -431,10 +444,7 @@ ID Registry::replaceVariablesInTerm(const ID term, const ID var, const ID by)
             t.arguments[i] = replaceVariablesInTerm(t.arguments[i], var, by);
         }
 
-        t.updateSymbolOfNestedTerm(this);
-        ID tid = terms.getIDByString(t.symbol);
-        if (tid == ID_FAIL) tid = terms.storeAndGetID(t);
-        return tid;
+        return storeNestedTerm(t.arguments, t.kind);
     }
     assert (false);
     return ID_FAIL;
@@ -461,13 +471,19 @@ namespace
 {
     // assume, that oatom.id and oatom.tuple is initialized!
     // assume, that oatom.text is not initialized!
-    // oatom.text will be modified
+    // oatom.text will be modified (if the table stores text)
     ID storeOrdinaryAtomHelper(
         Registry* reg,
         OrdinaryAtom& oatom,
     OrdinaryAtomTable& oat) {
         ID ret = oat.getIDByTuple(oatom.tuple);
-        if( ret == ID_FAIL ) {
+        if( ret == ID_FAIL && !oat.storesText() ) {
+            // text is created lazily by RawPrinter
+            oatom.text.clear();
+            ret = oat.storeAndGetID(oatom);
+            DBGLOG(DBG,"stored oatom " << oatom << " which got " << ret);
+        }
+        else if( ret == ID_FAIL ) {
             // text
             std::stringstream s;
             RawPrinter printer(s, reg);
@@ -515,10 +531,11 @@ ID Registry::storeConstOrVarTerm(Term& term)
 {
     // ensure the symbol does not start with a number
     assert(!term.symbol.empty() && !isdigit(term.symbol[0]));
-    ID ret = terms.getIDByString(term.symbol);
+    const std::size_t hash = TermTable::hashSymbol(term.symbol);
+    ID ret = terms.getIDBySymbol(term.symbol, hash);
     // check if might registered as a predicate
     if( ret == ID_FAIL ) {
-        ret = preds.getIDByString(term.symbol);
+        ret = preds.getIDBySymbol(term.symbol, hash);
         if( ret == ID_FAIL ) {
             ret = terms.storeAndGetID(term);
             DBGLOG(DBG,"stored term " << term << " which got " << ret);
@@ -528,15 +545,16 @@ ID Registry::storeConstOrVarTerm(Term& term)
 }
 
 
-ID Registry::storeConstantTerm(const std::string& symbol, bool aux)
+ID Registry::storeConstantTerm(boost::string_ref symbol, bool aux)
 {
     assert(!symbol.empty() && (::islower(symbol[0]) || symbol[0] == '"'));
 
-    ID ret = terms.getIDByString(symbol);
+    const std::size_t hash = TermTable::hashSymbol(symbol);
+    ID ret = terms.getIDBySymbol(symbol, hash);
     if( ret == ID_FAIL ) {
-        ret = preds.getIDByString(symbol);
+        ret = preds.getIDBySymbol(symbol, hash);
         if( ret == ID_FAIL ) {
-            Term term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, symbol);
+            Term term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, symbol.to_string());
             if( aux )
                 term.kind |= ID::PROPERTY_AUX;
             ret = terms.storeAndGetID(term);
@@ -547,13 +565,19 @@ ID Registry::storeConstantTerm(const std::string& symbol, bool aux)
 }
 
 
-ID Registry::storeVariableTerm(const std::string& symbol, bool aux)
+ID Registry::storeConstantTerm(const std::string& symbol, bool aux)
+{
+    return storeConstantTerm(boost::string_ref(symbol), aux);
+}
+
+
+ID Registry::storeVariableTerm(boost::string_ref symbol, bool aux)
 {
     assert(!symbol.empty() && ::isupper(symbol[0]));
 
-    ID ret = terms.getIDByString(symbol);
+    ID ret = terms.getIDBySymbol(symbol, TermTable::hashSymbol(symbol));
     if( ret == ID_FAIL ) {
-        Term term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_VARIABLE, symbol);
+        Term term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_VARIABLE, symbol.to_string());
         if( aux )
             term.kind |= ID::PROPERTY_AUX;
         ret = terms.storeAndGetID(term);
@@ -563,6 +587,30 @@ ID Registry::storeVariableTerm(const std::string& symbol, bool aux)
 }
 
 
+ID Registry::storeVariableTerm(const std::string& symbol, bool aux)
+{
+    return storeVariableTerm(boost::string_ref(symbol), aux);
+}
+
+
+ID Registry::storeNestedTerm(const std::vector<ID>& arguments, IDKind kind)
+{
+    assert(ID(kind,0).isTerm() && ID(kind,0).isNestedTerm());
+
+    ID ret = terms.getIDByArguments(arguments, kind);
+    if( ret == ID_FAIL ) {
+        Term term(kind, arguments, shared_from_this());
+        // the term might have been stored with different arguments from its text (e.g. by the parser)
+        ret = terms.getIDByString(term.symbol);
+        if( ret == ID_FAIL ) {
+            ret = terms.storeAndGetID(term);
+            DBGLOG(DBG,"stored term " << term << " which got " << ret);
+        }
+    }
+    return ret;
+}
+
+
 ID Registry::storeTerm(Term& term)
 {
     assert(!term.symbol.empty());
@@ -638,6 +686,7 @@ ID Registry::getAuxiliaryConstantSymbol(char type, ID id)
         "setupAuxiliaryGroundAtomMask has not been called before calling getAuxiliaryConstantSymbol!");
 
     // lookup auxiliary
+    boost::mutex::scoped_lock lock(pimpl->auxSymbolsMutex);
     AuxiliaryKey key(type,id);
     AuxiliaryStorage::left_const_iterator it =
         pimpl->auxSymbols.left.find(key);
@@ -686,6 +735,7 @@ ID Registry::getAuxiliaryVariableSymbol(char type, ID id)
     DBGLOG(DBG,"getAuxiliaryVariableSymbol for " << type << " " << id);
 
     // lookup auxiliary
+    boost::mutex::scoped_lock lock(pimpl->auxSymbolsMutex);
     AuxiliaryKey key(type,id);
     AuxiliaryStorage::left_const_iterator it =
         pimpl->auxSymbols.left.find(key);
@@ -747,6 +797,7 @@ ID Registry::getIDByAuxiliaryConstantSymbol(ID auxConstantID) const
     assert(auxConstantID.isConstantTerm());
 
     // lookup ID of auxiliary
+    boost::mutex::scoped_lock lock(pimpl->auxSymbolsMutex);
     DBGLOG(DBG,"getIDByAuxiliaryConstantSymbol for " << auxConstantID);
     AuxiliaryStorage::right_const_iterator it =
         pimpl->auxSymbols.right.find(AuxiliaryValue("", auxConstantID));
@@ -766,6 +817,7 @@ ID Registry::getIDByAuxiliaryVariableSymbol(ID auxVariableID) const
     assert(auxVariableID.isVariableTerm());
 
     // lookup ID of auxiliary
+    boost::mutex::scoped_lock lock(pimpl->auxSymbolsMutex);
     DBGLOG(DBG,"getIDByAuxiliaryVariableSymbol for " << auxVariableID);
     AuxiliaryStorage::right_const_iterator it =
         pimpl->auxSymbols.right.find(AuxiliaryValue("", auxVariableID));
@@ -820,6 +872,7 @@ char Registry::getTypeByAuxiliaryConstantSymbol(ID auxConstantID) const
 {
 
     // lookup ID of auxiliary
+    boost::mutex::scoped_lock lock(pimpl->auxSymbolsMutex);
     DBGLOG(DBG,"getTypeByAuxiliaryConstantSymbol for " << auxConstantID);
     AuxiliaryStorage::right_const_iterator it =
         pimpl->auxSymbols.right.find(AuxiliaryValue("", auxConstantID));
@@ -870,8 +923,11 @@ bool Registry::printAtomForUser(std::ostream& o, IDAddress address, const std::s
     DBGLOG(DBG,"printing for user id " << address);
     if( !getAuxiliaryGroundAtomMask()->getFact(address) ) {
         // fast direct output
-        if (ogatoms.getIDByAddress(address).isHiddenAtom()) return false;
-        o << prefix << ogatoms.getByAddress(address).text;
+        ID id = ogatoms.getIDByAddress(address);
+        if (id.isHiddenAtom()) return false;
+        o << prefix;
+        RawPrinter printer(o, this);
+        printer.print(id);
         return true;
     }
     else {
@@ -0,0 +1,371 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005-2007 Roman Schindlauer
+ * Copyright (C) 2006-2015 Thomas Krennwallner
+ * Copyright (C) 2009-2016 Peter Schüller
+ * Copyright (C) 2011-2016 Christoph Redl
+ * Copyright (C) 2015-2016 Tobias Kaminski
+ * Copyright (C) 2015-2016 Antonius Weinzierl
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   RegistrySnapshot.cpp
+ *
+ * @brief  Binary snapshot of the Registry and the EDB.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif                           // HAVE_CONFIG_H
+
+#include "dlvhex2/RegistrySnapshot.h"
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/Logger.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Term.h"
+#include "dlvhex2/Predicate.h"
+#include "dlvhex2/Benchmarking.h"
+#include "dlvhex2/Error.h"
+
+#include <bm/bmserial.h>
+
+#include <boost/foreach.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+DLVHEX_NAMESPACE_BEGIN
+
+namespace
+{
+    // file layout (all numbers are uint32_t in host byte order, strings are prefixed by their length,
+    // IDs are pairs of kind and address where the address refers to the tables of the file):
+    //   magic, version,
+    //   #predicates, (kind, symbol, arity)*,
+    //   #terms, (kind, symbol, #arguments, ID*)*,
+    //   #ground atoms, (kind, #tuple, ID*)*,
+    //   #bytes, serialized EDB
+    // predicates come first as function symbols of nested terms may be predicate terms
+    const char magic[8] = { 'D', 'L', 'V', 'H', 'E', 'X', 'S', 'N' };
+    const uint32_t formatVersion = 1;
+
+    void writeUInt(std::ostream& o, uint32_t value)
+    {
+        o.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void writeString(std::ostream& o, const std::string& str)
+    {
+        writeUInt(o, str.size());
+        o.write(str.data(), str.size());
+    }
+
+    void writeID(std::ostream& o, ID id)
+    {
+        writeUInt(o, id.kind);
+        writeUInt(o, id.address);
+    }
+
+    // addresses of the predicates, terms and ground atoms of the file in the current registry
+    struct AddressMap
+    {
+        std::vector<IDAddress> preds;
+        std::vector<IDAddress> terms;
+        std::vector<IDAddress> ogatoms;
+    };
+
+    // reads from a memory-mapped snapshot; reading beyond the end marks the reader as failed
+    class Reader
+    {
+        public:
+            Reader(const char* begin, const char* end): pos(begin), end(end), failed(false) {}
+
+            uint32_t readUInt() {
+                uint32_t value = 0;
+                if (failed || static_cast<std::size_t>(end - pos) < sizeof(value)) {
+                    failed = true;
+                    return 0;
+                }
+                std::memcpy(&value, pos, sizeof(value));
+                pos += sizeof(value);
+                return value;
+            }
+
+            // the result points into the file
+            boost::string_ref readString() {
+                uint32_t len = readUInt();
+                if (failed || len == 0 || static_cast<std::size_t>(end - pos) < len) {
+                    failed = true;
+                    return boost::string_ref();
+                }
+                boost::string_ref str(pos, len);
+                pos += len;
+                return str;
+            }
+
+            // number of elements of a sequence; must not exceed the remaining file size
+            uint32_t readCount() {
+                uint32_t count = readUInt();
+                if (failed || static_cast<std::size_t>(end - pos) / sizeof(uint32_t) < count) {
+                    failed = true;
+                    return 0;
+                }
+                return count;
+            }
+
+            // block of bytes which is prefixed by its length
+            const unsigned char* readBytes(uint32_t& len) {
+                len = readUInt();
+                if (failed || static_cast<std::size_t>(end - pos) < len) {
+                    failed = true;
+                    return 0;
+                }
+                const unsigned char* bytes = reinterpret_cast<const unsigned char*>(pos);
+                pos += len;
+                return bytes;
+            }
+
+            // term ID whose address refers to the tables of the file
+            ID readTerm(const AddressMap& map) {
+                ID id(readUInt(), 0);
+                IDAddress address = readUInt();
+                if (failed || !id.isTerm()) {
+                    failed = true;
+                    return ID_FAIL;
+                }
+                // integers and builtins are not stored in tables
+                if (id.isIntegerTerm() || id.isBuiltinTerm()) {
+                    id.address = address;
+                    return id;
+                }
+                const std::vector<IDAddress>& addresses = id.isPredicateTerm() ? map.preds : map.terms;
+                if (address >= addresses.size()) {
+                    failed = true;
+                    return ID_FAIL;
+                }
+                id.address = addresses[address];
+                return id;
+            }
+
+            // for content which is readable but invalid
+            void fail()
+                { failed = true; }
+
+            bool ok() const
+                { return !failed; }
+
+        private:
+            const char* pos;
+            const char* end;
+            bool failed;
+    };
+}
+
+
+RegistrySnapshot::RegistrySnapshot(ProgramCtx& ctx):
+ctx(ctx)
+{
+}
+
+
+void RegistrySnapshot::save(const std::string& fileName)
+{
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidsave, "RegistrySnapshot::save");
+
+    RegistryPtr reg = ctx.registry();
+
+    // serialize the EDB first, writing the tables cannot fail halfway because of it
+    std::vector<unsigned char> edb;
+    if (!!ctx.edb) {
+        bm::bvector<> bits(ctx.edb->getStorage());
+        bits.optimize();
+        bm::bvector<>::statistics st;
+        bits.calc_stat(&st);
+        edb.resize(st.max_serialize_mem);
+        edb.resize(bm::serialize(bits, &edb[0]));
+    }
+
+    std::ofstream out(fileName.c_str(), std::ios::binary);
+    writeString(out, std::string(magic, sizeof(magic)));
+    writeUInt(out, formatVersion);
+
+    const unsigned predCount = reg->preds.getSize();
+    writeUInt(out, predCount);
+    for (IDAddress adr = 0; adr < predCount; ++adr) {
+        const Predicate& pred = reg->preds.getByID(ID(ID::MAINKIND_TERM | ID::SUBKIND_TERM_PREDICATE, adr));
+        writeUInt(out, pred.kind);
+        writeString(out, pred.symbol);
+        writeUInt(out, pred.arity);
+    }
+
+    const unsigned termCount = reg->terms.getSize();
+    writeUInt(out, termCount);
+    for (IDAddress adr = 0; adr < termCount; ++adr) {
+        const Term& term = reg->terms.getByID(ID(ID::MAINKIND_TERM, adr));
+        writeUInt(out, term.kind);
+        writeString(out, term.symbol);
+        if (term.isNestedTerm()) {
+            writeUInt(out, term.arguments.size());
+            BOOST_FOREACH (ID arg, term.arguments) writeID(out, arg);
+        }
+        else {
+            writeUInt(out, 0);
+        }
+    }
+
+    const unsigned atomCount = reg->ogatoms.getSize();
+    writeUInt(out, atomCount);
+    for (IDAddress adr = 0; adr < atomCount; ++adr) {
+        const OrdinaryAtom& ogatom = reg->ogatoms.getByAddress(adr);
+        writeUInt(out, ogatom.kind);
+        writeUInt(out, ogatom.tuple.size());
+        BOOST_FOREACH (ID t, ogatom.tuple) writeID(out, t);
+    }
+
+    writeUInt(out, edb.size());
+    if (!edb.empty()) out.write(reinterpret_cast<const char*>(&edb[0]), edb.size());
+
+    out.close();
+    if (!out) {
+        std::remove(fileName.c_str());
+        throw FatalError("Could not write snapshot file " + fileName);
+    }
+    LOG(INFO, "Stored snapshot with " << predCount << " predicates, " << termCount << " terms and " <<
+        atomCount << " ground atoms in " << fileName);
+}
+
+
+void RegistrySnapshot::load(const std::string& fileName)
+{
+    DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sidload, "RegistrySnapshot::load");
+
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(fileName);
+    }
+    catch(const std::exception& e) {
+        throw FatalError("Could not open snapshot file " + fileName + ": " + e.what());
+    }
+    if (!file.is_open()) throw FatalError("Could not open snapshot file " + fileName);
+
+    Reader reader(file.data(), file.data() + file.size());
+    boost::string_ref header = reader.readString();
+    if (!reader.ok() || header != boost::string_ref(magic, sizeof(magic)) || reader.readUInt() != formatVersion)
+        throw FatalError(fileName + " is no snapshot file of this version of dlvhex");
+
+    RegistryPtr reg = ctx.registry();
+    AddressMap map;
+    bool identity = true;
+
+    // symbols are looked up in the mapped file and only copied if they are new
+    map.preds.resize(reader.readCount());
+    for (uint32_t i = 0; i < map.preds.size() && reader.ok(); ++i) {
+        IDKind kind = reader.readUInt();
+        boost::string_ref symbol = reader.readString();
+        int arity = static_cast<int>(reader.readUInt());
+        if (!reader.ok() || !ID(kind, 0).isTerm() || !ID(kind, 0).isPredicateTerm()) {
+            reader.fail();
+            break;
+        }
+        ID id = reg->preds.getIDBySymbol(symbol, TermTable::hashSymbol(symbol));
+        if (id == ID_FAIL) id = reg->preds.storeAndGetID(Predicate(kind, symbol.to_string(), arity));
+        map.preds[i] = id.address;
+    }
+
+    // terms are mapped in order, such that arguments can only refer to terms mapped before
+    // (a forward reference fails in readTerm instead of reading an unmapped address)
+    uint32_t terms = reader.readCount();
+    map.terms.reserve(terms);
+    for (uint32_t i = 0; i < terms && reader.ok(); ++i) {
+        IDKind kind = reader.readUInt();
+        boost::string_ref symbol = reader.readString();
+        if (!reader.ok() || !ID(kind, 0).isTerm()) {
+            reader.fail();
+            break;
+        }
+        std::vector<ID> arguments(reader.readCount());
+        // arguments are stored before the nested term
+        BOOST_FOREACH (ID& arg, arguments) arg = reader.readTerm(map);
+        if (!reader.ok()) break;
+        ID id = reg->terms.getIDBySymbol(symbol, TermTable::hashSymbol(symbol));
+        if (id == ID_FAIL) {
+            Term term(kind, symbol.to_string());
+            if (!arguments.empty()) term.arguments = arguments;
+            id = reg->terms.storeAndGetID(term);
+        }
+        map.terms.push_back(id.address);
+    }
+
+    map.ogatoms.resize(reader.readCount());
+    for (uint32_t i = 0; i < map.ogatoms.size() && reader.ok(); ++i) {
+        IDKind kind = reader.readUInt();
+        if (!reader.ok() || !ID(kind, 0).isAtom() || !ID(kind, 0).isOrdinaryGroundAtom()) {
+            reader.fail();
+            break;
+        }
+        OrdinaryAtom ogatom(kind);
+        ogatom.tuple.resize(reader.readCount());
+        BOOST_FOREACH (ID& t, ogatom.tuple) t = reader.readTerm(map);
+        if (!reader.ok() || ogatom.tuple.empty()) {
+            reader.fail();
+            break;
+        }
+        map.ogatoms[i] = reg->storeOrdinaryGAtom(ogatom).address;
+        identity &= (map.ogatoms[i] == i);
+    }
+
+    uint32_t len;
+    const unsigned char* serialized = reader.readBytes(len);
+    if (!reader.ok())
+        throw FatalError("Truncated or corrupt snapshot file " + fileName);
+
+    if (!ctx.edb) ctx.edb.reset(new Interpretation(reg));
+    if (len > 0) {
+        // bm::deserialize takes no length: readBytes ensured that the block lies within the file,
+        // the number of bytes which were actually read and the bits are checked before they are used
+        bm::bvector<> bits;
+        if (bm::deserialize(bits, serialized) > len)
+            throw FatalError("Corrupt snapshot file " + fileName);
+        if (map.ogatoms.empty() ? bits.any() : bits.get_next(map.ogatoms.size() - 1) != 0)
+            throw FatalError("Corrupt snapshot file " + fileName);
+        if (identity) {
+            ctx.edb->getStorage() |= bits;
+        }
+        else {
+            bm::bvector<>::enumerator en = bits.first();
+            bm::bvector<>::enumerator en_end = bits.end();
+            for (; en < en_end; ++en) ctx.edb->setFact(map.ogatoms[*en]);
+        }
+    }
+    LOG(INFO, "Loaded snapshot with " << map.preds.size() << " predicates, " << map.terms.size() << " terms and " <<
+        map.ogatoms.size() << " ground atoms from " << fileName << (identity ? "" : " (addresses were remapped)"));
+}
+
+
+DLVHEX_NAMESPACE_END
+
+// vim:expandtab:ts=4:sw=4:
+// mode: C++
+// End:
@@ -52,6 +52,7 @@
 #include "dlvhex2/HexParser.h"
 #include "dlvhex2/Printer.h"
 #include "dlvhex2/Registry.h"
+#include "dlvhex2/RegistrySnapshot.h"
 #include "dlvhex2/PluginContainer.h"
 #include "dlvhex2/LiberalSafetyChecker.h"
 #include "dlvhex2/DependencyGraph.h"
@@ -59,6 +60,7 @@
 #include "dlvhex2/FinalEvalGraph.h"
 #include "dlvhex2/EvalGraphBuilder.h"
 #include "dlvhex2/DumpingEvalGraphBuilder.h"
+#include "dlvhex2/ProfilingEvalGraphBuilder.h"
 #include "dlvhex2/AnswerSetPrinterCallback.h"
 #include "dlvhex2/PlainAuxPrinter.h"
 #include "dlvhex2/SafetyChecker.h"
@@ -278,10 +280,21 @@ void ParseState::parse(ProgramCtx* ctx)
         }
     }
 
+    // register symbols and facts of a snapshot before the input refers to them
+    const std::string& loadSnapshot = ctx->config.getStringOption("LoadSnapshot");
+    if( !loadSnapshot.empty() ) {
+        RegistrySnapshot(*ctx).load(loadSnapshot);
+    }
+
     // parse
     assert(!!ctx->parser);
     ctx->parser->parse(ctx->inputProvider, *ctx);
 
+    const std::string& saveSnapshot = ctx->config.getStringOption("SaveSnapshot");
+    if( !saveSnapshot.empty() ) {
+        RegistrySnapshot(*ctx).save(saveSnapshot);
+    }
+
     // free input provider memory
     assert(ctx->inputProvider.use_count() == 1);
     ctx->inputProvider.reset();
@@ -553,7 +566,13 @@ void CreateEvalGraphState::createEvalGraph(ProgramCtx* ctx)
     FinalEvalGraphPtr evalgraph(new FinalEvalGraph);
 
     EvalGraphBuilderPtr egbuilder;
-    if( ctx->config.getOption("DumpEvaluationPlan") ) {
+    if( ctx->config.getOption("DumpEvaluationProfile") ) {
+        ctx->evalProfile.reset(new EvalProfile(ctx->registry()));
+        egbuilder.reset(new ProfilingEvalGraphBuilder(
+            *ctx, *ctx->compgraph, *evalgraph, ctx->aspsoftware,
+            ctx->evalProfile));
+    }
+    else if( ctx->config.getOption("DumpEvaluationPlan") ) {
         egbuilder.reset(new DumpingEvalGraphBuilder(
             *ctx, *ctx->compgraph, *evalgraph, ctx->aspsoftware,
             ctx->config.getStringOption("DumpEvaluationPlanFile")));
@@ -689,6 +708,10 @@ namespace
             ModelBuilderConfig<FinalEvalGraph> cfg(*ctx->evalgraph);
             cfg.redundancyElimination = true;
             cfg.constantSpace = ctx->config.getOption("UseConstantSpace") == 1;
+            cfg.parallelThreads = ctx->config.getOption("ModelBuilderThreads");
+            cfg.modelBufferSize = ctx->config.getOption("ModelBufferSize");
+            cfg.modelQueueSize = ctx->config.getOption("ModelQueueSize");
+            cfg.compactModels = ctx->config.getOption("CompactModels") == 1;
             ctx->modelBuilder = ModelBuilderPtr(ctx->modelBuilderFactory(cfg));
         }
         return *ctx->modelBuilder;
@@ -872,6 +895,9 @@ namespace
             ctx->config.getOption("OptimizationByDlvhex") == 1*/);
         ModelBuilder<FinalEvalGraph>& mb = createModelBuilder(ctx);
         const unsigned mcountLimit = ctx->config.getOption("NumberOfModels");
+        // with --goal=optimal the search must not stop before the optimum is known,
+        // the model limit then only applies to the output
+        const unsigned searchLimit = (ctx->config.getStringOption("Goal") == "optimal") ? 0 : mcountLimit;
         unsigned mcount = 0;
         bool abort = false;
         std::list<AnswerSetPtr> bestModels;
@@ -924,13 +950,15 @@ namespace
              	mcount++;
             }
         }
-        while( !!om && (mcountLimit == 0 || mcount < mcountLimit) );
+        while( !!om && (searchLimit == 0 || mcount < searchLimit) );
 
         // process cached models
+        unsigned displayed = 0;
         BOOST_FOREACH(AnswerSetPtr answerset, bestModels) {
             abort |= callModelCallbacks(ctx, answerset);
+            displayed++;
             // respect model count limit for cached models
-            if( abort || (mcountLimit != 0 && mcount >= mcountLimit) )
+            if( abort || (mcountLimit != 0 && displayed >= mcountLimit) )
                 break;
         }
 
@@ -939,11 +967,11 @@ namespace
             LOG(INFO,"model building was aborted by callback");
         }
         else {
-            if( mcountLimit == 0 ) {
+            if( searchLimit == 0 ) {
                 LOG(INFO,"model building finished after enumerating all models");
             }
             else {
-                LOG(INFO,"model building finished after enumerating a maximum of " << mcountLimit << " models");
+                LOG(INFO,"model building finished after enumerating a maximum of " << searchLimit << " models");
             }
         }
     }
@@ -1010,6 +1038,14 @@ void PostProcessState::postProcess(ProgramCtx* ctx)
         ctx->modelBuilder.use_count());
     ctx->modelBuilder.reset();
 
+    // model generators are gone, so the profile is complete
+    if( ctx->config.getOption("DumpEvaluationProfile") && !!ctx->evalProfile ) {
+        std::string fname = ctx->config.getStringOption("DumpEvaluationProfileFile");
+        LOG(INFO,"dumping evaluation profile to " << fname);
+        std::ofstream file(fname.c_str());
+        ctx->evalProfile->write(file);
+    }
+
     // use base State class with no failureState -> calling it will always throw an exception
     boost::shared_ptr<State> next(new State);
     changeState(ctx, next);
@@ -122,7 +122,7 @@ bool UnfoundedSetChecker::isUnfoundedSet(InterpretationConstPtr compatibleSet, I
     // For check using support sets
     InterpretationPtr supportSetVerification;
     InterpretationPtr auxToVerify;
-    if (ctx.config.getOption("SupportSets")) {
+    if (ctx.config.getOption(Configuration::OPTION_SUPPORT_SETS)) {
         // take external atom values from the ufsCandidate and ordinary atoms from I \ U
         DBGLOG(DBG, "Constructing interpretation for external atom evaluation from " << *ufsCandidate);
         supportSetVerification = InterpretationPtr(new Interpretation(reg));
@@ -147,7 +147,7 @@ bool UnfoundedSetChecker::isUnfoundedSet(InterpretationConstPtr compatibleSet, I
             ufsVerStatus.externalAtomAddressToAuxIndices[eaID.address].size() == 0) continue;
         const ExternalAtom& eatom = reg->eatoms.getByID(eaID);
 
-        if  (ctx.config.getOption("SupportSets") &&
+        if  (ctx.config.getOption(Configuration::OPTION_SUPPORT_SETS) &&
             (eatom.getExtSourceProperties().providesCompletePositiveSupportSets() || eatom.getExtSourceProperties().providesCompleteNegativeSupportSets()) &&
         agp.allowsForVerificationUsingCompleteSupportSets()) {
             DBGLOG(DBG, "Verifying " << eaID << " for UFS verification using complete support sets (" << *supportSetVerification << ")");
@@ -173,7 +173,7 @@ bool UnfoundedSetChecker::isUnfoundedSet(InterpretationConstPtr compatibleSet, I
             if (!verifyExternalAtomByEvaluation(eaID, ufsCandidate, compatibleSet, ufsVerStatus)) {
                 #ifdef DOBOTHCHECKS
                 // if we did already a support set-based check, assert that it also failed
-                assert((!ctx.config.getOption("SupportSets") || isUFS == suppSetResult) &&
+                assert((!ctx.config.getOption(Configuration::OPTION_SUPPORT_SETS) || isUFS == suppSetResult) &&
                     "Explicit and support set approach for UFS checking gave different answers");
                 #endif
                 isUFS = false;
@@ -241,7 +241,7 @@ InterpretationConstPtr ufsCandidate, InterpretationConstPtr compatibleSet,
 UnfoundedSetVerificationStatus& ufsVerStatus
 )
 {
-    if (ctx.config.getOption("ExternalAtomVerificationFromLearnedNogoods")) {
+    if (ctx.config.getOption(Configuration::OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS)) {
         DLVHEX_BENCHMARK_REGISTER_AND_SCOPE(sideav, "UFS checker verifyEAtom by eav (attempt)");
         BOOST_FOREACH (IDAddress adr, ufsVerStatus.auxiliariesToVerify){
             ufsVerStatus.eaInput->setFact(ufsCandidate->getFact(adr));
@@ -292,7 +292,7 @@ UnfoundedSetVerificationStatus& ufsVerStatus
                     solver->addNogood(transformed.second);
                 }
 
-	            if (ctx.config.getOption("ExternalAtomVerificationFromLearnedNogoods")) {
+	            if (ctx.config.getOption(Configuration::OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS)) {
 		            eavTree.addNogood(ng, reg, true);
 	            }
             }
@@ -2007,7 +2007,7 @@ void AssumptionBasedUnfoundedSetChecker::learnNogoodsFromMainSearch(bool reset)
                     solver->addNogood(transformed.second);
                 }
 
-	            if (ctx.config.getOption("ExternalAtomVerificationFromLearnedNogoods")) {
+	            if (ctx.config.getOption(Configuration::OPTION_EXTERNAL_ATOM_VERIFICATION_FROM_LEARNED_NOGOODS)) {
 		            eavTree.addNogood(ng, reg, true);
 	            }
             }
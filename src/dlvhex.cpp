@@ -147,10 +147,12 @@
 #include "dlvhex2/EvalHeuristicGreedy.h"
 #include "dlvhex2/EvalHeuristicMonolithic.h"
 #include "dlvhex2/EvalHeuristicFromFile.h"
+#include "dlvhex2/EvalHeuristicProfile.h"
 #include "dlvhex2/ExternalAtomEvaluationHeuristics.h"
 #include "dlvhex2/UnfoundedSetCheckHeuristics.h"
 #include "dlvhex2/OnlineModelBuilder.h"
 #include "dlvhex2/OfflineModelBuilder.h"
+#include "dlvhex2/ParallelModelBuilder.h"
 
 // internal plugins
 #include "dlvhex2/QueryPlugin.h"
@@ -243,10 +245,19 @@ printUsage(std::ostream &out, const char* whoAmI, bool full)
         << "                      Only display instances of the specified predicate(s)." << std::endl
         << "     --nofacts        Do not output EDB facts." << std::endl
         << " -n, --number=<num>   Limit number of displayed models to <num>, 0 (default) means all." << std::endl
+        << "     --goal=G         Tune model building, clasp and external atom evaluation for goal G, one of" << std::endl
+        << "                         first            : Compute one model as fast as possible (implies -n=1)" << std::endl
+        << "                         all (default)    : Enumerate all models" << std::endl
+        << "                         optimal          : Compute one optimal model under weak constraints (implies -n=1)" << std::endl
+        << "                      Options given explicitly take precedence over the goal. The goal only sets" << std::endl
+        << "                      defaults of other options, the order in which the online model builder" << std::endl
+        << "                      evaluates units is the same for all goals." << std::endl
         << " -N, --maxint=<num>   Set maximum integer (#maxint in the program takes precedence over the parameter)." << std::endl
         << "     --weaksafety     Skip strong safety check." << std::endl
         << "     --strongsafety   Applies traditional strong safety criteria." << std::endl
         << "     --liberalsafety  Uses more liberal safety conditions than strong safety (default)." << std::endl
+        << "     --domexplcache=N Reuse the last N domain-exploration results of each evaluation unit (default: 16, 0 disables reuse)." << std::endl
+        << "                      (only useful with --liberalsafety)" << std::endl
         << "     --mlp            Use dlvhex+mlp solver (modular nonmonotonic logic programs)." << std::endl
         << "     --forget         Forget previous instantiations that are not involved in current computation (mlp setting)." << std::endl
         << "     --split          Use instantiation splitting techniques." << std::endl
@@ -360,7 +371,7 @@ printUsage(std::ostream &out, const char* whoAmI, bool full)
         << "                         periodic         : Do UFS check in periodic intervals" << std::endl
         << "     --modelqueuesize=N" << std::endl
         << "                      Size of the model queue, i.e. number of models which can be computed in parallel." << std::endl
-        << "                      Default value is 5. The option is only useful for clasp solver." << std::endl
+        << "                      Default value is 5. The option is only useful for clasp solver and --modelbuilder=pipelined." << std::endl
         << "     --solver=S       Use S as ASP engine, where S is one of dlv, dlvdb, libdlv, libclingo, genuineii, genuinegi, genuineic, genuinegc" << std::endl
         << "                        (genuineii=(i)nternal grounder and (i)nternal solver; genuinegi=(g)ringo grounder and (i)nternal solver" << std::endl
         << "                         genuineic=(i)nternal grounder and (c)lasp solver; genuinegc=(g)ringo grounder and (c)lasp solver)." << std::endl
@@ -375,12 +386,34 @@ printUsage(std::ostream &out, const char* whoAmI, bool full)
         << "                         manual:<file>    : Read 'collapse <idxs> share <idxs>' commands from <file>" << std::endl
         << "                                            where component indices <idx> are from '--graphviz=comp'" << std::endl
         << "                         asp:<script>     : Use asp program <script> as eval heuristic" << std::endl
+        << "                         profile:<file>   : Like greedy, but merge components only if this is predicted to be" << std::endl
+        << "                                            cheaper according to metrics from '--dumpevalprofile=<file>'" << std::endl
         << "     --forcegc        Always use the guess and check model generator." << std::endl
-        << " -m, --modelbuilder=M Use M as model builder, where M is one of (online,offline)." << std::endl
+        << " -m, --modelbuilder=M Use M as model builder, where M is one of (online,offline,parallel,pipelined)." << std::endl
+        << "                      parallel computes models of different units ahead on a thread pool," << std::endl
+        << "                      pipelined runs each model generator in its own thread streaming models to successor units" << std::endl
+        << "                      through queues of size --modelqueuesize" << std::endl
+        << "                      (both enumerate models in the same order as online; not with --transunitlearning)." << std::endl
+        << "     --modelbuilderthreads=N" << std::endl
+        << "                      Number of threads of --modelbuilder=parallel (default: 0 = one per core)." << std::endl
+        << "     --modelbuffersize=N" << std::endl
+        << "                      Maximum number of models computed ahead per unit by --modelbuilder=parallel (default: 4)." << std::endl
         << "     --nocache        Do not cache queries to and answers from external atoms." << std::endl
+        << "     --groundcache=D  Store ground programs of evaluation units in directory D and reuse them in later runs" << std::endl
+        << "                      if a unit is grounded under the same input again (only with gringo)." << std::endl
         << "     --iauxinaux      Keep auxiliary input predicates in auxiliary external atom predicates (can increase or decrease efficiency)." << std::endl
-        << "     --constspace     Free partial models immediately after using them. This may cause some models." << std::endl
-        << "                      to be computed multiple times. (Not with monolithic.)" << std::endl
+        << "     --constspace     Free partial models immediately after using them and drop consumed answer sets" << std::endl
+        << "                      from the model graph. This may cause some models to be computed multiple times." << std::endl
+        << "                      (Not with monolithic.)" << std::endl
+        << "     --compactmodels  Store models of evaluation units in compressed form, choosing per block of atoms" << std::endl
+        << "                      between plain and run-length encoded storage depending on density" << std::endl
+        << "                      (reduces memory for large programs with many units and models)." << std::endl
+        << "     --noatomtext     Do not store the textual representation of ground atoms, create it when printing" << std::endl
+        << "                      (reduces memory for large ground programs, printing becomes slower)." << std::endl
+        << "     --save-snapshot=F" << std::endl
+        << "                      Write terms, predicates, ground atoms and facts of the parsed program to binary file F." << std::endl
+        << "     --load-snapshot=F" << std::endl
+        << "                      Load a snapshot written by --save-snapshot before parsing (replaces parsing large fact bases)." << std::endl
         << "     --transunitlearning" << std::endl
         << "                      Analyze inconsistent units and propagate reasons to predecessor units." << std::endl
         << "     --transunitlearningpud" << std::endl
@@ -394,6 +427,11 @@ printUsage(std::ostream &out, const char* whoAmI, bool full)
 
         << std::endl << "Debugging and General Options:" << std::endl
         << "     --dumpevalplan=F Dump evaluation plan (usable as manual heuristics) to file F." << std::endl
+        << "     --dumpevalprofile=F" << std::endl
+        << "                      Dump per-unit metrics of the evaluation (instantiations, models, ground atoms, times for" << std::endl
+        << "                      grounding, external atoms and UFS checks) to file F (usable with --heuristics=profile:F)." << std::endl
+        << "                      Requires --enable-benchmark and cannot be used with --dumpevalplan" << std::endl
+        << "                      or --modelbuilder=parallel|pipelined." << std::endl
         << "     --dumpeanogoods=F" << std::endl
         << "                      Dump learned EA nogoods to file F." << std::endl
         << " -v, --verbose[=N]    Specify verbose category (if option is used without [=N] then default is 1):" << std::endl
@@ -678,6 +716,11 @@ int main(int argc, char *argv[])
         }
         #endif
 
+        // a snapshot may provide the whole input
+        if( !!pctx.inputProvider && !pctx.inputProvider->hasContent() &&
+            !pctx.config.getStringOption("LoadSnapshot").empty() )
+            pctx.inputProvider->addStringInput("", "snapshot");
+
         // now we check if we got input
         if( !pctx.inputProvider || !pctx.inputProvider->hasContent() )
             throw UsageError("no input specified!");
@@ -907,6 +950,16 @@ Config& config, ProgramCtx& pctx)
         { "useatomcompliance", no_argument, 0, 75 },
         { "eaevaldebounce", required_argument, 0, 76 },
         { "claspsatdefernprop", required_argument, 0, 77 },
+        { "domexplcache", required_argument, 0, 79 },
+        { "groundcache", required_argument, 0, 80 },
+        { "modelbuilderthreads", required_argument, 0, 81 },
+        { "modelbuffersize", required_argument, 0, 82 },
+        { "dumpevalprofile", required_argument, 0, 83 },
+        { "compactmodels", no_argument, 0, 84 },
+        { "goal", required_argument, 0, 85 },
+        { "noatomtext", no_argument, 0, 86 },
+        { "save-snapshot", required_argument, 0, 87 },
+        { "load-snapshot", required_argument, 0, 88 },
         { NULL, 0, NULL, 0 }
     };
 
@@ -924,7 +977,13 @@ Config& config, ProgramCtx& pctx)
     bool heuristicChosen = false;
     bool heuristicMonolithic = false;
     bool solverSet = false;
+    bool parallelModelBuilder = false;
+    bool pipelinedModelBuilder = false;
     bool forceoptmode = false;
+    bool specifiedNumberOfModels = false;
+    bool specifiedClaspConfig = false;
+    bool specifiedEAEvalHeuristics = false;
+    bool specifiedModelBufferSize = false;
     while ((ch = getopt_long(argc, argv, shortopts, longopts, NULL)) != -1) {
         switch (ch) {
             case 'h':
@@ -1003,6 +1062,9 @@ Config& config, ProgramCtx& pctx)
                     else if( heuri.substr(0,4) == "asp:" ) {
                         pctx.evalHeuristic.reset(new EvalHeuristicASP(heuri.substr(4)));
                     }
+                    else if( heuri.substr(0,8) == "profile:" ) {
+                        pctx.evalHeuristic.reset(new EvalHeuristicProfile(heuri.substr(8)));
+                    }
                     else {
                         throw UsageError("unknown evaluation heuristic '" + heuri +"' specified!");
                     }
@@ -1011,7 +1073,7 @@ Config& config, ProgramCtx& pctx)
                 break;
 
             case 'm':
-                // modelbuilder={offline,online}
+                // modelbuilder={offline,online,parallel,pipelined}
                 {
                     std::string modelbuilder(optarg);
                     if( modelbuilder == "offline" ) {
@@ -1022,6 +1084,17 @@ Config& config, ProgramCtx& pctx)
                         pctx.modelBuilderFactory =
                             boost::factory<OnlineModelBuilder<FinalEvalGraph>*>();
                     }
+                    else if( modelbuilder == "parallel" ) {
+                        pctx.modelBuilderFactory =
+                            boost::factory<ParallelModelBuilder<FinalEvalGraph>*>();
+                        parallelModelBuilder = true;
+                    }
+                    else if( modelbuilder == "pipelined" ) {
+                        pctx.modelBuilderFactory =
+                            boost::factory<PipelinedModelBuilder<FinalEvalGraph>*>();
+                        parallelModelBuilder = true;
+                        pipelinedModelBuilder = true;
+                    }
                     else {
                         throw UsageError("unknown model builder '" + modelbuilder +"' specified!");
                     }
@@ -1043,6 +1116,7 @@ Config& config, ProgramCtx& pctx)
                     LOG(ERROR,"could not parse model count '" << optarg << "' - using default=" << models << "!");
                 }
                 pctx.config.setOption("NumberOfModels", models);
+                specifiedNumberOfModels = true;
             }
             break;
 
@@ -1422,6 +1496,7 @@ Config& config, ProgramCtx& pctx)
                 else {
                     throw GeneralError(std::string("Unknown external atom evaluation heuristic: \"") + heur + std::string("\""));
                 }
+                specifiedEAEvalHeuristics = true;
             }
             break;
 
@@ -1469,7 +1544,7 @@ Config& config, ProgramCtx& pctx)
                 if (queuesize < 1) {
                     throw GeneralError(std::string("Model queue size must be > 0"));
                 }
-                pctx.config.setOption("ModelQueueSize", queuesize); break;
+                pctx.config.setOption("ModelQueueSize", queuesize);
                 specifiedModelQueueSize = true;
             }
             break;
@@ -1483,7 +1558,10 @@ Config& config, ProgramCtx& pctx)
                 pctx.config.setOption("FLPDecisionCriterionE", 0);
                 break;
 
-            case 36: pctx.config.setStringOption("ClaspConfiguration",std::string(optarg)); break;
+            case 36:
+                pctx.config.setStringOption("ClaspConfiguration",std::string(optarg));
+                specifiedClaspConfig = true;
+                break;
 
             case 37:
                 pctx.config.setOption("DumpStats",1);
@@ -1824,9 +1902,123 @@ Config& config, ProgramCtx& pctx)
                     pctx.config.setOption("ClaspSATDeferNPropagations", deferval);
                 }
                 break;
+            case 79:
+                {
+                    int cachesize = 0;
+                    try
+                    {
+                        if( optarg[0] == '=' )
+                            cachesize = boost::lexical_cast<unsigned>(&optarg[1]);
+                        else
+                            cachesize = boost::lexical_cast<unsigned>(optarg);
+                    }
+                    catch(const boost::bad_lexical_cast&) {
+                        LOG(ERROR,"domexplcache '" << optarg << "' does not specify an integer value");
+                    }
+                    pctx.config.setOption("DomainExplorationCacheSize", cachesize);
+                }
+                break;
+            case 80:
+                pctx.config.setStringOption("GroundingCacheDir", optarg);
+                break;
+            case 81:
+                {
+                    int threads = 0;
+                    try
+                    {
+                        if( optarg[0] == '=' )
+                            threads = boost::lexical_cast<unsigned>(&optarg[1]);
+                        else
+                            threads = boost::lexical_cast<unsigned>(optarg);
+                    }
+                    catch(const boost::bad_lexical_cast&) {
+                        LOG(ERROR,"modelbuilderthreads '" << optarg << "' does not specify an integer value");
+                    }
+                    pctx.config.setOption("ModelBuilderThreads", threads);
+                }
+                break;
+            case 82:
+                {
+                    int buffersize = 0;
+                    try
+                    {
+                        if( optarg[0] == '=' )
+                            buffersize = boost::lexical_cast<unsigned>(&optarg[1]);
+                        else
+                            buffersize = boost::lexical_cast<unsigned>(optarg);
+                    }
+                    catch(const boost::bad_lexical_cast&) {
+                        LOG(ERROR,"modelbuffersize '" << optarg << "' does not specify an integer value");
+                    }
+                    pctx.config.setOption("ModelBufferSize", buffersize);
+                    specifiedModelBufferSize = true;
+                }
+                break;
+
+            case 83:
+                {
+                    std::string fname(optarg);
+                    pctx.config.setOption("DumpEvaluationProfile",1);
+                    pctx.config.setStringOption("DumpEvaluationProfileFile",fname);
+                }
+            #if !defined(DLVHEX_BENCHMARK)
+                throw std::runtime_error("you can only use --dumpevalprofile if you configured with --enable-benchmark");
+            #endif
+                break;
+
+            case 84:
+                pctx.config.setOption("CompactModels",1);
+                break;
+
+            case 85:
+                {
+                    std::string goal(optarg);
+                    if (goal != "first" && goal != "all" && goal != "optimal")
+                        throw UsageError("unknown goal '" + goal + "'");
+                    pctx.config.setStringOption("Goal",goal);
+                }
+                break;
+
+            case 86:
+                pctx.config.setOption("StoreAtomText",0);
+                break;
+
+            case 87:
+                pctx.config.setStringOption("SaveSnapshot", optarg);
+                break;
+
+            case 88:
+                pctx.config.setStringOption("LoadSnapshot", optarg);
+                break;
+        }
+    }
+
+    // the goal only provides defaults, options given explicitly by the user take precedence;
+    // the scheduling of units in the model builders does not depend on the goal
+    {
+        const std::string& goal = pctx.config.getStringOption("Goal");
+        if (goal == "first") {
+            // one model is enough: restart aggressively in clasp, let external atoms prune
+            // candidates as soon as their input is complete, and let parallel and pipelined
+            // model builders compute at most one model ahead per unit
+            if (!specifiedNumberOfModels) pctx.config.setOption("NumberOfModels", 1);
+            if (!specifiedClaspConfig) pctx.config.setStringOption("ClaspConfiguration", "jumpy");
+            if (!specifiedEAEvalHeuristics) {
+                pctx.defaultExternalAtomEvaluationHeuristicsFactory.reset(new ExternalAtomEvaluationHeuristicsInputCompleteFactory());
+                pctx.config.setOption("NoPropagator", 0);
+            }
+            if (!specifiedModelBufferSize) pctx.config.setOption("ModelBufferSize", 1);
+            if (!specifiedModelQueueSize) pctx.config.setOption("ModelQueueSize", 1);
+        }
+        else if (goal == "optimal") {
+            // two-step optimization displays only optimal models, otherwise the search continues
+            // until the optimum is known and the limit only applies to the output (see State.cpp)
+            if (!specifiedNumberOfModels) pctx.config.setOption("NumberOfModels", 1);
         }
     }
 
+    pctx.registry()->ogatoms.setStoreText(pctx.config.getOption("StoreAtomText") == 1);
+
     // global constraints
     if (pctx.config.getOption("UFSCheck") && !pctx.config.getOption("GenuineSolver")) {
         // if solver was not set by user, disable it silently, otherwise print a warning
@@ -1849,7 +2041,7 @@ Config& config, ProgramCtx& pctx)
         }
         pctx.config.setOption("LiberalSafety", 0);
     }
-    if (specifiedModelQueueSize && pctx.config.getOption("GenuineSolver") <= 2) {
+    if (specifiedModelQueueSize && pctx.config.getOption("GenuineSolver") <= 2 && !pipelinedModelBuilder) {
         LOG(WARNING, "Model caching (modelqueuesize) is only compatible with clasp backend");
     }
     if (pctx.config.getOption("GenuineSolver") || pctx.config.getOption("LiberalSafety") || heuristicMonolithic) {
@@ -1888,6 +2080,19 @@ Config& config, ProgramCtx& pctx)
     if (!pctx.config.getOption("LiberalSafety") && pctx.config.getOption("NoOuterExternalAtoms")){
         throw GeneralError("Option --noouterexternalatoms can only be used with --liberalsafety");
     }
+    // trans-unit learning adds nogoods to model generators of predecessor units which may run concurrently
+    if (parallelModelBuilder && pctx.config.getOption("TransUnitLearning")){
+        throw GeneralError("Option --transunitlearning cannot be used with --modelbuilder=parallel or --modelbuilder=pipelined");
+    }
+    // profiles attribute the global benchmark counters to the unit whose model generator is running,
+    // which is only meaningful if no other unit runs at the same time
+    if (parallelModelBuilder && pctx.config.getOption("DumpEvaluationProfile")){
+        throw GeneralError("Option --dumpevalprofile cannot be used with --modelbuilder=parallel or --modelbuilder=pipelined");
+    }
+    // both are implemented by different evaluation graph builders
+    if (pctx.config.getOption("DumpEvaluationProfile") && pctx.config.getOption("DumpEvaluationPlan")){
+        throw GeneralError("Options --dumpevalprofile and --dumpevalplan cannot be used together");
+    }
 
     // configure plugin path
     configurePluginPath(config.optionPlugindir);
@@ -0,0 +1,222 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestEvalProfile.cpp
+ *
+ * @brief  Test recording, writing, loading and using evaluation profiles.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/EvalProfile.h"
+#include "dlvhex2/Error.h"
+#include "dlvhex2/HexParser.h"
+#include "dlvhex2/InputProvider.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/Interpretation.h"
+
+#define BOOST_TEST_MODULE "TestEvalProfile"
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <unistd.h>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // model generator factory whose model generators return a fixed number of empty models
+  class CountingModelGeneratorFactory:
+    public ModelGeneratorFactoryBase<Interpretation>
+  {
+  public:
+    class ModelGenerator:
+      public ModelGeneratorBase<Interpretation>
+    {
+    public:
+      RegistryPtr reg;
+      unsigned left;
+
+      ModelGenerator(InterpretationConstPtr input, RegistryPtr reg, unsigned models):
+        ModelGeneratorBase<Interpretation>(input), reg(reg), left(models) {}
+
+      virtual InterpretationPtr generateNextModel()
+      {
+        if( left == 0 )
+          return InterpretationPtr();
+        left--;
+        return InterpretationPtr(new Interpretation(reg));
+      }
+    };
+
+    RegistryPtr reg;
+    unsigned models;
+
+    CountingModelGeneratorFactory(RegistryPtr reg, unsigned models):
+      reg(reg), models(models) {}
+
+    virtual ModelGeneratorPtr createModelGenerator(InterpretationConstPtr input)
+      { return ModelGeneratorPtr(new ModelGenerator(input, reg, models)); }
+  };
+
+  // parses rules into a component
+  ComponentGraph::ComponentInfo parseComponent(ProgramCtx& ctx, const std::string& program)
+  {
+    ctx.idb.clear();
+    std::stringstream ss(program);
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "testinput");
+    ModuleHexParser parser;
+    parser.parse(ip, ctx);
+
+    ComponentGraph::ComponentInfo ci;
+    BOOST_FOREACH(ID rid, ctx.idb)
+    {
+      if( rid.isConstraint() )
+        ci.innerConstraints.push_back(rid);
+      else
+        ci.innerRules.push_back(rid);
+    }
+    return ci;
+  }
+
+  // enumerates all models of a (wrapped) factory once
+  void evaluate(EvalProfile::ModelGeneratorFactoryPtr mgf, RegistryPtr reg)
+  {
+    ModelGeneratorBase<Interpretation>::Ptr mg =
+      mgf->createModelGenerator(InterpretationConstPtr(new Interpretation(reg)));
+    while( !!mg->generateNextModel() ) { }
+  }
+
+  std::string temporaryFile()
+  {
+    char tmpl[] = "/tmp/TestEvalProfileXXXXXX";
+    int fd = mkstemp(tmpl);
+    BOOST_REQUIRE(fd != -1);
+    close(fd);
+    return tmpl;
+  }
+
+  std::string written(const EvalProfile& profile)
+  {
+    std::stringstream ss;
+    profile.write(ss);
+    return ss.str();
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testRecordWriteLoadEstimate)
+{
+  ProgramCtx ctx;
+  ctx.setupRegistry(RegistryPtr(new Registry));
+  RegistryPtr reg = ctx.registry();
+
+  ComponentGraph::ComponentInfo ca = parseComponent(ctx, "a :- not b. b :- not a. :- a, c.");
+  ComponentGraph::ComponentInfo cb = parseComponent(ctx, "c :- a.");
+  ComponentGraph::ComponentInfo cunknown = parseComponent(ctx, "d :- e.");
+  ComponentGraph::ComponentInfo cmerged;
+  cmerged.innerRules.push_back(ca.innerRules.front());
+  cmerged.innerRules.push_back(cb.innerRules.front());
+
+  // unit a is instantiated three times with two models each, unit b once with one model
+  EvalProfile profile(reg);
+  EvalProfile::ModelGeneratorFactoryPtr mgfa = profile.record(ca,
+    EvalProfile::ModelGeneratorFactoryPtr(new CountingModelGeneratorFactory(reg, 2)));
+  EvalProfile::ModelGeneratorFactoryPtr mgfb = profile.record(cb,
+    EvalProfile::ModelGeneratorFactoryPtr(new CountingModelGeneratorFactory(reg, 1)));
+  for(unsigned i = 0; i < 3; ++i)
+    evaluate(mgfa, reg);
+  evaluate(mgfb, reg);
+
+  std::string fname = temporaryFile();
+  {
+    std::ofstream out(fname.c_str());
+    profile.write(out);
+  }
+  EvalProfile loaded(reg);
+  loaded.load(fname);
+  std::remove(fname.c_str());
+  BOOST_CHECK_EQUAL(written(loaded), written(profile));
+
+  std::string text = written(loaded);
+  BOOST_CHECK(text.find("\nunit 3 6 ") != std::string::npos);
+  BOOST_CHECK(text.find("\nunit 1 1 ") != std::string::npos);
+
+  EvalProfile::Estimate ea = loaded.estimate(ca);
+  BOOST_CHECK(ea.known);
+  BOOST_CHECK_EQUAL(ea.models, 2.0);
+  BOOST_CHECK(ea.candidates >= ea.models);
+
+  EvalProfile::Estimate eb = loaded.estimate(cb);
+  BOOST_CHECK(eb.known);
+  BOOST_CHECK_EQUAL(eb.models, 1.0);
+
+  // a component spanning both units has at most as many models as the larger one
+  EvalProfile::Estimate emerged = loaded.estimate(cmerged);
+  BOOST_CHECK(emerged.known);
+  BOOST_CHECK_EQUAL(emerged.models, 2.0);
+  BOOST_CHECK(emerged.time <= ea.time + eb.time);
+
+  BOOST_CHECK(!loaded.estimate(cunknown).known);
+}
+
+BOOST_AUTO_TEST_CASE(testLoadErrors)
+{
+  ProgramCtx ctx;
+  ctx.setupRegistry(RegistryPtr(new Registry));
+
+  EvalProfile missing(ctx.registry());
+  BOOST_CHECK_THROW(missing.load("/nonexistent/evaluation/profile"), FatalError);
+
+  const char* bad[] = {
+    "unit 1 2\nrule a :- b.\n",
+    "rule a :- b.\n",
+    "unit 1 1 1 0 0 0.1 0 0 0\nfoo\n"
+  };
+  BOOST_FOREACH(const char* content, bad)
+  {
+    std::string fname = temporaryFile();
+    {
+      std::ofstream out(fname.c_str());
+      out << content;
+    }
+    EvalProfile profile(ctx.registry());
+    BOOST_CHECK_THROW(profile.load(fname), SyntaxError);
+    std::remove(fname.c_str());
+  }
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -0,0 +1,244 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestGroundProgramCache.cpp
+ *
+ * @brief  Test storing ground programs in the cache and loading them again.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/GroundProgramCache.h"
+#include "dlvhex2/HexParser.h"
+#include "dlvhex2/InputProvider.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Printer.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/Interpretation.h"
+
+#define BOOST_TEST_MODULE "TestGroundProgramCache"
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include <fstream>
+#include <set>
+#include <cstdlib>
+
+#include <dirent.h>
+#include <unistd.h>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // temporary cache directory which is removed together with its files
+  struct CacheDirectory
+  {
+    std::string dir;
+
+    CacheDirectory()
+    {
+      char tmpl[] = "/tmp/TestGroundProgramCacheXXXXXX";
+      BOOST_REQUIRE(mkdtemp(tmpl) != 0);
+      dir = tmpl;
+    }
+
+    ~CacheDirectory()
+    {
+      BOOST_FOREACH(const std::string& file, files())
+        unlink(file.c_str());
+      rmdir(dir.c_str());
+    }
+
+    std::vector<std::string> files() const
+    {
+      std::vector<std::string> ret;
+      DIR* d = opendir(dir.c_str());
+      if( d == 0 )
+        return ret;
+      while( struct dirent* e = readdir(d) )
+      {
+        std::string name(e->d_name);
+        if( name != "." && name != ".." )
+          ret.push_back(dir + "/" + name);
+      }
+      closedir(d);
+      return ret;
+    }
+  };
+
+  void setupCtx(ProgramCtx& ctx, const std::string& dir)
+  {
+    ctx.setupRegistry(RegistryPtr(new Registry));
+    ctx.config.setStringOption("GroundingCacheDir", dir);
+  }
+
+  // parses a ground program and adds a weight rule as produced by gringo
+  OrdinaryASPProgram groundProgram(ProgramCtx& ctx)
+  {
+    std::stringstream ss;
+    ss <<
+      "a. g(b,c)." << std::endl <<
+      "b :- a, not c." << std::endl <<
+      "c :- not b." << std::endl <<
+      "d(x) v e :- b, g(b,c)." << std::endl <<
+      ":- e, not d(x)." << std::endl;
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "testinput");
+    ModuleHexParser parser;
+    parser.parse(ip, ctx);
+
+    RegistryPtr reg = ctx.registry();
+    Rule w(ID::MAINKIND_RULE | ID::SUBKIND_RULE_WEIGHT);
+    w.head.push_back(reg->ogatoms.getIDByString("e"));
+    w.body.push_back(ID::posLiteralFromAtom(reg->ogatoms.getIDByString("a")));
+    w.body.push_back(ID::nafLiteralFromAtom(reg->ogatoms.getIDByString("c")));
+    w.bodyWeightVector.push_back(ID::termFromInteger(1));
+    w.bodyWeightVector.push_back(ID::termFromInteger(2));
+    w.bound = ID::termFromInteger(2);
+    std::vector<ID> idb(ctx.idb);
+    idb.push_back(reg->storeRule(w));
+
+    return OrdinaryASPProgram(reg, idb, ctx.edb, 0, InterpretationConstPtr(new Interpretation(reg)));
+  }
+
+  // textual form of the rules which is comparable across registries
+  std::set<std::string> ruleStrings(RegistryPtr reg, const std::vector<ID>& idb)
+  {
+    std::set<std::string> ret;
+    BOOST_FOREACH(ID rid, idb)
+    {
+      const Rule& r = reg->rules.getByID(rid);
+      std::stringstream ss;
+      ss << printToString<RawPrinter>(rid, reg) << " kind=" << r.kind << " bound=" << r.bound;
+      BOOST_FOREACH(ID w, r.bodyWeightVector)
+        ss << " " << w;
+      ret.insert(ss.str());
+    }
+    return ret;
+  }
+
+  std::set<std::string> factStrings(RegistryPtr reg, InterpretationConstPtr edb)
+  {
+    std::set<std::string> ret;
+    bm::bvector<>::enumerator en = edb->getStorage().first();
+    bm::bvector<>::enumerator en_end = edb->getStorage().end();
+    for(; en < en_end; ++en)
+      ret.insert(printToString<RawPrinter>(reg->ogatoms.getIDByAddress(*en), reg));
+    return ret;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testReloadIntoSameRegistry)
+{
+  CacheDirectory cache;
+  ProgramCtx ctx;
+  setupCtx(ctx, cache.dir);
+  OrdinaryASPProgram original = groundProgram(ctx);
+  BOOST_REQUIRE_EQUAL(original.idb.size(), 5);
+
+  GroundProgramCache gpc(ctx);
+  BOOST_REQUIRE(gpc.enabled());
+  gpc.store("key", original, InterpretationConstPtr(new Interpretation(ctx.registry())));
+
+  // the loaded rules must be the stored ones, not copies with different bounds
+  unsigned rules = ctx.registry()->rules.getSize();
+  OrdinaryASPProgram loaded(ctx.registry(), std::vector<ID>(), InterpretationConstPtr());
+  BOOST_REQUIRE(gpc.load("key", loaded));
+  BOOST_CHECK(loaded.idb == original.idb);
+  BOOST_CHECK_EQUAL(ctx.registry()->rules.getSize(), rules);
+  BOOST_REQUIRE(!!loaded.edb);
+  BOOST_CHECK(loaded.edb->getStorage() == original.edb->getStorage());
+
+  BOOST_FOREACH(ID rid, loaded.idb)
+  {
+    const Rule& r = ctx.registry()->rules.getByID(rid);
+    if( ID(r.kind, 0).isWeightRule() )
+      BOOST_CHECK(r.bound == ID::termFromInteger(2));
+    else
+      BOOST_CHECK(r.bound == ID_FAIL);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testReloadIntoNewRegistry)
+{
+  CacheDirectory cache;
+  ProgramCtx ctx;
+  setupCtx(ctx, cache.dir);
+  OrdinaryASPProgram original = groundProgram(ctx);
+  GroundProgramCache(ctx).store("key", original, InterpretationConstPtr(new Interpretation(ctx.registry())));
+
+  // a new registry with other symbols first, such that all addresses differ
+  ProgramCtx ctx2;
+  setupCtx(ctx2, cache.dir);
+  {
+    std::stringstream ss;
+    ss << "z(1). y :- z(1)." << std::endl;
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "otherinput");
+    ModuleHexParser parser;
+    parser.parse(ip, ctx2);
+  }
+  GroundProgramCache gpc2(ctx2);
+  OrdinaryASPProgram loaded(ctx2.registry(), std::vector<ID>(), InterpretationConstPtr());
+  BOOST_CHECK(!gpc2.load("other key", loaded));
+  BOOST_REQUIRE(gpc2.load("key", loaded));
+
+  BOOST_CHECK(ruleStrings(ctx2.registry(), loaded.idb) == ruleStrings(ctx.registry(), original.idb));
+  BOOST_CHECK(factStrings(ctx2.registry(), loaded.edb) == factStrings(ctx.registry(), original.edb));
+}
+
+BOOST_AUTO_TEST_CASE(testTruncatedCacheFile)
+{
+  CacheDirectory cache;
+  ProgramCtx ctx;
+  setupCtx(ctx, cache.dir);
+  OrdinaryASPProgram original = groundProgram(ctx);
+  GroundProgramCache gpc(ctx);
+  gpc.store("key", original, InterpretationConstPtr(new Interpretation(ctx.registry())));
+
+  std::vector<std::string> files = cache.files();
+  BOOST_REQUIRE_EQUAL(files.size(), 1);
+  std::string content;
+  {
+    std::ifstream in(files[0].c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream out(files[0].c_str(), std::ios::binary | std::ios::trunc);
+    out.write(content.data(), content.size() - 3);
+  }
+
+  OrdinaryASPProgram loaded(ctx.registry(), std::vector<ID>(), InterpretationConstPtr());
+  BOOST_CHECK(!gpc.load("key", loaded));
+  BOOST_CHECK(loaded.idb.empty());
+}
+
+// Local Variables:
+// mode: C++
+// End:
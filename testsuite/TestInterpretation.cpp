@@ -0,0 +1,154 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestInterpretation.cpp
+ *
+ * @brief  Test compacting interpretations as done for joins and models with --compactmodels.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/Logger.h"
+
+#define BOOST_TEST_MODULE "TestInterpretation"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // a sparse part, a dense run and a few atoms far away, like the models of three predecessor units
+  std::vector<InterpretationPtr> predecessorModels(RegistryPtr reg)
+  {
+    std::vector<InterpretationPtr> parts;
+    for(unsigned p = 0; p < 3; ++p)
+      parts.push_back(InterpretationPtr(new Interpretation(reg)));
+    for(IDAddress a = 0; a < 300000; a += 97)
+      parts[0]->setFact(a);
+    for(IDAddress a = 100000; a < 200000; ++a)
+      parts[1]->setFact(a);
+    for(IDAddress a = 1000000; a < 1000100; a += 3)
+      parts[2]->setFact(a);
+    return parts;
+  }
+
+  // joins like OnlineModelBuilder::getInputInterpretation if no predecessor model subsumes the others
+  InterpretationPtr join(const std::vector<InterpretationPtr>& parts, bool compact)
+  {
+    InterpretationPtr pjoin(new Interpretation(*parts.front()));
+    for(unsigned p = 1; p < parts.size(); ++p)
+      pjoin->add(*parts[p]);
+    if( compact )
+      compactInterpretation(*pjoin);
+    return pjoin;
+  }
+
+  std::vector<IDAddress> trueAtoms(const Interpretation& intr)
+  {
+    std::vector<IDAddress> ret;
+    Interpretation::TrueBitIterator it, it_end;
+    for(boost::tie(it, it_end) = intr.trueBits(); it != it_end; ++it)
+      ret.push_back(*it);
+    return ret;
+  }
+
+  unsigned memoryUsed(const Interpretation& intr)
+  {
+    Interpretation::Storage::statistics st;
+    intr.getStorage().calc_stat(&st);
+    return st.memory_used;
+  }
+
+  void checkSameContent(const Interpretation& compacted, const Interpretation& plain)
+  {
+    BOOST_CHECK(compacted == plain);
+    BOOST_CHECK_EQUAL(compacted.getStorage().count(), plain.getStorage().count());
+    BOOST_CHECK(trueAtoms(compacted) == trueAtoms(plain));
+    for(IDAddress a = 0; a < 1100000; a += 1009)
+      BOOST_REQUIRE_EQUAL(compacted.getFact(a), plain.getFact(a));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCompactJoinPreservesContent)
+{
+  RegistryPtr reg(new Registry);
+  std::vector<InterpretationPtr> parts = predecessorModels(reg);
+
+  InterpretationPtr compacted = join(parts, true);
+  InterpretationPtr plain = join(parts, false);
+  checkSameContent(*compacted, *plain);
+  BOOST_CHECK(memoryUsed(*compacted) < memoryUsed(*plain));
+
+  // compacted joins are still used as input and for subsumption checks
+  for(unsigned p = 0; p < parts.size(); ++p)
+  {
+    BOOST_CHECK(interpretationSubsumes(*compacted, *parts[p]));
+    BOOST_CHECK(!interpretationSubsumes(*parts[p], *compacted));
+  }
+
+  // a compacted model can be copied into the next join
+  InterpretationPtr copied(new Interpretation(*compacted));
+  checkSameContent(*copied, *plain);
+}
+
+BOOST_AUTO_TEST_CASE(testAddToCompactJoin)
+{
+  RegistryPtr reg(new Registry);
+  std::vector<InterpretationPtr> parts = predecessorModels(reg);
+
+  InterpretationPtr compacted = join(parts, true);
+  InterpretationPtr plain = join(parts, false);
+
+  // atoms in existing blocks, in new blocks and beyond the end of the join
+  Interpretation later(reg);
+  for(IDAddress a = 0; a < 1200000; a += 13)
+    later.setFact(a);
+  compacted->add(later);
+  plain->add(later);
+  checkSameContent(*compacted, *plain);
+
+  compacted->setFact(2000000);
+  plain->setFact(2000000);
+  compacted->clearFact(150000);
+  plain->clearFact(150000);
+  checkSameContent(*compacted, *plain);
+  BOOST_CHECK(compacted->getFact(2000000));
+  BOOST_CHECK(!compacted->getFact(150000));
+
+  // the compacted join can be compacted again after modifications
+  compactInterpretation(*compacted);
+  checkSameContent(*compacted, *plain);
+}
+
+// Local Variables:
+// mode: C++
+// End:
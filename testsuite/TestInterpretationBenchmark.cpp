@@ -0,0 +1,180 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestInterpretationBenchmark.cpp
+ *
+ * @brief  Microbenchmarks for the bitset operations used by Interpretation.
+ *
+ * Measures adding bits, bit_and, enumeration and counting
+ * on dense bitsets (like predicate masks) and sparse bitsets (like models)
+ * with plain bit blocks (bm::BM_BIT) and run-length encoded blocks (bm::BM_GAP).
+ * Results are logged as warnings; the checks only verify that both strategies agree.
+ * Build with --enable-bm-simd to compare the SIMD versions of bitmagic.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/Logger.h"
+
+// Interpretation::Storage
+#include <bm/bm.h>
+
+#define BOOST_TEST_MODULE "TestInterpretationBenchmark"
+#include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <vector>
+#include <cstdlib>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+typedef bm::bvector<> Storage;
+
+namespace
+{
+  // realistic number of ground atoms of a larger instance
+  const unsigned atoms = 2000000;
+  const unsigned repetitions = 20;
+
+  // a mask contains all atoms of some predicates, which are mostly stored in long runs
+  std::vector<unsigned> denseAddresses()
+  {
+    std::vector<unsigned> ret;
+    for(unsigned a = 0; a < atoms; ++a)
+      if( (a / 50000) % 3 != 2 )
+        ret.push_back(a);
+    return ret;
+  }
+
+  // a model contains few atoms scattered over the whole table
+  std::vector<unsigned> sparseAddresses()
+  {
+    std::vector<unsigned> ret;
+    srand(42);
+    for(unsigned a = 0; a < atoms; ++a)
+      if( rand() % 100 == 0 )
+        ret.push_back(a);
+    return ret;
+  }
+
+  class Timer
+  {
+  public:
+    Timer(const std::string& what): what(what), start(boost::posix_time::microsec_clock::universal_time()) {}
+    ~Timer()
+    {
+      boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+      LOG(WARNING, what << ": " << d.total_microseconds() / 1000.0 << "ms");
+    }
+  private:
+    std::string what;
+    boost::posix_time::ptime start;
+  };
+
+  void fill(Storage& bits, const std::vector<unsigned>& addresses)
+  {
+    for(std::vector<unsigned>::const_iterator it = addresses.begin(); it != addresses.end(); ++it)
+      bits.set_bit(*it);
+  }
+
+  // runs all benchmarks on bitsets with the given strategy and returns a checksum
+  unsigned long benchmark(const std::string& name, bm::strategy strategy,
+      const std::vector<unsigned>& addresses, const Storage& other)
+  {
+    unsigned long checksum = 0;
+
+    Storage bits(strategy);
+    {
+      Timer t(name + " add");
+      for(unsigned r = 0; r < repetitions; ++r)
+      {
+        bits.clear(true);
+        fill(bits, addresses);
+      }
+    }
+    bm::bvector<>::statistics st;
+    bits.calc_stat(&st);
+    LOG(WARNING, name << " memory: " << st.memory_used / 1024 << "kB");
+
+    {
+      Timer t(name + " count");
+      for(unsigned r = 0; r < repetitions; ++r)
+        checksum += bits.count();
+    }
+
+    {
+      Timer t(name + " enumerate");
+      for(unsigned r = 0; r < repetitions; ++r)
+      {
+        Storage::enumerator en = bits.first();
+        Storage::enumerator en_end = bits.end();
+        while( en < en_end )
+        {
+          checksum += *en;
+          ++en;
+        }
+      }
+    }
+
+    {
+      Timer t(name + " bit_and");
+      for(unsigned r = 0; r < repetitions; ++r)
+      {
+        Storage copy(bits);
+        copy &= other;
+        checksum += copy.count();
+      }
+    }
+
+    return checksum;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testDenseBitsets)
+{
+  std::vector<unsigned> dense = denseAddresses();
+  Storage other;
+  fill(other, sparseAddresses());
+
+  unsigned long bit = benchmark("dense BM_BIT", bm::BM_BIT, dense, other);
+  unsigned long gap = benchmark("dense BM_GAP", bm::BM_GAP, dense, other);
+  BOOST_CHECK_EQUAL(bit, gap);
+}
+
+BOOST_AUTO_TEST_CASE(testSparseBitsets)
+{
+  std::vector<unsigned> sparse = sparseAddresses();
+  Storage other;
+  fill(other, denseAddresses());
+
+  unsigned long bit = benchmark("sparse BM_BIT", bm::BM_BIT, sparse, other);
+  unsigned long gap = benchmark("sparse BM_GAP", bm::BM_GAP, sparse, other);
+  BOOST_CHECK_EQUAL(bit, gap);
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -80,4 +80,26 @@ BOOST_FIXTURE_TEST_CASE(setup_model_graph_m2, ModelGraphE2M2Fixture)
   BOOST_CHECK(mg.propsOf(m10).type == MT_OUT);
 }
 
+BOOST_FIXTURE_TEST_CASE(remove_model_m2, ModelGraphE2M2Fixture)
+{
+  std::vector<Model> depm;
+  depm.push_back(m5); depm.push_back(m11);
+  BOOST_REQUIRE(!!mg.getSuccessorIntersection(u4, depm));
+  BOOST_CHECK(mg.getSuccessorIntersection(u4, depm).get() == m13);
+
+  unsigned models = mg.countModels();
+  mg.removeModel(m13);
+  BOOST_CHECK(mg.countModels() == models - 1);
+  BOOST_REQUIRE(mg.modelsAt(u4, MT_IN).size() == 1);
+  BOOST_CHECK(mg.modelsAt(u4, MT_IN).front() == m12);
+  BOOST_CHECK(!mg.getSuccessorIntersection(u4, depm));
+
+  depm.clear(); depm.push_back(m5); depm.push_back(m10);
+  BOOST_REQUIRE(!!mg.getSuccessorIntersection(u4, depm));
+  BOOST_CHECK(mg.getSuccessorIntersection(u4, depm).get() == m12);
+
+  // m11 has no successors anymore
+  BOOST_CHECK(mg.getSuccessors(m11).first == mg.getSuccessors(m11).second);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
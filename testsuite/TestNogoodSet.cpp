@@ -0,0 +1,283 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestNogoodSet.cpp
+ *
+ * @brief  Test adding, removing, forgetting and defragmenting nogoods in a NogoodSet.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/Nogood.h"
+#include "dlvhex2/Logger.h"
+
+#define BOOST_TEST_MODULE "TestNogoodSet"
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include <map>
+#include <set>
+#include <vector>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // nogood k has k % 13 + 1 literals, such that small and large (heap-allocated) nogoods occur
+  Nogood makeNogood(unsigned k)
+  {
+    Nogood ng;
+    for(unsigned i = 0; i <= k % 13; ++i)
+      ng.insert(NogoodContainer::createLiteral(k * 17 + i, (k + i) % 3 != 0));
+    ng.recomputeHash();
+    return ng;
+  }
+
+  std::vector<ID> key(const Nogood& ng)
+  {
+    return std::vector<ID>(ng.begin(), ng.end());
+  }
+
+  // expected content: how often each contained nogood was added
+  typedef std::map<std::vector<ID>, int> Model;
+
+  // simple deterministic pseudo random numbers
+  struct Random
+  {
+    unsigned state;
+    Random(): state(12345) {}
+    unsigned next(unsigned max)
+    {
+      state = state * 1103515245 + 12345;
+      return (state >> 16) % max;
+    }
+  };
+
+  // checks the count and finds every expected nogood by its hash (in a copy, as adding changes add counts)
+  void checkContent(const NogoodSet& ngs, const Model& model, unsigned poolSize)
+  {
+    BOOST_REQUIRE_EQUAL(ngs.getNogoodCount(), (int)model.size());
+
+    NogoodSet copy;
+    copy = ngs;
+    for(unsigned k = 0; k < poolSize; ++k)
+    {
+      Nogood ng = makeNogood(k);
+      int index = copy.addNogood(ng);
+      if( model.count(key(ng)) == 1 )
+      {
+        BOOST_REQUIRE(copy.getNogood(index) == ng);
+        BOOST_REQUIRE(ngs.getNogood(index) == ng);
+        BOOST_REQUIRE_EQUAL(copy.getNogoodCount(), (int)model.size());
+      }
+      else
+      {
+        BOOST_REQUIRE(copy.getNogood(index) == ng);
+        copy.removeNogood(index);
+        BOOST_REQUIRE_EQUAL(copy.getNogoodCount(), (int)model.size());
+      }
+    }
+  }
+
+  // forgetting must remove exactly the nogoods added less than 5% as often as the most frequent one
+  void checkForget(const NogoodSet& ngs, const Model& model, unsigned poolSize)
+  {
+    int maxCount = 0;
+    BOOST_FOREACH(const Model::value_type& m, model)
+      maxCount = std::max(maxCount, m.second);
+    Model kept;
+    BOOST_FOREACH(const Model::value_type& m, model)
+    {
+      if( !(m.second < maxCount * 0.05) )
+        kept.insert(m);
+    }
+
+    NogoodSet copy;
+    copy = ngs;
+    copy.forgetLeastFrequentlyAdded();
+    checkContent(copy, kept, poolSize);
+  }
+
+  // after defragmentation the nogoods occupy exactly the indices 0 to getNogoodCount()-1
+  void checkDefragmented(const NogoodSet& ngs, const Model& model)
+  {
+    std::set<std::vector<ID> > seen;
+    for(int i = 0; i < ngs.getNogoodCount(); ++i)
+    {
+      BOOST_REQUIRE(model.count(key(ngs.getNogood(i))) == 1);
+      BOOST_REQUIRE(seen.insert(key(ngs.getNogood(i))).second);
+    }
+    BOOST_REQUIRE_EQUAL(seen.size(), model.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testAddAndRemove)
+{
+  NogoodSet ngs;
+  Model model;
+
+  Nogood ng0 = makeNogood(0);
+  Nogood ng20 = makeNogood(20);
+  int i0 = ngs.addNogood(ng0);
+  int i20 = ngs.addNogood(ng20);
+  BOOST_CHECK(i0 != i20);
+  BOOST_CHECK_EQUAL(ngs.getNogoodCount(), 2);
+
+  // adding again finds the stored nogood (also from an unhashed copy)
+  Nogood ng0copy;
+  BOOST_FOREACH(ID lit, ng0)
+    ng0copy.insert(lit);
+  BOOST_CHECK_EQUAL(ngs.addNogood(ng0copy), i0);
+  BOOST_CHECK_EQUAL(ngs.getNogoodCount(), 2);
+
+  // removing by nogood and by index, removing a nogood which is not contained
+  ngs.removeNogood(makeNogood(5));
+  BOOST_CHECK_EQUAL(ngs.getNogoodCount(), 2);
+  ngs.removeNogood(ng0);
+  BOOST_CHECK_EQUAL(ngs.getNogoodCount(), 1);
+  ngs.removeNogood(i20);
+  BOOST_CHECK_EQUAL(ngs.getNogoodCount(), 0);
+  checkContent(ngs, model, 30);
+
+  // free indices are reused
+  int i5 = ngs.addNogood(makeNogood(5));
+  BOOST_CHECK(i5 == i0 || i5 == i20);
+  model[key(makeNogood(5))] = 1;
+  checkContent(ngs, model, 30);
+}
+
+BOOST_AUTO_TEST_CASE(testRandomOperations)
+{
+  const unsigned poolSize = 60;
+  NogoodSet ngs;
+  Model model;
+  Random rnd;
+
+  for(unsigned step = 0; step < 3000; ++step)
+  {
+    unsigned op = rnd.next(100);
+    if( op < 70 )
+    {
+      // add, preferring nogoods with small numbers such that add counts differ a lot
+      unsigned k = rnd.next(1 + rnd.next(poolSize));
+      Nogood ng = makeNogood(k);
+      int index = ngs.addNogood(ng);
+      BOOST_REQUIRE(ngs.getNogood(index) == ng);
+      model[key(ng)]++;
+    }
+    else if( op < 85 )
+    {
+      // remove by nogood (possibly not contained)
+      Nogood ng = makeNogood(rnd.next(poolSize));
+      ngs.removeNogood(ng);
+      model.erase(key(ng));
+    }
+    else if( op < 95 )
+    {
+      // remove by index of a contained nogood
+      if( model.empty() )
+        continue;
+      Model::iterator it = model.begin();
+      std::advance(it, rnd.next(model.size()));
+      Nogood ng;
+      BOOST_FOREACH(ID lit, it->first)
+        ng.insert(lit);
+      int index = ngs.addNogood(ng);
+      ngs.removeNogood(index);
+      model.erase(it);
+    }
+    else if( op < 98 )
+    {
+      ngs.defragment();
+      checkDefragmented(ngs, model);
+    }
+    else
+    {
+      checkForget(ngs, model, poolSize);
+    }
+
+    if( step % 50 == 0 )
+      checkContent(ngs, model, poolSize);
+  }
+
+  checkContent(ngs, model, poolSize);
+  checkForget(ngs, model, poolSize);
+  ngs.defragment();
+  checkDefragmented(ngs, model);
+  checkContent(ngs, model, poolSize);
+  checkForget(ngs, model, poolSize);
+}
+
+BOOST_AUTO_TEST_CASE(testForgetAndDefragment)
+{
+  NogoodSet ngs;
+  Model model;
+
+  // nogood 0 is added 100 times, nogoods 1-9 between 1 and 9 times
+  for(unsigned i = 0; i < 100; ++i)
+    ngs.addNogood(makeNogood(0));
+  model[key(makeNogood(0))] = 100;
+  for(unsigned k = 1; k < 10; ++k)
+  {
+    for(unsigned i = 0; i < k; ++i)
+      ngs.addNogood(makeNogood(k));
+    model[key(makeNogood(k))] = k;
+  }
+  checkContent(ngs, model, 20);
+
+  // the nogoods added less than 5 times are forgotten
+  ngs.forgetLeastFrequentlyAdded();
+  for(unsigned k = 1; k < 5; ++k)
+    model.erase(key(makeNogood(k)));
+  checkContent(ngs, model, 20);
+
+  // defragmenting moves the remaining nogoods to the front and keeps their add counts
+  ngs.defragment();
+  checkDefragmented(ngs, model);
+  checkContent(ngs, model, 20);
+  for(unsigned i = 0; i < 100; ++i)
+    ngs.addNogood(makeNogood(0));
+  model[key(makeNogood(0))] = 200;
+  checkForget(ngs, model, 20);
+  ngs.forgetLeastFrequentlyAdded();
+  for(unsigned k = 5; k < 10; ++k)
+    model.erase(key(makeNogood(k)));
+  checkContent(ngs, model, 20);
+
+  // new nogoods are appended after defragmentation
+  ngs.defragment();
+  int index = ngs.addNogood(makeNogood(15));
+  BOOST_CHECK_EQUAL(index, 1);
+  model[key(makeNogood(15))] = 1;
+  checkDefragmented(ngs, model);
+  checkContent(ngs, model, 20);
+}
+
+// Local Variables:
+// mode: C++
+// End:
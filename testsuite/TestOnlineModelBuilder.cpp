@@ -54,6 +54,8 @@
 #include "dlvhex2/ModelGraph.h"
 #include "dlvhex2/ModelGenerator.h"
 #include "dlvhex2/OnlineModelBuilder.h"
+#include "dlvhex2/ParallelModelBuilder.h"
+#include "dlvhex2/Error.h"
 
 #include "fixtureOnlineMB.h"
 
@@ -483,4 +485,148 @@ BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input, OnlineModelBuild
   DO_MODEL_GENERATION_TWICE_CHECK_GENERATORCOUNT_END
 }
 
+// in constant space mode, consumed models at ufinal are removed from the model graph
+// without losing any model
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_constspace, OnlineModelBuilderEx1Fixture)
+{
+  cfg.constantSpace = true;
+  ModelBuilder csomb(cfg);
+
+  unsigned count = 0;
+  OptionalModel m;
+  while( !!(m = omb.getNextIModel(ufinal)) )
+    count++;
+  BOOST_REQUIRE(count > 1);
+
+  unsigned cscount = 0;
+  while( !!(m = csomb.getNextIModel(ufinal)) )
+  {
+    cscount++;
+    BOOST_CHECK(!!csomb.getModelGraph().propsOf(m.get()).interpretation);
+    BOOST_CHECK_EQUAL(csomb.getModelGraph().modelsAt(ufinal, dlvhex::MT_IN).size(), 1U);
+  }
+  BOOST_CHECK_EQUAL(count, cscount);
+  BOOST_CHECK(csomb.getModelGraph().countModels() < omb.getModelGraph().countModels());
+}
+
+// online model builder that starts model generators of predecessors before joining
+class EarlyStartingModelBuilder:
+  public OnlineModelBuilderEx1Fixture::ModelBuilder
+{
+public:
+  EarlyStartingModelBuilder(dlvhex::ModelBuilderConfig<TestEvalGraph>& cfg):
+    OnlineModelBuilderEx1Fixture::ModelBuilder(cfg)
+    { startGeneratorsEarly = true; }
+};
+
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_start_early, OnlineModelBuilderEx1Fixture)
+{
+  EarlyStartingModelBuilder esomb(cfg);
+
+  std::vector<TestAtomSet> models, esmodels;
+  OptionalModel m;
+  while( !!(m = omb.getNextIModel(ufinal)) )
+    models.push_back(omb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+  while( !!(m = esomb.getNextIModel(ufinal)) )
+    esmodels.push_back(esomb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+
+  BOOST_REQUIRE(models.size() > 1);
+  BOOST_CHECK(models == esmodels);
+}
+
+// model generator factory whose model generators fail instead of returning a model
+class FailingModelGeneratorFactory:
+  public dlvhex::ModelGeneratorFactoryBase<TestInterpretation>
+{
+public:
+  class ModelGenerator:
+    public dlvhex::ModelGeneratorBase<TestInterpretation>
+  {
+  public:
+    ModelGenerator(InterpretationConstPtr input):
+      dlvhex::ModelGeneratorBase<TestInterpretation>(input) {}
+
+    virtual InterpretationPtr generateNextModel()
+      { throw dlvhex::PluginError("failing model generator"); }
+  };
+
+  virtual ModelGeneratorPtr createModelGenerator(InterpretationConstPtr input)
+    { return ModelGeneratorPtr(new ModelGenerator(input)); }
+};
+
+// computing models ahead on a thread pool does not change the models or their order
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_parallel, OnlineModelBuilderEx1Fixture)
+{
+  cfg.parallelThreads = 3;
+  cfg.modelBufferSize = 2;
+  dlvhex::ParallelModelBuilder<TestEvalGraph> pmb(cfg);
+
+  std::vector<TestAtomSet> models, pmodels;
+  OptionalModel m;
+  while( !!(m = omb.getNextIModel(ufinal)) )
+    models.push_back(omb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+  while( !!(m = pmb.getNextIModel(ufinal)) )
+    pmodels.push_back(pmb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+
+  BOOST_REQUIRE(models.size() > 1);
+  BOOST_CHECK(models == pmodels);
+}
+
+// destroying the builder after the first model stops workers which compute models ahead
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_parallel_abort, OnlineModelBuilderEx1Fixture)
+{
+  cfg.parallelThreads = 3;
+  cfg.modelBufferSize = 4;
+  for(unsigned i = 0; i < 10; ++i)
+  {
+    dlvhex::ParallelModelBuilder<TestEvalGraph> pmb(cfg);
+    BOOST_REQUIRE(!!pmb.getNextIModel(ufinal));
+  }
+}
+
+// an exception of a model generator on a worker is rethrown with its type in the calling thread
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_parallel_error, OnlineModelBuilderEx1Fixture)
+{
+  eg.propsOf(u1).mgf.reset(new FailingModelGeneratorFactory);
+  cfg.parallelThreads = 2;
+  dlvhex::ParallelModelBuilder<TestEvalGraph> pmb(cfg);
+  BOOST_CHECK_THROW(pmb.getNextIModel(ufinal), dlvhex::PluginError);
+}
+
+// streaming models through bounded queues does not change the models or their order
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_pipelined, OnlineModelBuilderEx1Fixture)
+{
+  cfg.modelQueueSize = 1;
+  dlvhex::PipelinedModelBuilder<TestEvalGraph> pmb(cfg);
+
+  std::vector<TestAtomSet> models, pmodels;
+  OptionalModel m;
+  while( !!(m = omb.getNextIModel(ufinal)) )
+    models.push_back(omb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+  while( !!(m = pmb.getNextIModel(ufinal)) )
+    pmodels.push_back(pmb.getModelGraph().propsOf(m.get()).interpretation->getAtoms());
+
+  BOOST_REQUIRE(models.size() > 1);
+  BOOST_CHECK(models == pmodels);
+}
+
+// destroying the builder after the first model stops producers blocked on full queues
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_pipelined_abort, OnlineModelBuilderEx1Fixture)
+{
+  cfg.modelQueueSize = 1;
+  for(unsigned i = 0; i < 10; ++i)
+  {
+    dlvhex::PipelinedModelBuilder<TestEvalGraph> pmb(cfg);
+    BOOST_REQUIRE(!!pmb.getNextIModel(ufinal));
+  }
+}
+
+// an exception of a model generator in a producer thread is rethrown with its type in the calling thread
+BOOST_FIXTURE_TEST_CASE(online_model_building_ex1_ufinal_input_pipelined_error, OnlineModelBuilderEx1Fixture)
+{
+  eg.propsOf(u1).mgf.reset(new FailingModelGeneratorFactory);
+  dlvhex::PipelinedModelBuilder<TestEvalGraph> pmb(cfg);
+  BOOST_CHECK_THROW(pmb.getNextIModel(ufinal), dlvhex::PluginError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
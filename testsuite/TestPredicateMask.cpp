@@ -0,0 +1,192 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestPredicateMask.cpp
+ *
+ * @brief  Test incremental updates of predicate masks from the per-predicate index of ground atoms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/PredicateMask.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/Interpretation.h"
+#include "dlvhex2/Logger.h"
+
+#define BOOST_TEST_MODULE "TestPredicateMask"
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+
+#include <set>
+#include <sstream>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // stores pred(c0), ..., pred(c<n-1>), starting at constant index from
+  void storeAtoms(RegistryPtr reg, ID pred, unsigned from, unsigned n, bool hidden = false)
+  {
+    for(unsigned i = from; i < from + n; ++i)
+    {
+      std::stringstream ss;
+      ss << "c" << i;
+      OrdinaryAtom oatom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG |
+          (hidden ? ID::PROPERTY_ATOM_HIDDEN : 0));
+      oatom.tuple.push_back(pred);
+      oatom.tuple.push_back(reg->storeConstantTerm(ss.str()));
+      reg->storeOrdinaryGAtom(oatom);
+    }
+  }
+
+  // what the mask must contain: all non-hidden ground atoms over the predicates,
+  // found by inspecting every ground atom (as PredicateMask did before it used the index)
+  Interpretation fullScan(RegistryPtr reg, const std::set<ID>& preds)
+  {
+    Interpretation ret(reg);
+    OrdinaryAtomTable::AddressIterator it, it_end;
+    boost::tie(it, it_end) = reg->ogatoms.getAllByAddress();
+    for(IDAddress addr = 0; it != it_end; ++it, ++addr)
+    {
+      if( (it->kind & ID::PROPERTY_ATOM_HIDDEN) == 0 && preds.count(it->tuple.front()) == 1 )
+        ret.setFact(addr);
+    }
+    return ret;
+  }
+
+  void checkMask(PredicateMask& mask, RegistryPtr reg, const std::set<ID>& preds)
+  {
+    mask.updateMask();
+    BOOST_CHECK(*mask.mask() == fullScan(reg, preds));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testPredicatesBeforeAtoms)
+{
+  RegistryPtr reg(new Registry);
+  ID p = reg->storeConstantTerm("p");
+  ID q = reg->storeConstantTerm("q");
+  ID r = reg->storeConstantTerm("r");
+
+  PredicateMask mask;
+  mask.setRegistry(reg);
+  std::set<ID> preds;
+  mask.addPredicate(p);
+  preds.insert(p);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 0);
+
+  storeAtoms(reg, p, 0, 10);
+  storeAtoms(reg, r, 0, 10);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 10);
+
+  // atoms interleaved with updates, including hidden ones which are never in the mask
+  mask.addPredicate(q);
+  preds.insert(q);
+  for(unsigned i = 0; i < 5; ++i)
+  {
+    storeAtoms(reg, q, 3 * i, 3);
+    storeAtoms(reg, p, 10 + 2 * i, 2, true);
+    storeAtoms(reg, r, 10 + i, 1);
+    checkMask(mask, reg, preds);
+  }
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 25);
+
+  // no new atoms
+  checkMask(mask, reg, preds);
+}
+
+BOOST_AUTO_TEST_CASE(testAtomsBeforePredicates)
+{
+  RegistryPtr reg(new Registry);
+  ID p = reg->storeConstantTerm("p");
+  ID q = reg->storeConstantTerm("q");
+  ID r = reg->storeConstantTerm("r");
+
+  storeAtoms(reg, p, 0, 10);
+  storeAtoms(reg, q, 0, 7);
+  storeAtoms(reg, q, 7, 3, true);
+  storeAtoms(reg, r, 0, 5);
+
+  PredicateMask mask;
+  mask.setRegistry(reg);
+  std::set<ID> preds;
+  checkMask(mask, reg, preds);
+
+  mask.addPredicate(q);
+  preds.insert(q);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 7);
+
+  // adding a predicate after an update picks up all of its atoms, also without new atoms
+  mask.addPredicate(p);
+  preds.insert(p);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 17);
+
+  // adding a predicate twice does not lose atoms seen before
+  storeAtoms(reg, p, 10, 4);
+  mask.addPredicate(p);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 21);
+
+  // nonground atoms are not indexed and never in the mask
+  OrdinaryAtom onatom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYN);
+  onatom.tuple.push_back(p);
+  onatom.tuple.push_back(reg->storeVariableTerm("X"));
+  reg->storeOrdinaryNAtom(onatom);
+  storeAtoms(reg, r, 5, 5);
+  mask.addPredicate(r);
+  preds.insert(r);
+  checkMask(mask, reg, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 31);
+}
+
+BOOST_AUTO_TEST_CASE(testCopiedRegistry)
+{
+  RegistryPtr reg(new Registry);
+  ID p = reg->storeConstantTerm("p");
+  storeAtoms(reg, p, 0, 10);
+
+  // the copy of the registry keeps the index of the ground atoms
+  RegistryPtr copy(new Registry(*reg));
+  storeAtoms(copy, p, 10, 5);
+
+  PredicateMask mask;
+  mask.setRegistry(copy);
+  mask.addPredicate(p);
+  std::set<ID> preds;
+  preds.insert(p);
+  checkMask(mask, copy, preds);
+  BOOST_CHECK_EQUAL(mask.mask()->getStorage().count(), 15);
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -0,0 +1,362 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestPreparedSubprogram.cpp
+ *
+ * @brief  Test evaluating prepared subprograms under different sets of facts.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/PreparedSubprogram.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/PluginContainer.h"
+#include "dlvhex2/PluginInterface.h"
+#include "dlvhex2/DependencyGraph.h"
+#include "dlvhex2/HexParser.h"
+#include "dlvhex2/InputProvider.h"
+#include "dlvhex2/Printer.h"
+#include "dlvhex2/State.h"
+#include "dlvhex2/EvalHeuristicGreedy.h"
+#include "dlvhex2/OnlineModelBuilder.h"
+#include "dlvhex2/ExternalAtomEvaluationHeuristicsInterface.h"
+#include "dlvhex2/ExternalAtomEvaluationHeuristics.h"
+#include "dlvhex2/UnfoundedSetCheckHeuristics.h"
+
+#define BOOST_TEST_MODULE "TestPreparedSubprogram"
+#include <boost/test/unit_test.hpp>
+#include <boost/foreach.hpp>
+#include <boost/functional/factory.hpp>
+
+#include <set>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // &copy[p](X) is true for all X such that p(X) is true; counts its evaluations
+  // which are not answered from the query cache of the plugin atom
+  class CopyPluginAtom:
+    public PluginAtom
+  {
+  public:
+    static unsigned calls;
+
+    CopyPluginAtom():
+      PluginAtom("copy", true)
+    {
+      addInputPredicate();
+      setOutputArity(1);
+    }
+
+    virtual void retrieve(const Query& query, Answer& answer)
+    {
+      calls++;
+      bm::bvector<>::enumerator en = query.interpretation->getStorage().first();
+      bm::bvector<>::enumerator en_end = query.interpretation->getStorage().end();
+      for(; en < en_end; ++en)
+      {
+        const OrdinaryAtom& oatom = registry->ogatoms.getByAddress(*en);
+        if( oatom.tuple[0] != query.input[0] )
+          continue;
+        Tuple t;
+        t.push_back(oatom.tuple[1]);
+        answer.get().push_back(t);
+      }
+    }
+  };
+  unsigned CopyPluginAtom::calls = 0;
+
+  // optimizer which depends on the facts: rules with a positive body atom
+  // whose predicate neither has facts nor occurs in a rule head can never fire,
+  // so they are disabled by adding an underivable atom to their body
+  class PruningOptimizer:
+    public PluginOptimizer
+  {
+  public:
+    RegistryPtr reg;
+
+    PruningOptimizer(RegistryPtr reg): reg(reg) {}
+
+    virtual void optimize(InterpretationPtr edb, DependencyGraphPtr depgraph)
+    {
+      std::set<ID> derivable;
+      bm::bvector<>::enumerator en = edb->getStorage().first();
+      bm::bvector<>::enumerator en_end = edb->getStorage().end();
+      for(; en < en_end; ++en)
+        derivable.insert(reg->ogatoms.getByAddress(*en).tuple[0]);
+      DependencyGraph::NodeIterator it, it_end;
+      for(boost::tie(it, it_end) = depgraph->getNodes(); it != it_end; ++it)
+      {
+        ID id = depgraph->getNodeInfo(*it).id;
+        if( !id.isRule() )
+          continue;
+        BOOST_FOREACH(ID h, reg->rules.getByID(id).head)
+          derivable.insert(reg->lookupOrdinaryAtom(h).tuple[0]);
+      }
+
+      OrdinaryAtom pruned(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG);
+      pruned.tuple.push_back(reg->storeConstantTerm("pruned"));
+      ID prunedID = reg->storeOrdinaryAtom(pruned);
+      for(boost::tie(it, it_end) = depgraph->getNodes(); it != it_end; ++it)
+      {
+        DependencyGraph::NodeInfo& ni = depgraph->propsOf(*it);
+        if( !ni.id.isRule() )
+          continue;
+        Rule r = reg->rules.getByID(ni.id);
+        bool fires = true;
+        BOOST_FOREACH(ID b, r.body)
+        {
+          if( !b.isNaf() && b.isOrdinaryAtom() &&
+              derivable.count(reg->lookupOrdinaryAtom(b).tuple[0]) == 0 )
+            fires = false;
+        }
+        if( !fires )
+        {
+          r.body.push_back(ID::posLiteralFromAtom(prunedID));
+          ni.id = reg->storeRule(r);
+        }
+      }
+    }
+  };
+
+  class PruningPlugin:
+    public PluginInterface
+  {
+  public:
+    PruningPlugin() { setNameVersion("PruningPlugin", 0, 0, 1); }
+
+    virtual PluginOptimizerPtr createOptimizer(ProgramCtx& ctx)
+      { return PluginOptimizerPtr(new PruningOptimizer(ctx.registry())); }
+  };
+
+  void setupCtx(ProgramCtx& ctx)
+  {
+    ctx.setupRegistry(RegistryPtr(new Registry));
+    ctx.setupPluginContainer(PluginContainerPtr(new PluginContainer));
+    ctx.evalHeuristic.reset(new EvalHeuristicGreedy);
+    ctx.modelBuilderFactory = boost::factory<OnlineModelBuilder<FinalEvalGraph>*>();
+    ctx.defaultExternalAtomEvaluationHeuristicsFactory.reset(new ExternalAtomEvaluationHeuristicsNeverFactory());
+    ctx.unfoundedSetCheckHeuristicsFactory.reset(new UnfoundedSetCheckHeuristicsPostFactory());
+    // internal grounder and solver
+    ctx.config.setOption("GenuineSolver", 1);
+    ctx.addPluginAtom(PluginAtomPtr(new CopyPluginAtom));
+  }
+
+  // parses a program and returns its rules (facts are added to the registry)
+  std::vector<ID> parseRules(ProgramCtx& ctx, const std::string& program)
+  {
+    ProgramCtx pc(ctx);
+    pc.idb.clear();
+    pc.edb.reset(new Interpretation(ctx.registry()));
+    std::stringstream ss(program);
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "testinput");
+    ModuleHexParser parser;
+    parser.parse(ip, pc);
+    return pc.idb;
+  }
+
+  InterpretationPtr facts(ProgramCtx& ctx, const std::string& atoms)
+  {
+    ProgramCtx pc(ctx);
+    pc.idb.clear();
+    pc.edb.reset(new Interpretation(ctx.registry()));
+    std::stringstream ss(atoms);
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "testfacts");
+    ModuleHexParser parser;
+    parser.parse(ip, pc);
+    return pc.edb;
+  }
+
+  // non-auxiliary atoms of each answer set
+  std::set<std::set<std::string> > answerSets(RegistryPtr reg, const std::vector<InterpretationPtr>& answersets)
+  {
+    std::set<std::set<std::string> > ret;
+    BOOST_FOREACH(InterpretationPtr as, answersets)
+    {
+      std::set<std::string> atoms;
+      bm::bvector<>::enumerator en = as->getStorage().first();
+      bm::bvector<>::enumerator en_end = as->getStorage().end();
+      for(; en < en_end; ++en)
+      {
+        ID id = reg->ogatoms.getIDByAddress(*en);
+        if( !id.isAuxiliary() )
+          atoms.insert(printToString<RawPrinter>(id, reg));
+      }
+      ret.insert(atoms);
+    }
+    return ret;
+  }
+
+  std::set<std::set<std::string> > expected(const std::string& atoms)
+  {
+    std::set<std::string> as;
+    std::stringstream ss(atoms);
+    std::string atom;
+    while( ss >> atom )
+      as.insert(atom);
+    std::set<std::set<std::string> > ret;
+    ret.insert(as);
+    return ret;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testEvaluateUnderTwoEDBs)
+{
+  ProgramCtx ctx;
+  setupCtx(ctx);
+  RegistryPtr reg = ctx.registry();
+
+  std::vector<ID> idb = parseRules(ctx, "q(X) :- p(X), not r(X). r(X) :- s(X).");
+  InterpretationPtr edb1 = facts(ctx, "p(a). p(b). s(b).");
+  InterpretationPtr edb2 = facts(ctx, "p(b).");
+
+  PreparedSubprogram prepared(ctx, idb);
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb1)) == expected("p(a) p(b) s(b) q(a) r(b)"));
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb2)) == expected("p(b) q(b)"));
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(InterpretationPtr(new Interpretation(reg)))) == expected(""));
+
+  // same answers as analysing the rules for each set of facts
+  std::vector<ID> idbcopy(idb);
+  BOOST_CHECK(answerSets(reg, ctx.evaluateSubprogram(edb1, idbcopy)) == expected("p(a) p(b) s(b) q(a) r(b)"));
+  BOOST_CHECK(answerSets(reg, ctx.evaluateSubprogram(edb2, idbcopy)) == expected("p(b) q(b)"));
+}
+
+BOOST_AUTO_TEST_CASE(testMemoizedResults)
+{
+  ProgramCtx ctx;
+  setupCtx(ctx);
+  RegistryPtr reg = ctx.registry();
+
+  std::vector<ID> idb = parseRules(ctx, "q(X) :- &copy[p](X).");
+  InterpretationPtr edb1 = facts(ctx, "p(a). p(b).");
+  InterpretationPtr edb2 = facts(ctx, "p(c).");
+
+  PluginAtomPtr copy = ctx.pluginAtomMap().find("copy")->second;
+
+  PreparedSubprogram prepared(ctx, idb);
+  CopyPluginAtom::calls = 0;
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb1)) == expected("p(a) p(b) q(a) q(b)"));
+  unsigned calls = CopyPluginAtom::calls;
+  BOOST_REQUIRE(calls > 0);
+
+  // the same facts (in another interpretation object) are answered from the memo,
+  // not from the query cache of the external atom
+  copy->resetCache();
+  InterpretationPtr edb1again(new Interpretation(*edb1));
+  std::vector<InterpretationPtr> memoized = prepared.evaluate(edb1again);
+  BOOST_CHECK(answerSets(reg, memoized) == expected("p(a) p(b) q(a) q(b)"));
+  BOOST_CHECK_EQUAL(CopyPluginAtom::calls, calls);
+
+  // callers may modify the result without changing the memo
+  BOOST_REQUIRE_EQUAL(memoized.size(), 1);
+  memoized.front()->clearFact(edb1->getStorage().get_first());
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb1)) == expected("p(a) p(b) q(a) q(b)"));
+
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb2)) == expected("p(c) q(c)"));
+  BOOST_CHECK(CopyPluginAtom::calls > calls);
+
+  // without memo the external atom is evaluated again
+  PreparedSubprogram unmemoized(ctx, idb, 0);
+  unmemoized.evaluate(edb1);
+  copy->resetCache();
+  calls = CopyPluginAtom::calls;
+  BOOST_CHECK(answerSets(reg, unmemoized.evaluate(edb1)) == expected("p(a) p(b) q(a) q(b)"));
+  BOOST_CHECK(CopyPluginAtom::calls > calls);
+}
+
+BOOST_AUTO_TEST_CASE(testFullMemoDropsOldestResult)
+{
+  ProgramCtx ctx;
+  setupCtx(ctx);
+  RegistryPtr reg = ctx.registry();
+
+  std::vector<ID> idb = parseRules(ctx, "q(X) :- &copy[p](X).");
+  InterpretationPtr edb1 = facts(ctx, "p(a).");
+  InterpretationPtr edb2 = facts(ctx, "p(b).");
+  InterpretationPtr edb3 = facts(ctx, "p(c).");
+
+  PluginAtomPtr copy = ctx.pluginAtomMap().find("copy")->second;
+
+  // memo for two results: the third result replaces the first one only
+  PreparedSubprogram prepared(ctx, idb, 2);
+  prepared.evaluate(edb1);
+  prepared.evaluate(edb2);
+  prepared.evaluate(edb3);
+
+  copy->resetCache();
+  unsigned calls = CopyPluginAtom::calls;
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb2)) == expected("p(b) q(b)"));
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb3)) == expected("p(c) q(c)"));
+  BOOST_CHECK_EQUAL(CopyPluginAtom::calls, calls);
+
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb1)) == expected("p(a) q(a)"));
+  BOOST_CHECK(CopyPluginAtom::calls > calls);
+}
+
+BOOST_AUTO_TEST_CASE(testFactsDependentOptimizer)
+{
+  ProgramCtx ctx;
+  setupCtx(ctx);
+  ctx.pluginContainer()->addInternalPlugin(PluginInterfacePtr(new PruningPlugin));
+  RegistryPtr reg = ctx.registry();
+
+  std::vector<ID> idb = parseRules(ctx, "q(X) :- p(X).");
+  InterpretationPtr edb = facts(ctx, "p(a).");
+
+  // optimizing the evaluation graph for the (empty) facts at preparation time loses the rule
+  {
+    ProgramCtx pc(ctx);
+    pc.idb = idb;
+    pc.edb.reset(new Interpretation(reg));
+    pc.prepareSubprogram(pc, false, true);
+    pc.edb->add(*edb);
+    ProgramCtx::SubprogramAnswerSetCallback* spasc = new ProgramCtx::SubprogramAnswerSetCallback();
+    pc.modelCallbacks.clear();
+    pc.modelCallbacks.push_back(ModelCallbackPtr(spasc));
+    pc.changeState(StatePtr(new EvaluateState));
+    pc.evaluate();
+    pc.modelBuilder.reset();
+    BOOST_CHECK(answerSets(reg, spasc->answersets) == expected("p(a)"));
+  }
+
+  // a prepared subprogram does not apply the optimizer
+  PreparedSubprogram prepared(ctx, idb);
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(edb)) == expected("p(a) q(a)"));
+  BOOST_CHECK(answerSets(reg, prepared.evaluate(InterpretationPtr(new Interpretation(reg)))) == expected(""));
+
+  // evaluateSubprogram optimizes for the actual facts
+  BOOST_CHECK(answerSets(reg, ctx.evaluateSubprogram(edb, idb)) == expected("p(a) q(a)"));
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -0,0 +1,334 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestRegistrySnapshot.cpp
+ *
+ * @brief  Test saving snapshots of the registry and the EDB and loading them again.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/RegistrySnapshot.h"
+#include "dlvhex2/Error.h"
+#include "dlvhex2/HexParser.h"
+#include "dlvhex2/InputProvider.h"
+#include "dlvhex2/ProgramCtx.h"
+#include "dlvhex2/Printer.h"
+#include "dlvhex2/Registry.h"
+#include "dlvhex2/Interpretation.h"
+
+#include <bm/bmserial.h>
+
+#define BOOST_TEST_MODULE "TestRegistrySnapshot"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <stdint.h>
+#include <unistd.h>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // temporary file which is removed at the end of the test
+  struct TemporaryFile
+  {
+    std::string name;
+
+    TemporaryFile()
+    {
+      char tmpl[] = "/tmp/TestRegistrySnapshotXXXXXX";
+      int fd = mkstemp(tmpl);
+      BOOST_REQUIRE(fd != -1);
+      close(fd);
+      name = tmpl;
+    }
+
+    ~TemporaryFile()
+      { std::remove(name.c_str()); }
+
+    std::string read() const
+    {
+      std::ifstream in(name.c_str(), std::ios::binary);
+      return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void write(const std::string& content) const
+    {
+      std::ofstream out(name.c_str(), std::ios::binary | std::ios::trunc);
+      out.write(content.data(), content.size());
+    }
+  };
+
+  void parse(ProgramCtx& ctx, const std::string& program)
+  {
+    std::stringstream ss(program);
+    InputProviderPtr ip(new InputProvider);
+    ip->addStreamInput(ss, "testinput");
+    ModuleHexParser parser;
+    parser.parse(ip, ctx);
+  }
+
+  void setupCtx(ProgramCtx& ctx, const std::string& program)
+  {
+    ctx.setupRegistry(RegistryPtr(new Registry));
+    parse(ctx, program);
+  }
+
+  // facts with constants, strings, integers and nested terms (which refer to other terms)
+  const char* facts =
+    "p(a). p(b). q(a,1). r(\"Hello World\").\n"
+    "s(f(a,g(b)),g(b)). s(h(f(a,g(b))),2). t.\n";
+
+  // textual form of the facts which is comparable across registries
+  std::set<std::string> factStrings(ProgramCtx& ctx)
+  {
+    std::set<std::string> ret;
+    bm::bvector<>::enumerator en = ctx.edb->getStorage().first();
+    bm::bvector<>::enumerator en_end = ctx.edb->getStorage().end();
+    for(; en < en_end; ++en)
+      ret.insert(printToString<RawPrinter>(ctx.registry()->ogatoms.getIDByAddress(*en), ctx.registry()));
+    return ret;
+  }
+
+  // checks that the nested term f(a,g(b)) has the arguments of the registry
+  void checkNestedTerm(RegistryPtr reg)
+  {
+    ID f = reg->terms.getIDByString("f(a,g(b))");
+    BOOST_REQUIRE(f != ID_FAIL);
+    const Term& term = reg->terms.getByID(f);
+    BOOST_REQUIRE(term.isNestedTerm());
+    BOOST_REQUIRE_EQUAL(term.arguments.size(), 3);
+    BOOST_CHECK(term.arguments[1] == reg->terms.getIDByString("a"));
+    BOOST_CHECK(term.arguments[2] == reg->terms.getIDByString("g(b)"));
+    const Term& g = reg->terms.getByID(term.arguments[2]);
+    BOOST_REQUIRE_EQUAL(g.arguments.size(), 2);
+    BOOST_CHECK(g.arguments[1] == reg->terms.getIDByString("b"));
+  }
+
+  void appendUInt(std::string& s, uint32_t value)
+  {
+    s.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void appendString(std::string& s, const std::string& str)
+  {
+    appendUInt(s, str.size());
+    s.append(str);
+  }
+
+  // snapshot without symbols whose EDB contains the given atom addresses
+  std::string edbOnlySnapshot(const std::vector<unsigned>& addresses)
+  {
+    bm::bvector<> bits;
+    for(unsigned i = 0; i < addresses.size(); ++i)
+      bits.set_bit(addresses[i]);
+    bits.optimize();
+    bm::bvector<>::statistics st;
+    bits.calc_stat(&st);
+    std::vector<unsigned char> buf(st.max_serialize_mem);
+
+    std::string ret;
+    appendString(ret, "DLVHEXSN");
+    appendUInt(ret, 1);
+    appendUInt(ret, 0);
+    appendUInt(ret, 0);
+    appendUInt(ret, 0);
+    appendString(ret, std::string(reinterpret_cast<const char*>(&buf[0]), bm::serialize(bits, &buf[0])));
+    return ret;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testIdentityMapping)
+{
+  TemporaryFile file;
+  ProgramCtx ctx;
+  setupCtx(ctx, facts);
+  RegistrySnapshot(ctx).save(file.name);
+
+  // an empty registry gets the addresses of the snapshot
+  ProgramCtx loaded;
+  loaded.setupRegistry(RegistryPtr(new Registry));
+  RegistrySnapshot(loaded).load(file.name);
+
+  RegistryPtr reg = ctx.registry();
+  RegistryPtr reg2 = loaded.registry();
+  BOOST_REQUIRE_EQUAL(reg2->ogatoms.getSize(), reg->ogatoms.getSize());
+  BOOST_REQUIRE_EQUAL(reg2->terms.getSize(), reg->terms.getSize());
+  for(IDAddress adr = 0; adr < reg->ogatoms.getSize(); ++adr)
+  {
+    BOOST_CHECK_EQUAL(printToString<RawPrinter>(reg2->ogatoms.getIDByAddress(adr), reg2),
+        printToString<RawPrinter>(reg->ogatoms.getIDByAddress(adr), reg));
+    BOOST_CHECK(reg2->ogatoms.getByAddress(adr).tuple == reg->ogatoms.getByAddress(adr).tuple);
+  }
+  BOOST_REQUIRE(!!loaded.edb);
+  BOOST_CHECK(loaded.edb->getStorage() == ctx.edb->getStorage());
+  checkNestedTerm(reg2);
+}
+
+BOOST_AUTO_TEST_CASE(testRemappedMapping)
+{
+  TemporaryFile file;
+  ProgramCtx ctx;
+  setupCtx(ctx, facts);
+  RegistrySnapshot(ctx).save(file.name);
+
+  // symbols registered before (e.g. by plugins or other input) shift all addresses
+  ProgramCtx loaded;
+  setupCtx(loaded, "z(1). y(g(b)). p(b).");
+  std::set<std::string> expected = factStrings(loaded);
+  std::set<std::string> stored = factStrings(ctx);
+  expected.insert(stored.begin(), stored.end());
+
+  RegistrySnapshot(loaded).load(file.name);
+  BOOST_CHECK(factStrings(loaded) == expected);
+  checkNestedTerm(loaded.registry());
+
+  // loaded atoms are the registered ones, also if they existed before
+  RegistryPtr reg2 = loaded.registry();
+  BOOST_CHECK_EQUAL(reg2->ogatoms.getSize(), expected.size());
+  ID atom = reg2->ogatoms.getIDByString("s(h(f(a,g(b))),2)");
+  BOOST_REQUIRE(atom != ID_FAIL);
+  BOOST_CHECK(loaded.edb->getFact(atom.address));
+  BOOST_CHECK(reg2->ogatoms.getByID(atom).tuple[1] == reg2->terms.getIDByString("h(f(a,g(b)))"));
+}
+
+BOOST_AUTO_TEST_CASE(testTruncatedAndCorruptFiles)
+{
+  TemporaryFile file;
+  ProgramCtx ctx;
+  setupCtx(ctx, facts);
+  RegistrySnapshot(ctx).save(file.name);
+  std::string content = file.read();
+
+  // every truncated snapshot is rejected
+  for(std::size_t len = 0; len < content.size(); ++len)
+  {
+    file.write(content.substr(0, len));
+    ProgramCtx loaded;
+    loaded.setupRegistry(RegistryPtr(new Registry));
+    BOOST_CHECK_THROW(RegistrySnapshot(loaded).load(file.name), FatalError);
+  }
+
+  // other files and versions
+  ProgramCtx loaded;
+  loaded.setupRegistry(RegistryPtr(new Registry));
+  BOOST_CHECK_THROW(RegistrySnapshot(loaded).load("/nonexistent/snapshot"), FatalError);
+  std::string version(content);
+  version[12]++;
+  file.write(version);
+  BOOST_CHECK_THROW(RegistrySnapshot(loaded).load(file.name), FatalError);
+  file.write("p(a).\n");
+  BOOST_CHECK_THROW(RegistrySnapshot(loaded).load(file.name), FatalError);
+
+  // a nested term whose arguments refer to later terms
+  std::string forward;
+  appendString(forward, "DLVHEXSN");
+  appendUInt(forward, 1);
+  appendUInt(forward, 0);
+  appendUInt(forward, 3);
+  appendUInt(forward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED);
+  appendString(forward, "f(a)");
+  appendUInt(forward, 2);
+  appendUInt(forward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendUInt(forward, 1);
+  appendUInt(forward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendUInt(forward, 2);
+  appendUInt(forward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendString(forward, "f");
+  appendUInt(forward, 0);
+  appendUInt(forward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendString(forward, "a");
+  appendUInt(forward, 0);
+  appendUInt(forward, 0);
+  appendUInt(forward, 0);
+  file.write(forward);
+  BOOST_CHECK_THROW(RegistrySnapshot(loaded).load(file.name), FatalError);
+  BOOST_CHECK(loaded.registry()->terms.getIDByString("f(a)") == ID_FAIL);
+
+  // the same term after its arguments is accepted
+  std::string backward;
+  appendString(backward, "DLVHEXSN");
+  appendUInt(backward, 1);
+  appendUInt(backward, 0);
+  appendUInt(backward, 3);
+  appendUInt(backward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendString(backward, "f");
+  appendUInt(backward, 0);
+  appendUInt(backward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendString(backward, "a");
+  appendUInt(backward, 0);
+  appendUInt(backward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED);
+  appendString(backward, "f(a)");
+  appendUInt(backward, 2);
+  appendUInt(backward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendUInt(backward, 0);
+  appendUInt(backward, ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT);
+  appendUInt(backward, 1);
+  appendUInt(backward, 0);
+  appendUInt(backward, 0);
+  file.write(backward);
+  RegistrySnapshot(loaded).load(file.name);
+  RegistryPtr reg = loaded.registry();
+  ID f = reg->terms.getIDByString("f(a)");
+  BOOST_REQUIRE(f != ID_FAIL);
+  BOOST_REQUIRE_EQUAL(reg->terms.getByID(f).arguments.size(), 2);
+  BOOST_CHECK(reg->terms.getByID(f).arguments[0] == reg->terms.getIDByString("f"));
+  BOOST_CHECK(reg->terms.getByID(f).arguments[1] == reg->terms.getIDByString("a"));
+}
+
+BOOST_AUTO_TEST_CASE(testEdbOutOfRange)
+{
+  TemporaryFile file;
+
+  // facts must refer to ground atoms of the snapshot, also if addresses are not remapped
+  std::vector<unsigned> addresses;
+  file.write(edbOnlySnapshot(addresses));
+  ProgramCtx loaded;
+  loaded.setupRegistry(RegistryPtr(new Registry));
+  RegistrySnapshot(loaded).load(file.name);
+  BOOST_CHECK_EQUAL(loaded.edb->getStorage().count(), 0);
+
+  addresses.push_back(5);
+  addresses.push_back(100000);
+  file.write(edbOnlySnapshot(addresses));
+  ProgramCtx loaded2;
+  loaded2.setupRegistry(RegistryPtr(new Registry));
+  BOOST_CHECK_THROW(RegistrySnapshot(loaded2).load(file.name), FatalError);
+  BOOST_CHECK(!loaded2.edb || loaded2.edb->getStorage().count() == 0);
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -0,0 +1,251 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestSet.cpp
+ *
+ * @brief  Test Set against std::set, in particular around the inline capacity
+ *         (8 IDs or 16 ints) and the size up to which sets are searched linearly (16).
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/ID.h"
+#include "dlvhex2/Set.h"
+#include "dlvhex2/Logger.h"
+
+#define BOOST_TEST_MODULE "TestSet"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <vector>
+#include <cstdlib>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  // sets are tested with sizes 0 to maxSize, which crosses both thresholds and several reallocations
+  const int maxSize = 40;
+
+  // distinct elements for distinct k (also for k = -1 and k = maxSize + 1, which are never inserted)
+  ID element(ID*, int k)
+  {
+    ID atom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG, 10 + k);
+    return ID::literalFromAtom(atom, (k & 1) != 0);
+  }
+  int element(int*, int k)
+  {
+    return 10 + 3 * k;
+  }
+
+  template<typename T>
+  T element(int k)
+  {
+    return element(static_cast<T*>(0), k);
+  }
+
+  // compares content, iteration, search and counting with the reference set
+  template<typename T>
+  void checkEqual(const Set<T>& s, const std::set<T>& ref)
+  {
+    BOOST_REQUIRE_EQUAL(s.size(), (int)ref.size());
+    BOOST_REQUIRE_EQUAL(s.empty(), ref.empty());
+
+    typename std::set<T>::const_iterator rit = ref.begin();
+    for(int j = 0; j < s.size(); ++j, ++rit)
+      BOOST_REQUIRE(s[j] == *rit);
+    rit = ref.begin();
+    for(typename Set<T>::const_iterator it = s.begin(); it != s.end(); ++it, ++rit)
+      BOOST_REQUIRE(*it == *rit);
+    BOOST_REQUIRE(rit == ref.end());
+
+    // present and absent elements, also smaller and larger than all elements
+    for(int k = -1; k <= maxSize + 1; ++k)
+    {
+      T e = element<T>(k);
+      bool contained = ref.count(e) == 1;
+      BOOST_REQUIRE_EQUAL(s.contains(e), contained);
+      BOOST_REQUIRE_EQUAL(s.count(e), contained ? 1 : 0);
+      BOOST_REQUIRE_EQUAL(s.find(e) != s.end(), contained);
+      if( contained )
+        BOOST_REQUIRE(*s.find(e) == e);
+    }
+  }
+
+  // the k-th element of a pseudo random permutation of the first n elements
+  int permuted(int k, int n)
+  {
+    // 7 is coprime to all n not divisible by 7, the others use the identity
+    return n % 7 == 0 ? k : (7 * k + 3) % n;
+  }
+
+  template<typename T>
+  void testSizes()
+  {
+    for(int n = 0; n <= maxSize; ++n)
+    {
+      Set<T> s;
+      std::set<T> ref;
+      for(int k = 0; k < n; ++k)
+      {
+        T e = element<T>(permuted(k, n));
+        s.insert(e);
+        ref.insert(e);
+        checkEqual(s, ref);
+        // duplicates do not change the set
+        s.insert(e);
+        checkEqual(s, ref);
+      }
+
+      // copies of inline and heap-allocated sets
+      Set<T> copied(s);
+      checkEqual(copied, ref);
+      Set<T> assignedToEmpty;
+      assignedToEmpty = s;
+      checkEqual(assignedToEmpty, ref);
+      Set<T> assignedToLarge;
+      for(int k = 0; k < maxSize; ++k)
+        assignedToLarge.insert(element<T>(k));
+      assignedToLarge = s;
+      checkEqual(assignedToLarge, ref);
+      Set<T> assignedToSelf(s);
+      Set<T>& self = assignedToSelf;
+      assignedToSelf = self;
+      checkEqual(assignedToSelf, ref);
+
+      // the same set by range insertion
+      std::vector<T> elements(ref.rbegin(), ref.rend());
+      Set<T> ranged;
+      ranged.insert(elements.begin(), elements.end());
+      checkEqual(ranged, ref);
+
+      // erasing absent elements, then all elements in another order
+      s.erase(element<T>(-1));
+      s.erase(element<T>(maxSize + 1));
+      checkEqual(s, ref);
+      for(int k = 0; k < n; ++k)
+      {
+        T e = element<T>(permuted(n - 1 - k, n));
+        s.erase(e);
+        ref.erase(e);
+        checkEqual(s, ref);
+      }
+
+      // the copies are independent of the erased original
+      BOOST_REQUIRE_EQUAL(copied.size(), n);
+      BOOST_REQUIRE_EQUAL(assignedToLarge.size(), n);
+    }
+  }
+
+  template<typename T>
+  void testCopies()
+  {
+    for(int n = 0; n <= maxSize; ++n)
+    {
+      Set<T> s;
+      std::set<T> ref;
+      for(int k = 0; k < n; ++k)
+      {
+        s.insert(element<T>(2 * k));
+        ref.insert(element<T>(2 * k));
+      }
+
+      // modifying a copy does not modify the original and vice versa
+      Set<T> copied(s);
+      Set<T> assigned;
+      assigned = s;
+      std::set<T> modified(ref);
+      for(int k = 0; k < maxSize / 2; ++k)
+      {
+        copied.insert(element<T>(2 * k + 1));
+        assigned.insert(element<T>(2 * k + 1));
+        modified.insert(element<T>(2 * k + 1));
+      }
+      checkEqual(s, ref);
+      checkEqual(copied, modified);
+      checkEqual(assigned, modified);
+      s.clear();
+      checkEqual(copied, modified);
+      checkEqual(s, std::set<T>());
+
+      // sets in containers are copied when the container grows
+      std::vector<Set<T> > sets;
+      for(int i = 0; i < 20; ++i)
+        sets.push_back(copied);
+      for(int i = 0; i < 20; ++i)
+        checkEqual(sets[i], modified);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSizesAroundThresholds)
+{
+  testSizes<ID>();
+  testSizes<int>();
+}
+
+BOOST_AUTO_TEST_CASE(testCopyAndAssign)
+{
+  testCopies<ID>();
+  testCopies<int>();
+}
+
+BOOST_AUTO_TEST_CASE(testRandomOperations)
+{
+  Set<ID> s;
+  std::set<ID> ref;
+  srand(1);
+  for(unsigned i = 0; i < 2000; ++i)
+  {
+    ID e = element<ID>(rand() % 100);
+    if( rand() % 4 == 0 )
+    {
+      s.erase(e);
+      ref.erase(e);
+    }
+    else
+    {
+      s.insert(e);
+      ref.insert(e);
+    }
+    BOOST_REQUIRE_EQUAL(s.size(), (int)ref.size());
+    if( i % 20 == 0 )
+    {
+      checkEqual(s, ref);
+      Set<ID> copied(s);
+      checkEqual(copied, ref);
+      Set<ID> assigned;
+      assigned = s;
+      checkEqual(assigned, ref);
+    }
+  }
+}
+
+// Local Variables:
+// mode: C++
+// End:
@@ -0,0 +1,150 @@
+/* dlvhex -- Answer-Set Programming with external interfaces.
+ * Copyright (C) 2005, 2006, 2007 Roman Schindlauer
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010 Thomas Krennwallner
+ * Copyright (C) 2009, 2010 Peter Schüller
+ *
+ * This file is part of dlvhex.
+ *
+ * dlvhex is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as
+ * published by the Free Software Foundation; either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * dlvhex is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with dlvhex; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+ * 02110-1301 USA.
+ */
+
+/**
+ * @file   TestSetBenchmark.cpp
+ *
+ * @brief  Microbenchmarks for Set with a workload similar to nogood learning.
+ *
+ * Builds, copies and searches many small sets of literals (like nogoods)
+ * and a few large ones (like sets of atoms in the internal solver),
+ * and compares Set<ID> with std::set<ID>.
+ * Results are logged as warnings; the checks only verify that both containers agree
+ * (correctness of Set is tested in TestSet).
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif // HAVE_CONFIG_H
+
+#include "dlvhex2/ID.h"
+#include "dlvhex2/Set.h"
+#include "dlvhex2/Logger.h"
+
+#define BOOST_TEST_MODULE "TestSetBenchmark"
+#include <boost/test/unit_test.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <set>
+#include <vector>
+#include <cstdlib>
+
+LOG_INIT(Logger::ERROR | Logger::WARNING)
+
+DLVHEX_NAMESPACE_USE
+
+namespace
+{
+  const unsigned atoms = 100000;
+  const unsigned nogoods = 200000;
+  const unsigned lookups = 4000000;
+
+  class Timer
+  {
+  public:
+    Timer(const std::string& what): what(what), start(boost::posix_time::microsec_clock::universal_time()) {}
+    ~Timer()
+    {
+      boost::posix_time::time_duration d = boost::posix_time::microsec_clock::universal_time() - start;
+      LOG(WARNING, what << ": " << d.total_microseconds() / 1000.0 << "ms");
+    }
+  private:
+    std::string what;
+    boost::posix_time::ptime start;
+  };
+
+  ID randomLiteral()
+  {
+    ID atom(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG, rand() % atoms);
+    return ID::literalFromAtom(atom, rand() % 2 == 0);
+  }
+
+  // most learned nogoods have few literals, some have many
+  std::vector<std::vector<ID> > randomNogoods()
+  {
+    std::vector<std::vector<ID> > ret(nogoods);
+    srand(42);
+    for(unsigned n = 0; n < nogoods; ++n)
+    {
+      unsigned size = (n % 10 == 0) ? 20 + rand() % 40 : 2 + rand() % 10;
+      for(unsigned l = 0; l < size; ++l)
+        ret[n].push_back(randomLiteral());
+    }
+    return ret;
+  }
+
+  // builds, copies and searches the nogoods and returns a checksum
+  template<typename SetT>
+  unsigned long benchmark(const std::string& name, const std::vector<std::vector<ID> >& literals)
+  {
+    unsigned long checksum = 0;
+
+    std::vector<SetT> sets(literals.size());
+    {
+      Timer t(name + " insert");
+      for(unsigned n = 0; n < literals.size(); ++n)
+        for(std::vector<ID>::const_iterator it = literals[n].begin(); it != literals[n].end(); ++it)
+          sets[n].insert(*it);
+    }
+
+    {
+      Timer t(name + " copy");
+      std::vector<SetT> copies(sets);
+      for(unsigned n = 0; n < copies.size(); ++n)
+        checksum += copies[n].size();
+    }
+
+    {
+      Timer t(name + " contains");
+      srand(4711);
+      for(unsigned i = 0; i < lookups; ++i)
+        checksum += sets[i % sets.size()].count(randomLiteral());
+    }
+
+    {
+      Timer t(name + " large set");
+      SetT large;
+      for(unsigned n = 0; n < literals.size(); n += 50)
+        large.insert(literals[n].begin(), literals[n].end());
+      srand(4711);
+      for(unsigned i = 0; i < lookups; ++i)
+        checksum += large.count(randomLiteral());
+      checksum += large.size();
+    }
+
+    return checksum;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testNogoodSets)
+{
+  std::vector<std::vector<ID> > literals = randomNogoods();
+
+  unsigned long set = benchmark<Set<ID> >("Set<ID>", literals);
+  unsigned long stdset = benchmark<std::set<ID> >("std::set<ID>", literals);
+  BOOST_CHECK_EQUAL(set, stdset);
+}
+
+// Local Variables:
+// mode: C++
+// End:
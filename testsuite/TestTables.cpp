@@ -120,6 +120,13 @@ BOOST_AUTO_TEST_CASE(testTermTable)
 		BOOST_CHECK_EQUAL(idhello.kind, term_hello.kind);
 		BOOST_CHECK_EQUAL(idhello.address, 4);
 
+		// lookup by symbol without constructing a std::string
+		const char* hello = "\"Hello World\" (unused suffix)";
+		boost::string_ref hellosymbol(hello, strhello.size());
+		BOOST_CHECK_EQUAL(idhello, stab.getIDBySymbol(hellosymbol, TermTable::hashSymbol(hellosymbol)));
+		BOOST_CHECK_EQUAL(TermTable::hashSymbol(hellosymbol), TermTable::hashSymbol(strhello));
+		BOOST_CHECK_EQUAL(ID_FAIL, stab.getIDBySymbol(boost::string_ref(hello, 3), TermTable::hashSymbol(boost::string_ref(hello, 3))));
+
 		ID getidZ = stab.getIDByString(strZ);
 		BOOST_CHECK_EQUAL(idZ.kind, term_Z.kind);
 		BOOST_CHECK_EQUAL(idZ.address, 5);
@@ -132,6 +139,62 @@ BOOST_AUTO_TEST_CASE(testTermTable)
 
     LOG(INFO,"TermTable" << stab);
 	}
+
+	{
+		// enough terms to fill several segments of the lock-free address directory
+		TermTable stab;
+		std::vector<ID> ids;
+		for(unsigned i = 0; i < 5000; ++i)
+		{
+			std::stringstream ss;
+			ss << "c" << i;
+			ids.push_back(stab.storeAndGetID(Term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, ss.str())));
+		}
+
+		// the copy must not refer to the storage of the original table
+		TermTable copy(stab);
+		for(unsigned i = 0; i < ids.size(); ++i)
+		{
+			std::stringstream ss;
+			ss << "c" << i;
+			BOOST_CHECK_EQUAL(ids[i].address, i);
+			BOOST_CHECK_EQUAL(stab.getByID(ids[i]).symbol, ss.str());
+			BOOST_CHECK_EQUAL(copy.getByID(ids[i]).symbol, ss.str());
+			BOOST_CHECK(&stab.getByID(ids[i]) != &copy.getByID(ids[i]));
+		}
+	}
+
+	{
+		// nested terms can be looked up by function symbol and arguments
+		TermTable stab;
+		ID idf = stab.storeAndGetID(Term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, "f"));
+		ID ida = stab.storeAndGetID(Term(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, "a"));
+
+		std::vector<ID> args;
+		args.push_back(idf);
+		args.push_back(ida);
+		args.push_back(ID::termFromInteger(3));
+		BOOST_CHECK_EQUAL(ID_FAIL, stab.getIDByArguments(args));
+
+		Term term_fa3(ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED, "f(a,3)");
+		term_fa3.arguments = args;
+		ID idfa3 = stab.storeAndGetID(term_fa3);
+		BOOST_CHECK_EQUAL(idfa3, stab.getIDByArguments(args));
+		BOOST_CHECK_EQUAL(idfa3, stab.getIDByString("f(a,3)"));
+
+		// range terms have the same arguments as the function term
+		Term term_range(ID::MAINKIND_TERM | ID::SUBKIND_TERM_NESTED | ID::PROPERTY_TERM_RANGE, "a..3");
+		term_range.arguments = args;
+		BOOST_CHECK_EQUAL(ID_FAIL, stab.getIDByArguments(args, term_range.kind));
+		ID idrange = stab.storeAndGetID(term_range);
+		BOOST_CHECK_EQUAL(idrange, stab.getIDByArguments(args, term_range.kind));
+		BOOST_CHECK_EQUAL(idfa3, stab.getIDByArguments(args));
+
+		args[2] = ID::termFromInteger(4);
+		BOOST_CHECK_EQUAL(ID_FAIL, stab.getIDByArguments(args));
+		args.resize(1);
+		BOOST_CHECK_EQUAL(ID_FAIL, stab.getIDByArguments(args));
+	}
 }
 
 BOOST_AUTO_TEST_CASE(testOrdinaryAtomTable) 
@@ -180,9 +243,50 @@ BOOST_AUTO_TEST_CASE(testOrdinaryAtomTable)
     ID idatYhello = oatab.storeAndGetID(atYhello);
 
     LOG(INFO,"OrdinaryAtomTable" << oatab);
+
+    // the text index of a copy refers to the atoms of the copy
+    OrdinaryAtomTable* original = new OrdinaryAtomTable(oatab);
+    OrdinaryAtomTable copied(*original);
+    OrdinaryAtomTable assigned;
+    assigned = *original;
+    delete original;
+    BOOST_CHECK_EQUAL(idatab, copied.getIDByString("a(b)"));
+    BOOST_CHECK_EQUAL(idatYhello, copied.getIDByString("Y(\"Hello World\")"));
+    BOOST_CHECK_EQUAL(idatab, assigned.getIDByString("a(b)"));
+    BOOST_CHECK_EQUAL(ID_FAIL, assigned.getIDByString("a(c)"));
 	}
 }
 
+BOOST_AUTO_TEST_CASE(testOrdinaryAtomTableWithoutText) 
+{
+	Term term_a(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, "a");
+	Term term_b(ID::MAINKIND_TERM | ID::SUBKIND_TERM_CONSTANT, "b");
+
+  TermTable stab;
+  ID ida = stab.storeAndGetID(term_a);
+  ID idb = stab.storeAndGetID(term_b);
+
+  Tuple tupab; tupab.push_back(ida); tupab.push_back(idb);
+  OrdinaryAtom atab(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG, "a(b)", tupab);
+  Tuple tupb; tupb.push_back(idb);
+  OrdinaryAtom atb(ID::MAINKIND_ATOM | ID::SUBKIND_ATOM_ORDINARYG);
+  atb.tuple = tupb;
+
+	OrdinaryAtomTable oatab;
+	oatab.setStoreText(false);
+	BOOST_CHECK(!oatab.storesText());
+
+	ID idatab = oatab.storeAndGetID(atab);
+	ID idatb = oatab.storeAndGetID(atb);
+
+	// atoms are found by tuple only and do not keep their text
+	BOOST_CHECK_EQUAL(idatab, oatab.getIDByTuple(tupab));
+	BOOST_CHECK_EQUAL(idatb, oatab.getIDByTuple(tupb));
+	BOOST_CHECK_EQUAL(ID_FAIL, oatab.getIDByString("a(b)"));
+	BOOST_CHECK(oatab.getByID(idatab).text.empty());
+	BOOST_CHECK(oatab.getByID(idatab).tuple == tupab);
+}
+
 BOOST_AUTO_TEST_CASE(testBuiltinAtomTable) 
 {
   ID idint(ID::MAINKIND_TERM | ID::SUBKIND_TERM_BUILTIN, ID::TERM_BUILTIN_INT);
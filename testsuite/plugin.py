@@ -1063,6 +1063,12 @@ def main():
 	for x in ans:
 		print("Answer set:", dlvhex.getValue(x))
 
+	# the same rules under different facts (the second call is answered from the memo)
+	prepared = dlvhex.prepareSubprogram(prog[1])
+	for facts in (prog[0], prog[0], ()):
+		for x in prepared.evaluate(facts):
+			print("Answer set of prepared subprogram:", dlvhex.getValue(x))
+
 def register():
 	dlvhex.addAtom("multiply", (dlvhex.CONSTANT, dlvhex.CONSTANT), 1)
 